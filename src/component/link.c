@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "utils/symbol_table.h"
 #include "validation.h"
 #include "zone.h"
 
@@ -12,9 +13,11 @@
 
 void link_initialize(struct Link* link,
                      const char* id,
-                     const struct Zone* source,
-                     const struct Zone* target) {
+                     unsigned int source,
+                     unsigned int target) {
   strncpy(link->id, id, ID_MAX_LENGTH);
+  link->id[ID_MAX_LENGTH] = '\0';
+  link->symbol = symbol_table_intern(symbol_table_shared(), id);
   link->source = source;
   link->target = target;
 }
@@ -24,9 +27,19 @@ void link_copy(struct Link* dest, const struct Link* src) {
 }
 
 void link_from_json(struct Link* link,
-                     const struct Zone* source,
-                     const struct Zone* target,
+                    const struct Zone* zones,
+                    unsigned int source,
+                    unsigned int target,
                     json_t* j) {
+  link_validate_json(zones, source, target, j);
+  const char* id = json_string_value(json_object_get(j, JSON_LINK_ID));
+  link_initialize(link, id, source, target);
+}
+
+void link_validate_json(const struct Zone* zones,
+                        unsigned int source,
+                        unsigned int target,
+                        const json_t* j) {
   ensure_json_is_object(j);
   ensure_json_object_has_size(j, 3);
   ensure_json_object_contains_key(j, JSON_LINK_ID);
@@ -39,12 +52,9 @@ void link_from_json(struct Link* link,
   const json_t* j_target = json_object_get(j, JSON_LINK_TARGET);
   ensure_json_is_string(j_target);
   const char* source_id = json_string_value(j_source);
-  ensure_zone_identifiers_are_the_same(source_id, source->id);
+  ensure_zone_identifiers_are_the_same(source_id, zones[source].id);
   const char* target_id = json_string_value(j_target);
-  ensure_zone_identifiers_are_the_same(target_id, target->id);
-
-  const char* id = json_string_value(j_id);
-  link_initialize(link, id, source, target);
+  ensure_zone_identifiers_are_the_same(target_id, zones[target].id);
 }
 
 // Destruction
@@ -57,27 +67,27 @@ void link_free(struct Link* link) {
 // ---------
 
 bool link_are_equal(const struct Link* link1, const struct Link* link2) {
-  if (strcmp(link1->id, link2->id) != 0)
+  if (link1->symbol != link2->symbol)
     return false;
-  if (!zone_are_equal(link1->source, link2->source))
+  if (link1->source != link2->source)
     return false;
-  if (!zone_are_equal(link1->target, link2->target))
+  if (link1->target != link2->target)
     return false;
   return true;
 }
 
-void link_print(const struct Link* link) {
+void link_print(const struct Link* link, const struct Zone* zones) {
   printf("A link with identifier \"%s\"\n", link->id);
-  printf("  Source zone: %s\n", link->source->id);
-  printf("  Target zone: %s\n", link->target->id);
+  printf("  Source zone: %s\n", zones[link->source].id);
+  printf("  Target zone: %s\n", zones[link->target].id);
 }
 
 // JSON serialization
 // ------------------
 
-json_t* link_to_json(const struct Link* link) {
+json_t* link_to_json(const struct Link* link, const struct Zone* zones) {
   return json_pack("{s:s,s:s,s:s}",
                    "id", link->id,
-                   "source", link->source->id,
-                   "target", link->target->id);
+                   "source", zones[link->source].id,
+                   "target", zones[link->target].id);
 }
@@ -7,6 +7,7 @@
 
 #include "constants.h"
 #include "unit.h"
+#include "zone.h"
 
 // JSON keys
 // ---------
@@ -21,10 +22,12 @@
 struct Link {
   // The identifier of the link
   char id[ID_MAX_LENGTH + 1];
-  // The source zone of the link
-  const struct Zone* source;
-  // The target zone of the link
-  const struct Zone* target;
+  // The symbol of the identifier in the shared symbol table
+  unsigned int symbol;
+  // The index of the source zone of the link
+  unsigned int source;
+  // The index of the target zone of the link
+  unsigned int target;
 };
 
 // Initialization
@@ -33,15 +36,18 @@ struct Link {
 /**
  * Initializes a link
  *
+ * The zones are given by their index in the zone table of the scenario
+ * containing the link.
+ *
  * @param link    The link to initialize
  * @param id      The identifier of the link
- * @param source  The source zone of the link
- * @param target  The source zone of the link
+ * @param source  The index of the source zone of the link
+ * @param target  The index of the target zone of the link
  */
 void link_initialize(struct Link* link,
                      const char* id,
-                     const struct Zone* source,
-                     const struct Zone* target);
+                     unsigned int source,
+                     unsigned int target);
 
 /**
  * Initializes a link from another one
@@ -55,15 +61,32 @@ void link_copy(struct Link* dest, const struct Link* src);
  * Initializes a link from a JSON value
  *
  * @param link    The link to initialize
- * @param source  The source zone of the link
- * @param target  The source zone of the link
+ * @param zones   The zone table in which the zones are located
+ * @param source  The index of the source zone of the link
+ * @param target  The index of the target zone of the link
  * @param j       The JSON value
  */
 void link_from_json(struct Link* link,
-                    const struct Zone* source,
-                    const struct Zone* target,
+                    const struct Zone* zones,
+                    unsigned int source,
+                    unsigned int target,
                     json_t* j);
 
+/**
+ * Ensures that a JSON value describes a valid link
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param zones   The zone table in which the zones are located
+ * @param source  The index of the source zone of the link
+ * @param target  The index of the target zone of the link
+ * @param j       The JSON value
+ */
+void link_validate_json(const struct Zone* zones,
+                        unsigned int source,
+                        unsigned int target,
+                        const json_t* j);
+
 // Destruction
 // -----------
 
@@ -88,9 +111,10 @@ bool link_are_equal(const struct Link* link1, const struct Link* link2);
 /**
  * Prints a link to stdout
  *
- * @param link  The link to print
+ * @param link   The link to print
+ * @param zones  The zone table in which the zones of the link are located
  */
-void link_print(const struct Link* link);
+void link_print(const struct Link* link, const struct Zone* zones);
 
 // JSON serialization
 // ------------------
@@ -98,9 +122,10 @@ void link_print(const struct Link* link);
 /**
  * Converts a link to a JSON value
  *
- * @param link  The link to convert
- * @return      The JSON value
+ * @param link   The link to convert
+ * @param zones  The zone table in which the zones of the link are located
+ * @return       The JSON value
  */
-json_t* link_to_json(const struct Link* link);
+json_t* link_to_json(const struct Link* link, const struct Zone* zones);
 
 #endif
@@ -3,41 +3,75 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "series.h"
+#include "utils/symbol_table.h"
 #include "validation.h"
 
+// Help functions
+// --------------
+
+/**
+ * Initializes a plant with uninitialized series
+ *
+ * @param plant     The plant to initialize
+ * @param id        The identifier of the plant
+ * @param timeline  The reference timeline of the plant
+ * @param zone      The index of the zone in which the plant is located
+ */
+void plant_allocate(struct Plant* plant,
+                    const char* id,
+                    const struct Timeline* timeline,
+                    unsigned int zone) {
+  strncpy(plant->id, id, ID_MAX_LENGTH);
+  plant->id[ID_MAX_LENGTH] = '\0';
+  plant->symbol = symbol_table_intern(symbol_table_shared(), id);
+  plant->timeline = timeline_retain(timeline);
+  plant->zone = zone;
+  plant->min_powers =
+    malloc(timeline->num_future_timesteps * sizeof(stored_mw));
+  plant->max_powers =
+    malloc(timeline->num_future_timesteps * sizeof(stored_mw));
+}
+
 // Initialization
 // --------------
 
 void plant_initialize(struct Plant* plant,
                       const char* id,
                       const struct Timeline* timeline,
-                      const struct Zone* zone,
+                      unsigned int zone,
                       const mw* min_powers,
                       const mw* max_powers) {
-  strncpy(plant->id, id, ID_MAX_LENGTH);
-  plant->timeline = timeline;
-  plant->zone = zone;
-  plant->min_powers = malloc(timeline->num_future_timesteps * sizeof(mw));
-  plant->max_powers = malloc(timeline->num_future_timesteps * sizeof(mw));
-  memcpy(plant->min_powers, min_powers,
-         timeline->num_future_timesteps * sizeof(mw));
-  memcpy(plant->max_powers, max_powers,
-         timeline->num_future_timesteps * sizeof(mw));
+  plant_allocate(plant, id, timeline, zone);
+  for (int t = 0; t < timeline->num_future_timesteps; ++t) {
+    plant->min_powers[t] = mw_store(min_powers[t]);
+    plant->max_powers[t] = mw_store(max_powers[t]);
+  }
 }
 
 void plant_copy(struct Plant* dest, const struct Plant* src) {
-  plant_initialize(dest,
-                   src->id,
-                   src->timeline,
-                   src->zone,
-                   src->min_powers,
-                   src->max_powers);
+  plant_allocate(dest, src->id, src->timeline, src->zone);
+  memcpy(dest->min_powers, src->min_powers,
+         src->timeline->num_future_timesteps * sizeof(stored_mw));
+  memcpy(dest->max_powers, src->max_powers,
+         src->timeline->num_future_timesteps * sizeof(stored_mw));
 }
 
 void plant_from_json(struct Plant* plant,
                      const struct Timeline* timeline,
-                     const struct Zone* zone,
+                     const struct Zone* zones,
+                     unsigned int zone,
                      json_t* j) {
+  plant_validate_json(timeline, zones, zone, j);
+  const char* id = json_string_value(json_object_get(j, JSON_PLANT_ID));
+  plant_allocate(plant, id, timeline, zone);
+  plant_series_from_json(plant, j);
+}
+
+void plant_validate_json(const struct Timeline* timeline,
+                         const struct Zone* zones,
+                         unsigned int zone,
+                         const json_t* j) {
   ensure_json_is_object(j);
   ensure_json_object_has_size(j, 4);
   ensure_json_object_contains_key(j, JSON_PLANT_ID);
@@ -49,24 +83,21 @@ void plant_from_json(struct Plant* plant,
   const json_t* j_zone = json_object_get(j, JSON_PLANT_ZONE);
   ensure_json_is_string(j_zone);
   const char* zone_id = json_string_value(j_zone);
-  ensure_zone_identifiers_are_the_same(zone_id, zone->id);
+  ensure_zone_identifiers_are_the_same(zone_id, zones[zone].id);
   const json_t* j_min_powers = json_object_get(j, JSON_PLANT_MIN_POWERS);
-  ensure_json_is_array(j_min_powers);
-  ensure_json_array_has_size(j_min_powers, timeline->num_future_timesteps);
-  ensure_json_is_array_of_numbers(j_min_powers);
+  series_validate_json(j_min_powers, timeline->num_future_timesteps);
   const json_t* j_max_powers = json_object_get(j, JSON_PLANT_MAX_POWERS);
-  ensure_json_is_array(j_max_powers);
-  ensure_json_array_has_size(j_max_powers, timeline->num_future_timesteps);
-  ensure_json_is_array_of_numbers(j_max_powers);
+  series_validate_json(j_max_powers, timeline->num_future_timesteps);
+}
 
-  const char* id = json_string_value(j_id);
-  mw min_powers[timeline->num_future_timesteps];
-  mw max_powers[timeline->num_future_timesteps];
-  for (int t = 0; t < timeline->num_future_timesteps; ++t) {
-    min_powers[t] = json_number_value(json_array_get(j_min_powers, t));
-    max_powers[t] = json_number_value(json_array_get(j_max_powers, t));
-  }
-  plant_initialize(plant, id, timeline, zone, min_powers, max_powers);
+void plant_series_from_json(struct Plant* plant, const json_t* j) {
+  unsigned int num_timesteps = plant->timeline->num_future_timesteps;
+  series_values_from_json(json_object_get(j, JSON_PLANT_MIN_POWERS),
+                          num_timesteps,
+                          plant->min_powers);
+  series_values_from_json(json_object_get(j, JSON_PLANT_MAX_POWERS),
+                          num_timesteps,
+                          plant->max_powers);
 }
 
 // Destruction
@@ -75,17 +106,18 @@ void plant_from_json(struct Plant* plant,
 void plant_free(struct Plant* plant) {
   free(plant->min_powers);
   free(plant->max_powers);
+  timeline_release(plant->timeline);
 }
 
 // Accessors
 // ---------
 
 bool plant_are_equal(const struct Plant* plant1, const struct Plant* plant2) {
-  if (strcmp(plant1->id, plant2->id) != 0)
+  if (plant1->symbol != plant2->symbol)
     return false;
   if (!timeline_are_equal(plant1->timeline, plant2->timeline))
     return false;
-  if (!zone_are_equal(plant1->zone, plant2->zone))
+  if (plant1->zone != plant2->zone)
     return false;
   for (int t = 0; t < plant1->timeline->num_future_timesteps; ++t) {
     if (plant1->min_powers[t] != plant2->min_powers[t])
@@ -96,19 +128,19 @@ bool plant_are_equal(const struct Plant* plant1, const struct Plant* plant2) {
   return true;
 }
 
-void plant_print(const struct Plant* plant) {
+void plant_print(const struct Plant* plant, const struct Zone* zones) {
   printf("A plant with identifier \"%s\"\n", plant->id);
-  printf("  Zone: %s\n", plant->zone->id);
+  printf("  Zone: %s\n", zones[plant->zone].id);
   printf("  Minimum powers: ");
   for (int t = 0; t < plant->timeline->num_future_timesteps; ++t) {
     if (t > 0) printf(", ");
-    printf("%f", plant->min_powers[t]);
+    printf("%f", mw_load(plant->min_powers[t]));
   }
   printf("\n");
   printf("  Maximum powers: ");
   for (int t = 0; t < plant->timeline->num_future_timesteps; ++t) {
     if (t > 0) printf(", ");
-    printf("%f", plant->max_powers[t]);
+    printf("%f", mw_load(plant->max_powers[t]));
   }
   printf("\n");
 }
@@ -116,16 +148,18 @@ void plant_print(const struct Plant* plant) {
 // JSON serialization
 // ------------------
 
-json_t* plant_to_json(const struct Plant* plant) {
+json_t* plant_to_json(const struct Plant* plant, const struct Zone* zones) {
   json_t* j_min_powers = json_array();
   json_t* j_max_powers = json_array();
   for (int t = 0; t < plant->timeline->num_future_timesteps; ++t) {
-    json_array_append_new(j_min_powers, json_real(plant->min_powers[t]));
-    json_array_append_new(j_max_powers, json_real(plant->max_powers[t]));
+    json_array_append_new(j_min_powers,
+                          json_real(mw_load(plant->min_powers[t])));
+    json_array_append_new(j_max_powers,
+                          json_real(mw_load(plant->max_powers[t])));
   }
   return json_pack("{s:s,s:o,s:o,s:s}",
                    "id", plant->id,
                    "max-powers", j_max_powers,
                    "min-powers", j_min_powers,
-                   "zone", plant->zone->id);
+                   "zone", zones[plant->zone].id);
 }
@@ -20,14 +20,16 @@
 struct Plant {
   // The identifier of the plant
   char id[ID_MAX_LENGTH + 1];
+  // The symbol of the identifier in the shared symbol table
+  unsigned int symbol;
   // The reference timeline
   const struct Timeline* timeline;
-  // The zone in which the plant is located
-  const struct Zone* zone;
+  // The index of the zone in which the plant is located
+  unsigned int zone;
   // The maximum powers that the plant can produce for each timestep
-  mw* max_powers;
+  stored_mw* max_powers;
   // The minimum powers that the plant can produce for each timestep
-  mw* min_powers;
+  stored_mw* min_powers;
 };
 
 // Initialization
@@ -36,17 +38,20 @@ struct Plant {
 /**
  * Initializes a plant
  *
+ * The zone is given by its index in the zone table of the scenario containing
+ * the plant.
+ *
  * @param plant       The plant to initialize
  * @param id          The identifier of the plant
  * @param timeline    The reference timeline of the plant
- * @param zone        The zone in which the plant is located
+ * @param zone        The index of the zone in which the plant is located
  * @param min_powers  The minimum powers that the plant can produce
  * @param max_powers  The maximum powers that the plant can produce
  */
 void plant_initialize(struct Plant* plant,
                       const char* id,
                       const struct Timeline* timeline,
-                      const struct Zone* zone,
+                      unsigned int zone,
                       const mw* min_powers,
                       const mw* max_powers);
 
@@ -63,14 +68,42 @@ void plant_copy(struct Plant* dest, const struct Plant* src);
  *
  * @param plant     The plant to initialize
  * @param timeline  The reference timeline of the plant
- * @param zone      The zone containing the plant
+ * @param zones     The zone table in which the zone of the plant is located
+ * @param zone      The index of the zone containing the plant
  * @param j         The JSON value
  */
 void plant_from_json(struct Plant* plant,
                      const struct Timeline* timeline,
-                     const struct Zone* zone,
+                     const struct Zone* zones,
+                     unsigned int zone,
                      json_t* j);
 
+/**
+ * Ensures that a JSON value describes a valid plant
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param timeline  The reference timeline of the plant
+ * @param zones     The zone table in which the zone is located
+ * @param zone      The index of the zone in which the plant is located
+ * @param j         The JSON value
+ */
+void plant_validate_json(const struct Timeline* timeline,
+                         const struct Zone* zones,
+                         unsigned int zone,
+                         const json_t* j);
+
+/**
+ * Reads the series of a plant from a JSON value
+ *
+ * The JSON value must have been validated with plant_validate_json, and the
+ * series of the plant must have room for a value per timestep.
+ *
+ * @param plant  The plant whose series are filled
+ * @param j      The JSON value
+ */
+void plant_series_from_json(struct Plant* plant, const json_t* j);
+
 // Destruction
 // -----------
 
@@ -96,8 +129,9 @@ bool plant_are_equal(const struct Plant* plant1, const struct Plant* plant2);
  * Prints a plant to stdout
  *
  * @param plant  The plant to print
+ * @param zones  The zone table in which the zone of the plant is located
  */
-void plant_print(const struct Plant* plant);
+void plant_print(const struct Plant* plant, const struct Zone* zones);
 
 // JSON serialization
 // ------------------
@@ -106,8 +140,9 @@ void plant_print(const struct Plant* plant);
  * Converts a plant to a JSON value
  *
  * @param plant  The plant to convert
+ * @param zones  The zone table in which the zone of the plant is located
  * @return       The JSON value
  */
-json_t* plant_to_json(const struct Plant* plant);
+json_t* plant_to_json(const struct Plant* plant, const struct Zone* zones);
 
 #endif
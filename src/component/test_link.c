@@ -14,28 +14,16 @@ void test_link_initialize(void) {
   diag("Testing link_initialize");
 
   // Setup
-  int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
-  mw expected_demands[] = {5.0, 10.0, 8.0};
-  struct Zone zone1, zone2;
-  zone_initialize(&zone1, "Z1", &timeline, expected_demands);
-  zone_initialize(&zone2, "Z2", &timeline, expected_demands);
   struct Link link;
-  link_initialize(&link, "Z1->Z2", &zone1, &zone2);
+  link_initialize(&link, "Z1->Z2", 0, 1);
 
   // Checks
   is(link.id, "Z1->Z2", "zone identifier is \"Z1->Z2\"");
-  ok(zone_are_equal(link.source, &zone1),
-     "source zone of link is equal to zone Z1");
-  ok(zone_are_equal(link.target, &zone2),
-     "target zone of link is equal to zone Z2");
+  cmp_ok(link.source, "==", 0, "source zone of link is zone Z1");
+  cmp_ok(link.target, "==", 1, "target zone of link is zone Z2");
 
   // Teardown
   link_free(&link);
-  zone_free(&zone1);
-  zone_free(&zone2);
-  timeline_free(&timeline);
 }
 
 /**
@@ -45,19 +33,11 @@ void test_link_are_equal(void) {
   diag("Testing link_are_equal");
 
   // Setup
-  int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
-  mw expected_demands[] = {5.0, 10.0, 8.0};
-  struct Zone zone1, zone2, zone3;
-  zone_initialize(&zone1, "Z1", &timeline, expected_demands);
-  zone_initialize(&zone2, "Z2", &timeline, expected_demands);
-  zone_initialize(&zone3, "Z3", &timeline, expected_demands);
   struct Link link1, link2, link3, link4;
-  link_initialize(&link1, "L", &zone1, &zone2);
-  link_initialize(&link2, "L'", &zone1, &zone2);
-  link_initialize(&link3, "L", &zone1, &zone3);
-  link_initialize(&link4, "L", &zone3, &zone1);
+  link_initialize(&link1, "L", 0, 1);
+  link_initialize(&link2, "L'", 0, 1);
+  link_initialize(&link3, "L", 0, 2);
+  link_initialize(&link4, "L", 2, 0);
 
   // Test cases
   struct test_case {
@@ -83,12 +63,8 @@ void test_link_are_equal(void) {
            test_cases[tc].equal ? "equal" : "not equal");
 
   // Teardown
-  zone_free(&zone1);
-  zone_free(&zone2);
-  zone_free(&zone3);
   link_free(&link1);
   link_free(&link2);
-  timeline_free(&timeline);
 }
 
 /**
@@ -99,15 +75,14 @@ void test_link_to_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
-  struct Zone zone1, zone2;
-  zone_initialize(&zone1, "Z1", &timeline, expected_demands);
-  zone_initialize(&zone2, "Z2", &timeline, expected_demands);
+  struct Zone zones[2];
+  zone_initialize(zones, "Z1", timeline, expected_demands);
+  zone_initialize(zones + 1, "Z2", timeline, expected_demands);
   struct Link link;
-  link_initialize(&link, "Z1->Z2", &zone1, &zone2);
-  json_t* j = link_to_json(&link);
+  link_initialize(&link, "Z1->Z2", 0, 1);
+  json_t* j = link_to_json(&link, zones);
 
   // Checks
   ok(json_is_object(j), "json value is an object");
@@ -128,9 +103,9 @@ void test_link_to_json(void) {
   // Teardown
   json_decref(j);
   link_free(&link);
-  zone_free(&zone1);
-  zone_free(&zone2);
-  timeline_free(&timeline);
+  zone_free(zones);
+  zone_free(zones + 1);
+  timeline_release(timeline);
 }
 
 /**
@@ -141,16 +116,15 @@ void test_link_from_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
-  struct Zone zone1, zone2;
-  zone_initialize(&zone1, "Z1", &timeline, expected_demands);
-  zone_initialize(&zone2, "Z2", &timeline, expected_demands);
+  struct Zone zones[2];
+  zone_initialize(zones, "Z1", timeline, expected_demands);
+  zone_initialize(zones + 1, "Z2", timeline, expected_demands);
   struct Link link, json_link;
-  link_initialize(&link, "Z1->Z2", &zone1, &zone2);
-  json_t* j = link_to_json(&link);
-  link_from_json(&json_link, &zone1, &zone2, j);
+  link_initialize(&link, "Z1->Z2", 0, 1);
+  json_t* j = link_to_json(&link, zones);
+  link_from_json(&json_link, zones, 0, 1, j);
 
   // Checks
   ok(link_are_equal(&link, &json_link),
@@ -160,9 +134,9 @@ void test_link_from_json(void) {
   json_decref(j);
   link_free(&link);
   link_free(&json_link);
-  zone_free(&zone1);
-  zone_free(&zone2);
-  timeline_free(&timeline);
+  zone_free(zones);
+  zone_free(zones + 1);
+  timeline_release(timeline);
 }
 
 int main(void) {
@@ -15,33 +15,27 @@ void test_plant_initialize(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
-  mw expected_demands[] = {5.0, 10.0, 8.0};
-  struct Zone zone;
-  zone_initialize(&zone, "Z", &timeline, expected_demands);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw min_powers[] = {2.0, 3.0, 4.0};
   mw max_powers[] = {7.0, 8.0, 9.0};
   struct Plant plant;
-  plant_initialize(&plant, "P", &timeline, &zone, min_powers, max_powers);
+  plant_initialize(&plant, "P", timeline, 0, min_powers, max_powers);
 
   // Checks
   is(plant.id, "P", "plant identifier is \"P\"");
-  ok(timeline_are_equal(plant.timeline, &timeline),
+  ok(timeline_are_equal(plant.timeline, timeline),
      "plant timeline is equal to provided timeline");
-  ok(zone_are_equal(plant.zone, &zone),
-     "plant zone is equal to provided zone");
+  cmp_ok(plant.zone, "==", 0, "plant zone index is equal to provided index");
   for (int t = 0; t <= 2; ++t) {
-    cmp_ok(plant.min_powers[t], "==", min_powers[t],
+    cmp_ok(mw_load(plant.min_powers[t]), "==", min_powers[t],
            "minimum power at index %d of plant is equal to provided power", t);
-    cmp_ok(plant.max_powers[t], "==", max_powers[t],
+    cmp_ok(mw_load(plant.max_powers[t]), "==", max_powers[t],
            "maximum power at index %d of plant is equal to provided power", t);
   }
 
   // Teardown
   plant_free(&plant);
-  zone_free(&zone);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -52,25 +46,20 @@ void test_plant_are_equal(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline1, timeline2;
-  timeline_initialize(&timeline1, 3, durations);
-  timeline_initialize(&timeline2, 2, durations);
-  mw expected_demands[] = {1.0, 2.0, 3.0};
+  const struct Timeline* timeline1 = timeline_create(3, durations);
+  const struct Timeline* timeline2 = timeline_create(2, durations);
   mw min_powers1[] = {4.0, 5.0, 6.0},
      min_powers2[] = {4.0, 5.0, 7.0},
      max_powers1[] = {7.0, 8.0, 9.0},
      max_powers2[] = {7.0, 9.0, 9.0};
-  struct Zone zone1, zone2;
-  zone_initialize(&zone1, "Z1", &timeline1, expected_demands);
-  zone_initialize(&zone2, "Z2", &timeline1, expected_demands);
   struct Plant plant1, plant2, plant3, plant4, plant5, plant6, plant7;
-  plant_initialize(&plant1, "P1", &timeline1, &zone1, min_powers1, max_powers1);
-  plant_initialize(&plant2, "P1", &timeline1, &zone1, min_powers1, max_powers1);
-  plant_initialize(&plant3, "P3", &timeline1, &zone1, min_powers1, max_powers1);
-  plant_initialize(&plant4, "P1", &timeline2, &zone1, min_powers1, max_powers1);
-  plant_initialize(&plant5, "P1", &timeline1, &zone2, min_powers1, max_powers1);
-  plant_initialize(&plant6, "P1", &timeline1, &zone1, min_powers2, max_powers1);
-  plant_initialize(&plant7, "P1", &timeline1, &zone1, min_powers1, max_powers2);
+  plant_initialize(&plant1, "P1", timeline1, 0, min_powers1, max_powers1);
+  plant_initialize(&plant2, "P1", timeline1, 0, min_powers1, max_powers1);
+  plant_initialize(&plant3, "P3", timeline1, 0, min_powers1, max_powers1);
+  plant_initialize(&plant4, "P1", timeline2, 0, min_powers1, max_powers1);
+  plant_initialize(&plant5, "P1", timeline1, 1, min_powers1, max_powers1);
+  plant_initialize(&plant6, "P1", timeline1, 0, min_powers2, max_powers1);
+  plant_initialize(&plant7, "P1", timeline1, 0, min_powers1, max_powers2);
 
   // Test cases
   struct test_case {
@@ -107,10 +96,8 @@ void test_plant_are_equal(void) {
   plant_free(&plant5);
   plant_free(&plant6);
   plant_free(&plant7);
-  zone_free(&zone1);
-  zone_free(&zone2);
-  timeline_free(&timeline1);
-  timeline_free(&timeline2);
+  timeline_release(timeline1);
+  timeline_release(timeline2);
 }
 
 /**
@@ -121,15 +108,11 @@ void test_plant_copy(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
-  mw expected_demands[] = {5.0, 10.0, 8.0};
-  struct Zone zone;
-  zone_initialize(&zone, "Z", &timeline, expected_demands);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw min_powers[] = {2.0, 3.0, 4.0};
   mw max_powers[] = {7.0, 8.0, 9.0};
   struct Plant plant1, plant2;
-  plant_initialize(&plant1, "P", &timeline, &zone, min_powers, max_powers);
+  plant_initialize(&plant1, "P", timeline, 0, min_powers, max_powers);
   plant_copy(&plant2, &plant1);
 
   // Checks
@@ -137,10 +120,9 @@ void test_plant_copy(void) {
      "copied plant is equal to original plant");
 
   // Teardown
-  zone_free(&zone);
   plant_free(&plant1);
   plant_free(&plant2);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -151,18 +133,17 @@ void test_plant_to_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
   struct Zone zone;
-  zone_initialize(&zone, "Z", &timeline, expected_demands);
+  zone_initialize(&zone, "Z", timeline, expected_demands);
   mw min_powers[] = {2.0, 3.0, 4.0},
      max_powers[] = {7.0, 8.0, 9.0};
   struct Plant plant;
-  plant_initialize(&plant, "P", &timeline, &zone, min_powers, max_powers);
+  plant_initialize(&plant, "P", timeline, 0, min_powers, max_powers);
 
   // Checks
-  json_t* j = plant_to_json(&plant);
+  json_t* j = plant_to_json(&plant, &zone);
   ok(json_is_object(j), "json value is an object");
   cmp_ok(json_object_size(j), "==", 4, "json object has size 4");
   const json_t* j_id = json_object_get(j, "id");
@@ -198,7 +179,7 @@ void test_plant_to_json(void) {
   json_decref(j);
   plant_free(&plant);
   zone_free(&zone);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -209,17 +190,16 @@ void test_plant_from_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
   struct Zone zone;
-  zone_initialize(&zone, "Z", &timeline, expected_demands);
+  zone_initialize(&zone, "Z", timeline, expected_demands);
   mw min_powers[] = {2.0, 3.0, 4.0};
   mw max_powers[] = {7.0, 8.0, 9.0};
   struct Plant plant, json_plant;
-  plant_initialize(&plant, "P", &timeline, &zone, min_powers, max_powers);
-  json_t* j = plant_to_json(&plant);
-  plant_from_json(&json_plant, &timeline, &zone, j);
+  plant_initialize(&plant, "P", timeline, 0, min_powers, max_powers);
+  json_t* j = plant_to_json(&plant, &zone);
+  plant_from_json(&json_plant, timeline, &zone, 0, j);
 
   // Checks
   ok(plant_are_equal(&plant, &json_plant),
@@ -230,7 +210,43 @@ void test_plant_from_json(void) {
   plant_free(&plant);
   plant_free(&json_plant);
   zone_free(&zone);
-  timeline_free(&timeline);
+  timeline_release(timeline);
+}
+
+/**
+ * Tests the plant_from_json function with compact series
+ */
+void test_plant_from_compact_json(void) {
+  diag("Testing plant_from_json with compact series");
+
+  // Setup
+  int durations[] = {10, 30, 60, 20};
+  const struct Timeline* timeline = timeline_create(4, durations);
+  mw expected_demands[] = {5.0, 10.0, 8.0, 8.0};
+  struct Zone zone;
+  zone_initialize(&zone, "Z", timeline, expected_demands);
+  mw min_powers[] = {2.0, 2.0, 2.0, 2.0};
+  mw max_powers[] = {7.0, 7.0, 9.0, 9.0};
+  struct Plant plant, json_plant;
+  plant_initialize(&plant, "P", timeline, 0, min_powers, max_powers);
+  json_t* j = json_pack("{s:s,s:s,s:[{s:f,s:i}],s:[{s:f,s:i},{s:f,s:i}]}",
+                        "id", "P",
+                        "zone", "Z",
+                        "min-powers", "value", 2.0, "from", 0,
+                        "max-powers", "value", 7.0, "from", 0,
+                                      "value", 9.0, "from", 2);
+  plant_from_json(&json_plant, timeline, &zone, 0, j);
+
+  // Checks
+  ok(plant_are_equal(&plant, &json_plant),
+     "manually built plant and compact JSON plant are equal");
+
+  // Teardown
+  json_decref(j);
+  plant_free(&plant);
+  plant_free(&json_plant);
+  zone_free(&zone);
+  timeline_release(timeline);
 }
 
 int main(void) {
@@ -238,5 +254,6 @@ int main(void) {
   test_plant_are_equal();
   test_plant_to_json();
   test_plant_from_json();
+  test_plant_from_compact_json();
   done_testing();
 }
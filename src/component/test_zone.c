@@ -15,26 +15,25 @@ void test_zone_initialize(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
   struct Zone zone;
-  zone_initialize(&zone, "Z", &timeline, expected_demands);
+  zone_initialize(&zone, "Z", timeline, expected_demands);
 
   // Checks
   is(zone.id, "Z", "zone identifier is \"Z\"");
-  cmp_ok(zone.expected_demands[0], "==", expected_demands[0],
+  cmp_ok(mw_load(zone.expected_demands[0]), "==", expected_demands[0],
          "first expected demand of zone is equal to provided demand");
-  cmp_ok(zone.expected_demands[1], "==", expected_demands[1],
+  cmp_ok(mw_load(zone.expected_demands[1]), "==", expected_demands[1],
          "second expected demand of zone is equal to provided demand");
-  cmp_ok(zone.expected_demands[2], "==", expected_demands[2],
+  cmp_ok(mw_load(zone.expected_demands[2]), "==", expected_demands[2],
          "third expected demand of zone is equal to provided demand");
-  ok(timeline_are_equal(zone.timeline, &timeline),
+  ok(timeline_are_equal(zone.timeline, timeline),
      "zone timeline is equal to provided timeline");
 
   // Teardown
   zone_free(&zone);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -45,17 +44,16 @@ void test_zone_are_equal(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline1, timeline2;
-  timeline_initialize(&timeline1, 2, durations);
-  timeline_initialize(&timeline2, 3, durations);
+  const struct Timeline* timeline1 = timeline_create(2, durations);
+  const struct Timeline* timeline2 = timeline_create(3, durations);
   mw expected_demands1[] = {5.0, 10.0, 8.0},
      expected_demands2[] = {5.0, 6.0, 8.0};
   struct Zone zone1, zone2, zone3, zone4, zone5;
-  zone_initialize(&zone1, "Z", &timeline1, expected_demands1);
-  zone_initialize(&zone2, "Z", &timeline1, expected_demands1);
-  zone_initialize(&zone3, "Z'", &timeline1, expected_demands1);
-  zone_initialize(&zone4, "Z'", &timeline2, expected_demands1);
-  zone_initialize(&zone5, "Z'", &timeline1, expected_demands2);
+  zone_initialize(&zone1, "Z", timeline1, expected_demands1);
+  zone_initialize(&zone2, "Z", timeline1, expected_demands1);
+  zone_initialize(&zone3, "Z'", timeline1, expected_demands1);
+  zone_initialize(&zone4, "Z'", timeline2, expected_demands1);
+  zone_initialize(&zone5, "Z'", timeline1, expected_demands2);
 
   // Test cases
   struct test_case {
@@ -87,8 +85,8 @@ void test_zone_are_equal(void) {
   zone_free(&zone3);
   zone_free(&zone4);
   zone_free(&zone5);
-  timeline_free(&timeline1);
-  timeline_free(&timeline2);
+  timeline_release(timeline1);
+  timeline_release(timeline2);
 }
 
 /**
@@ -99,11 +97,10 @@ void test_zone_copy(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
   struct Zone zone1, zone2;
-  zone_initialize(&zone1, "Z", &timeline, expected_demands);
+  zone_initialize(&zone1, "Z", timeline, expected_demands);
   zone_copy(&zone2, &zone1);
 
   // Checks
@@ -112,7 +109,7 @@ void test_zone_copy(void) {
   // Teardown
   zone_free(&zone1);
   zone_free(&zone2);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -123,11 +120,10 @@ void test_zone_to_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
   struct Zone zone;
-  zone_initialize(&zone, "Z", &timeline, expected_demands);
+  zone_initialize(&zone, "Z", timeline, expected_demands);
   json_t* j = zone_to_json(&zone);
 
   // Checks
@@ -155,7 +151,7 @@ void test_zone_to_json(void) {
   // Teardown
   json_decref(j);
   zone_free(&zone);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -166,13 +162,12 @@ void test_zone_from_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 10.0, 8.0};
   struct Zone zone, json_zone;
-  zone_initialize(&zone, "Z", &timeline, expected_demands);
+  zone_initialize(&zone, "Z", timeline, expected_demands);
   json_t* j = zone_to_json(&zone);
-  zone_from_json(&json_zone, &timeline, j);
+  zone_from_json(&json_zone, timeline, j);
 
   // Checks
   ok(zone_are_equal(&zone, &json_zone),
@@ -182,7 +177,7 @@ void test_zone_from_json(void) {
   json_decref(j);
   zone_free(&zone);
   zone_free(&json_zone);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 int main(void) {
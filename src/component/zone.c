@@ -4,9 +4,32 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "series.h"
 #include "timeline.h"
+#include "utils/symbol_table.h"
 #include "validation.h"
 
+// Help functions
+// --------------
+
+/**
+ * Initializes a zone with an uninitialized series
+ *
+ * @param zone      The zone to initialize
+ * @param id        The identifier of the zone
+ * @param timeline  The reference timeline of the zone
+ */
+void zone_allocate(struct Zone* zone,
+                   const char* id,
+                   const struct Timeline* timeline) {
+  strncpy(zone->id, id, ID_MAX_LENGTH);
+  zone->id[ID_MAX_LENGTH] = '\0';
+  zone->symbol = symbol_table_intern(symbol_table_shared(), id);
+  zone->timeline = timeline_retain(timeline);
+  zone->expected_demands =
+    malloc(timeline->num_future_timesteps * sizeof(stored_mw));
+}
+
 // Initialization
 // --------------
 
@@ -14,21 +37,28 @@ void zone_initialize(struct Zone* zone,
                      const char* id,
                      const struct Timeline* timeline,
                      const mw* expected_demands) {
-  strncpy(zone->id, id, ID_MAX_LENGTH);
-  zone->timeline = timeline;
-  zone->expected_demands = malloc(timeline->num_future_timesteps * sizeof(mw));
-  memcpy(zone->expected_demands,
-         expected_demands,
-         timeline->num_future_timesteps * sizeof(mw));
+  zone_allocate(zone, id, timeline);
+  for (int t = 0; t < timeline->num_future_timesteps; ++t)
+    zone->expected_demands[t] = mw_store(expected_demands[t]);
 }
 
 void zone_copy(struct Zone* dest, const struct Zone* src) {
-  zone_initialize(dest, src->id, src->timeline, src->expected_demands);
+  zone_allocate(dest, src->id, src->timeline);
+  memcpy(dest->expected_demands,
+         src->expected_demands,
+         src->timeline->num_future_timesteps * sizeof(stored_mw));
 }
 
 void zone_from_json(struct Zone* zone,
                     const struct Timeline* timeline,
                     json_t* j) {
+  zone_validate_json(timeline, j);
+  const char* id = json_string_value(json_object_get(j, JSON_ZONE_ID));
+  zone_allocate(zone, id, timeline);
+  zone_series_from_json(zone, j);
+}
+
+void zone_validate_json(const struct Timeline* timeline, const json_t* j) {
   ensure_json_is_object(j);
   ensure_json_object_has_size(j, 2);
   ensure_json_object_contains_key(j, JSON_ZONE_ID);
@@ -36,14 +66,13 @@ void zone_from_json(struct Zone* zone,
   const json_t* j_id = json_object_get(j, JSON_ZONE_ID);
   ensure_json_is_string(j_id);
   const json_t* j_demands = json_object_get(j, JSON_ZONE_EXPECTED_DEMANDS);
-  ensure_json_is_array(j_demands);
-  ensure_json_array_has_size(j_demands, timeline->num_future_timesteps);
-  ensure_json_is_array_of_numbers(j_demands);
-  const char* id = json_string_value(json_object_get(j, JSON_ZONE_ID));
-  mw expected_demands[timeline->num_future_timesteps];
-  for (int t = 0; t < timeline->num_future_timesteps; ++t)
-    expected_demands[t] = json_number_value(json_array_get(j_demands, t));
-  zone_initialize(zone, id, timeline, expected_demands);
+  series_validate_json(j_demands, timeline->num_future_timesteps);
+}
+
+void zone_series_from_json(struct Zone* zone, const json_t* j) {
+  series_values_from_json(json_object_get(j, JSON_ZONE_EXPECTED_DEMANDS),
+                          zone->timeline->num_future_timesteps,
+                          zone->expected_demands);
 }
 
 // Destruction
@@ -51,13 +80,14 @@ void zone_from_json(struct Zone* zone,
 
 void zone_free(struct Zone* zone) {
   free(zone->expected_demands);
+  timeline_release(zone->timeline);
 }
 
 // Accessors
 // ---------
 
 bool zone_are_equal(const struct Zone* zone1, const struct Zone* zone2) {
-  if (strcmp(zone1->id, zone2->id) != 0)
+  if (zone1->symbol != zone2->symbol)
     return false;
   if (!timeline_are_equal(zone1->timeline, zone2->timeline))
     return false;
@@ -72,7 +102,7 @@ void zone_print(const struct Zone* zone) {
   printf("  Expected demands: ");
   for (int t = 0; t < zone->timeline->num_future_timesteps; ++t) {
     if (t > 0) printf(", ");
-    printf("%f", zone->expected_demands[t]);
+    printf("%f", mw_load(zone->expected_demands[t]));
   }
   printf("\n");
 }
@@ -83,7 +113,8 @@ void zone_print(const struct Zone* zone) {
 json_t* zone_to_json(const struct Zone* zone) {
   json_t* jdemands = json_array();
   for (int t = 0; t < zone->timeline->num_future_timesteps; ++t)
-    json_array_append_new(jdemands, json_real(zone->expected_demands[t]));
+    json_array_append_new(jdemands,
+                          json_real(mw_load(zone->expected_demands[t])));
   return json_pack("{s:o,s:s}",
                    JSON_ZONE_EXPECTED_DEMANDS, jdemands,
                    JSON_ZONE_ID, zone->id);
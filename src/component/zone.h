@@ -20,10 +20,12 @@
 struct Zone {
   // The identifier of the zone
   char id[ID_MAX_LENGTH + 1];
+  // The symbol of the identifier in the shared symbol table
+  unsigned int symbol;
   // The reference timeline
   const struct Timeline* timeline;
   // The expected demand for each timestep
-  mw* expected_demands;
+  stored_mw* expected_demands;
 };
 
 // Initialization
@@ -61,6 +63,27 @@ void zone_from_json(struct Zone* zone,
                     const struct Timeline* timeline,
                     json_t* j);
 
+/**
+ * Ensures that a JSON value describes a valid zone
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param timeline  The reference timeline of the zone
+ * @param j         The JSON value
+ */
+void zone_validate_json(const struct Timeline* timeline, const json_t* j);
+
+/**
+ * Reads the series of a zone from a JSON value
+ *
+ * The JSON value must have been validated with zone_validate_json, and the
+ * series of the zone must have room for a value per timestep.
+ *
+ * @param zone  The zone whose series is filled
+ * @param j     The JSON value
+ */
+void zone_series_from_json(struct Zone* zone, const json_t* j);
+
 // Destruction
 // -----------
 
@@ -1,11 +1,11 @@
 // The maximum length of an identifier
 #define ID_MAX_LENGTH 20
 
-// The maximum number of links
-#define MAX_NUM_LINKS 10
+// The initial capacity of the component tables of a scenario
+#define COMPONENT_TABLE_INITIAL_CAPACITY 8
 
-// The maximum number of plants
-#define MAX_NUM_PLANTS 10
+// The alignment in bytes of the time series matrices of a scenario
+#define SERIES_ALIGNMENT 64
 
-// The maximum number of zones
-#define MAX_NUM_ZONES 10
+// The size in bytes of the blocks of the arena of a scenario
+#define SCENARIO_ARENA_BLOCK_SIZE 65536
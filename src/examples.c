@@ -0,0 +1,57 @@
+#include "examples.h"
+
+#include "component/link.h"
+#include "component/plant.h"
+#include "component/zone.h"
+#include "unit.h"
+
+// Scenario with two zones, a link and two plants
+// ----------------------------------------------
+
+void network_scenario_example_initialize(
+  struct NetworkScenarioExample* example) {
+  int durations[] = {10, 30, 60};
+  mw demands[] = {5.0, 6.5, 1e5},
+     min_powers[] = {0.0, 1.5, 3.0},
+     max_powers[] = {7.0, 8.0, 900.5};
+  example->timeline = timeline_create(3, durations);
+  struct Scenario* scenario = &example->scenario;
+  scenario_initialize(scenario, example->timeline);
+  struct Zone* zone = scenario_emplace_zone(scenario, "Z1");
+  for (int t = 0; t < 3; ++t)
+    zone->expected_demands[t] = mw_store(demands[t]);
+  zone = scenario_emplace_zone(scenario, "Z2");
+  for (int t = 0; t < 3; ++t)
+    zone->expected_demands[t] = mw_store(demands[2 - t]);
+  scenario_emplace_link(scenario, "L1", 0, 1);
+  for (int p = 0; p < 2; ++p) {
+    struct Plant* plant = scenario_emplace_plant(scenario, p ? "P2" : "P1", p);
+    for (int t = 0; t < 3; ++t) {
+      plant->min_powers[t] = mw_store(min_powers[t] + p);
+      plant->max_powers[t] = mw_store(max_powers[t] + p);
+    }
+  }
+}
+
+void network_scenario_example_free(struct NetworkScenarioExample* example) {
+  scenario_free(&example->scenario);
+  timeline_release(example->timeline);
+}
+
+// Plan with two plants
+// --------------------
+
+void two_plants_plan_example_initialize(struct TwoPlantsPlanExample* example) {
+  int durations[] = {10, 30, 60};
+  example->timeline = timeline_create(3, durations);
+  plan_initialize(&example->plan, example->timeline);
+  for (int t = 0; t < 3; ++t) {
+    plan_set_production(&example->plan, t, "P2", 1.5 * t);
+    plan_set_production(&example->plan, t, "P1", 10.0 - t);
+  }
+}
+
+void two_plants_plan_example_free(struct TwoPlantsPlanExample* example) {
+  plan_free(&example->plan);
+  timeline_release(example->timeline);
+}
@@ -0,0 +1,69 @@
+#ifndef EXAMPLES_H
+#define EXAMPLES_H
+
+#include "plan.h"
+#include "scenario.h"
+#include "timeline.h"
+
+// Examples shared by unit tests
+// -----------------------------
+//
+// The examples are only compiled in test executables. Their values are
+// multiples of 0.5, so that they are stored exactly whatever the storage of
+// the time series.
+
+// An example of a scenario with two zones, a link and two plants
+//
+// On 3 timesteps of 10, 30 and 60 minutes:
+//
+// - zone Z1 expects demands of 5, 6.5 and 100000;
+// - zone Z2 expects demands of 100000, 6.5 and 5;
+// - link L1 goes from Z1 to Z2;
+// - plant P1, in Z1, has minimum powers of 0, 1.5 and 3, and maximum powers
+//   of 7, 8 and 900.5;
+// - plant P2, in Z2, has powers greater by 1 than those of P1.
+struct NetworkScenarioExample {
+  const struct Timeline* timeline; // The timeline
+  struct Scenario scenario; // The scenario
+};
+
+/**
+ * Initializes an example of a scenario with two zones, a link and two plants
+ *
+ * @param example  The example to initialize
+ */
+void network_scenario_example_initialize(
+  struct NetworkScenarioExample* example);
+
+/**
+ * Frees an example of a scenario with two zones, a link and two plants
+ *
+ * @param example  The example to free
+ */
+void network_scenario_example_free(struct NetworkScenarioExample* example);
+
+// An example of a plan with two plants
+//
+// On 3 timesteps of 10, 30 and 60 minutes, plant P2 produces 0, 1.5 and 3,
+// and plant P1 produces 10, 9 and 8. P2 is added first, so that the rows of
+// the plan are not sorted by identifier.
+struct TwoPlantsPlanExample {
+  const struct Timeline* timeline; // The timeline
+  struct Plan plan; // The plan
+};
+
+/**
+ * Initializes an example of a plan with two plants
+ *
+ * @param example  The example to initialize
+ */
+void two_plants_plan_example_initialize(struct TwoPlantsPlanExample* example);
+
+/**
+ * Frees an example of a plan with two plants
+ *
+ * @param example  The example to free
+ */
+void two_plants_plan_example_free(struct TwoPlantsPlanExample* example);
+
+#endif
@@ -0,0 +1,519 @@
+#include "arrow_writer.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "timeline.h"
+#include "utils/symbol_table.h"
+
+// The marker preceding the metadata of each message
+#define ARROW_CONTINUATION 0xFFFFFFFFu
+// The version of the metadata (MetadataVersion.V5)
+#define ARROW_METADATA_VERSION 4
+// The headers of messages (MessageHeader)
+#define ARROW_HEADER_SCHEMA 1
+#define ARROW_HEADER_DICTIONARY_BATCH 2
+#define ARROW_HEADER_RECORD_BATCH 3
+// The types of fields (Type)
+#define ARROW_TYPE_INT 2
+#define ARROW_TYPE_FLOATING_POINT 3
+#define ARROW_TYPE_UTF8 5
+// The precision of doubles (Precision.DOUBLE)
+#define ARROW_PRECISION_DOUBLE 2
+// The identifier of the dictionary of plant identifiers
+#define ARROW_PLANT_DICTIONARY 0
+// The number of columns of a plan
+#define ARROW_PLAN_NUM_COLUMNS 4
+// The number of bytes encoded at once in message bodies
+#define ARROW_CHUNK_SIZE 4096
+
+// Types
+// -----
+
+// A flatbuffer, built from front to back
+//
+// Objects are appended after the objects referencing them, whose offsets are
+// set once the referenced objects are written.
+struct FlatBuilder {
+  // The bytes of the flatbuffer
+  unsigned char* data;
+  // The number of bytes
+  size_t size;
+  // The number of allocated bytes
+  size_t capacity;
+};
+
+// A field of a flatbuffer table
+struct FlatField {
+  // The number of bytes of the field, or 0 if the field is absent
+  unsigned int size;
+  // The value of the field, or 0 for an offset set later
+  uint64_t value;
+};
+
+// Help functions
+// --------------
+
+/**
+ * Writes an unsigned integer in little-endian order
+ *
+ * @param bytes  The destination
+ * @param value  The value
+ * @param size   The number of bytes of the value
+ */
+void arrow_encode(unsigned char* bytes, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i)
+    bytes[i] = value >> (8 * i);
+}
+
+/**
+ * Returns a size rounded up to the alignment of Arrow buffers
+ *
+ * @param size  The size
+ * @return      The aligned size
+ */
+uint64_t arrow_align(uint64_t size) {
+  return (size + ARROW_ALIGNMENT - 1) / ARROW_ALIGNMENT * ARROW_ALIGNMENT;
+}
+
+/**
+ * Appends zero bytes to a flatbuffer
+ *
+ * @param builder  The flatbuffer
+ * @param size     The number of bytes
+ * @return         The position of the first appended byte
+ */
+size_t flat_append(struct FlatBuilder* builder, size_t size) {
+  if (builder->size + size > builder->capacity) {
+    builder->capacity = 2 * (builder->size + size);
+    builder->data = realloc(builder->data, builder->capacity);
+  }
+  memset(builder->data + builder->size, 0, size);
+  builder->size += size;
+  return builder->size - size;
+}
+
+/**
+ * Appends zero bytes to a flatbuffer until an object can be appended
+ *
+ * @param builder    The flatbuffer
+ * @param alignment  The alignment of the object, a power of 2
+ * @param offset     The position in the object that must be aligned
+ */
+void flat_align(struct FlatBuilder* builder, size_t alignment, size_t offset) {
+  flat_append(builder, (alignment - (builder->size + offset) % alignment) %
+                       alignment);
+}
+
+/**
+ * Sets an offset of a flatbuffer to an object appended after it
+ *
+ * @param builder  The flatbuffer
+ * @param offset   The position of the offset
+ * @param target   The position of the object
+ */
+void flat_link(struct FlatBuilder* builder, size_t offset, size_t target) {
+  arrow_encode(builder->data + offset, target - offset, 4);
+}
+
+/**
+ * Appends a table to a flatbuffer, preceded by its vtable
+ *
+ * The fields are laid out in the given order, each aligned on its size.
+ *
+ * @param builder     The flatbuffer
+ * @param fields      The fields of the table, by identifier
+ * @param num_fields  The number of fields
+ * @param positions   The position of each field, set by the function
+ * @return            The position of the table
+ */
+size_t flat_table(struct FlatBuilder* builder,
+                  const struct FlatField* fields,
+                  unsigned int num_fields,
+                  size_t* positions) {
+  size_t vtable_size = 4 + 2 * (size_t)num_fields;
+  size_t table_size = 4;
+  for (unsigned int f = 0; f < num_fields; ++f)
+    if (fields[f].size > 0)
+      table_size = (table_size + fields[f].size - 1) / fields[f].size *
+                   fields[f].size + fields[f].size;
+  // The vtable ends where the table starts, on an 8-byte boundary
+  flat_align(builder, 8, vtable_size);
+  size_t vtable = flat_append(builder, vtable_size);
+  size_t table = flat_append(builder, table_size);
+  arrow_encode(builder->data + vtable, vtable_size, 2);
+  arrow_encode(builder->data + vtable + 2, table_size, 2);
+  arrow_encode(builder->data + table, table - vtable, 4);
+  size_t offset = 4;
+  for (unsigned int f = 0; f < num_fields; ++f) {
+    if (fields[f].size == 0)
+      continue;
+    offset = (offset + fields[f].size - 1) / fields[f].size * fields[f].size;
+    arrow_encode(builder->data + vtable + 4 + 2 * f, offset, 2);
+    arrow_encode(builder->data + table + offset, fields[f].value,
+                 fields[f].size);
+    if (positions != NULL)
+      positions[f] = table + offset;
+    offset += fields[f].size;
+  }
+  return table;
+}
+
+/**
+ * Appends a vector of zeros to a flatbuffer
+ *
+ * @param builder       The flatbuffer
+ * @param num_elements  The number of elements
+ * @param element_size  The number of bytes of an element
+ * @param alignment     The alignment of the elements
+ * @return              The position of the vector, whose elements start 4
+ *                      bytes after
+ */
+size_t flat_vector(struct FlatBuilder* builder,
+                   size_t num_elements,
+                   size_t element_size,
+                   size_t alignment) {
+  flat_align(builder, alignment < 4 ? 4 : alignment, 4);
+  size_t vector = flat_append(builder, 4 + num_elements * element_size);
+  arrow_encode(builder->data + vector, num_elements, 4);
+  return vector;
+}
+
+/**
+ * Appends a string to a flatbuffer
+ *
+ * @param builder  The flatbuffer
+ * @param text     The string
+ * @return         The position of the string
+ */
+size_t flat_string(struct FlatBuilder* builder, const char* text) {
+  size_t length = strlen(text);
+  size_t string = flat_vector(builder, length + 1, 1, 4);
+  arrow_encode(builder->data + string, length, 4);
+  memcpy(builder->data + string + 4, text, length);
+  return string;
+}
+
+/**
+ * Starts the metadata of a message
+ *
+ * @param builder      The flatbuffer, empty
+ * @param header_type  The type of the header of the message
+ * @param body_length  The number of bytes of the body of the message
+ * @return             The position of the offset of the header
+ */
+size_t arrow_message(struct FlatBuilder* builder,
+                     unsigned int header_type,
+                     uint64_t body_length) {
+  size_t root = flat_append(builder, 4);
+  struct FlatField fields[] = {
+    {2, ARROW_METADATA_VERSION},  // version
+    {1, header_type},             // header_type
+    {4, 0},                       // header
+    {8, body_length}              // bodyLength
+  };
+  size_t positions[4];
+  flat_link(builder, root, flat_table(builder, fields, 4, positions));
+  return positions[2];
+}
+
+/**
+ * Writes a message made of its metadata, and returns before its body
+ *
+ * @param file     The file
+ * @param builder  The metadata of the message, released by the function
+ */
+void arrow_write_metadata(FILE* file, struct FlatBuilder* builder) {
+  flat_align(builder, ARROW_ALIGNMENT, 0);
+  unsigned char prefix[8];
+  arrow_encode(prefix, ARROW_CONTINUATION, 4);
+  arrow_encode(prefix + 4, builder->size, 4);
+  fwrite(prefix, 1, sizeof(prefix), file);
+  fwrite(builder->data, 1, builder->size, file);
+  free(builder->data);
+}
+
+/**
+ * Appends an Int type to a flatbuffer
+ *
+ * @param builder  The flatbuffer
+ * @return         The position of the type
+ */
+size_t arrow_int32_type(struct FlatBuilder* builder) {
+  struct FlatField fields[] = {
+    {4, 32},  // bitWidth
+    {1, 1}    // is_signed
+  };
+  return flat_table(builder, fields, 2, NULL);
+}
+
+/**
+ * Appends a field of the schema to a flatbuffer
+ *
+ * @param builder     The flatbuffer
+ * @param name        The name of the field
+ * @param type_type   The type of the field
+ * @param dictionary  Whether the field is dictionary-encoded
+ * @return            The position of the field
+ */
+size_t arrow_field(struct FlatBuilder* builder,
+                   const char* name,
+                   unsigned int type_type,
+                   bool dictionary) {
+  struct FlatField fields[] = {
+    {4, 0},                  // name
+    {1, 0},                  // nullable
+    {1, type_type},          // type_type
+    {4, 0},                  // type
+    {dictionary ? 4 : 0, 0}, // dictionary
+    {4, 0}                   // children
+  };
+  size_t positions[6];
+  size_t field = flat_table(builder, fields, 6, positions);
+  flat_link(builder, positions[0], flat_string(builder, name));
+  size_t type;
+  if (type_type == ARROW_TYPE_INT) {
+    type = arrow_int32_type(builder);
+  } else if (type_type == ARROW_TYPE_FLOATING_POINT) {
+    struct FlatField precision = {2, ARROW_PRECISION_DOUBLE};
+    type = flat_table(builder, &precision, 1, NULL);
+  } else {
+    // Utf8 has no field
+    type = flat_table(builder, NULL, 0, NULL);
+  }
+  flat_link(builder, positions[3], type);
+  if (dictionary) {
+    struct FlatField encoding[] = {
+      {8, ARROW_PLANT_DICTIONARY},  // id
+      {4, 0}                        // indexType
+    };
+    size_t encoding_positions[2];
+    flat_link(builder, positions[4],
+              flat_table(builder, encoding, 2, encoding_positions));
+    flat_link(builder, encoding_positions[1], arrow_int32_type(builder));
+  }
+  flat_link(builder, positions[5], flat_vector(builder, 0, 4, 4));
+  return field;
+}
+
+/**
+ * Appends the metadata of a record batch to a flatbuffer
+ *
+ * Each column has no null value, hence an empty validity buffer.
+ *
+ * @param builder       The flatbuffer
+ * @param num_rows      The number of rows
+ * @param num_columns   The number of columns
+ * @param buffer_sizes  The size of each buffer, before alignment
+ * @param num_buffers   The number of buffers
+ * @return              The position of the record batch
+ */
+size_t arrow_record_batch(struct FlatBuilder* builder,
+                          uint64_t num_rows,
+                          unsigned int num_columns,
+                          const uint64_t* buffer_sizes,
+                          unsigned int num_buffers) {
+  struct FlatField fields[] = {
+    {8, num_rows},  // length
+    {4, 0},         // nodes
+    {4, 0}          // buffers
+  };
+  size_t positions[3];
+  size_t batch = flat_table(builder, fields, 3, positions);
+  size_t nodes = flat_vector(builder, num_columns, 16, 8);
+  for (unsigned int c = 0; c < num_columns; ++c)
+    arrow_encode(builder->data + nodes + 4 + 16 * c, num_rows, 8);
+  flat_link(builder, positions[1], nodes);
+  size_t buffers = flat_vector(builder, num_buffers, 16, 8);
+  uint64_t offset = 0;
+  for (unsigned int b = 0; b < num_buffers; ++b) {
+    arrow_encode(builder->data + buffers + 4 + 16 * b, offset, 8);
+    arrow_encode(builder->data + buffers + 12 + 16 * b, buffer_sizes[b], 8);
+    offset += arrow_align(buffer_sizes[b]);
+  }
+  flat_link(builder, positions[2], buffers);
+  return batch;
+}
+
+/**
+ * Returns the size of the body of a record batch
+ *
+ * @param buffer_sizes  The size of each buffer, before alignment
+ * @param num_buffers   The number of buffers
+ * @return              The size of the body
+ */
+uint64_t arrow_body_length(const uint64_t* buffer_sizes,
+                           unsigned int num_buffers) {
+  uint64_t length = 0;
+  for (unsigned int b = 0; b < num_buffers; ++b)
+    length += arrow_align(buffer_sizes[b]);
+  return length;
+}
+
+/**
+ * Writes the zero bytes aligning a buffer of a message body
+ *
+ * @param file  The file
+ * @param size  The size of the buffer
+ */
+void arrow_write_padding(FILE* file, uint64_t size) {
+  static const unsigned char zeros[ARROW_ALIGNMENT];
+  fwrite(zeros, 1, arrow_align(size) - size, file);
+}
+
+/**
+ * Writes the schema of a plan
+ *
+ * @param file  The file
+ */
+void arrow_write_schema(FILE* file) {
+  struct FlatBuilder builder = {NULL, 0, 0};
+  size_t header = arrow_message(&builder, ARROW_HEADER_SCHEMA, 0);
+  struct FlatField fields[] = {
+    {2, 0},  // endianness, Little
+    {4, 0}   // fields
+  };
+  size_t positions[2];
+  flat_link(&builder, header, flat_table(&builder, fields, 2, positions));
+  size_t columns =
+    flat_vector(&builder, ARROW_PLAN_NUM_COLUMNS, 4, 4);
+  flat_link(&builder, positions[1], columns);
+  flat_link(&builder, columns + 4,
+            arrow_field(&builder, "timestep", ARROW_TYPE_INT, false));
+  flat_link(&builder, columns + 8,
+            arrow_field(&builder, "duration", ARROW_TYPE_INT, false));
+  flat_link(&builder, columns + 12,
+            arrow_field(&builder, "plant_id", ARROW_TYPE_UTF8, true));
+  flat_link(&builder, columns + 16,
+            arrow_field(&builder, "production", ARROW_TYPE_FLOATING_POINT,
+                        false));
+  arrow_write_metadata(file, &builder);
+}
+
+/**
+ * Writes the dictionary of the plant identifiers of a plan
+ *
+ * @param file    The file
+ * @param plan    The plan
+ * @param plants  The indices of the plants, sorted by identifier
+ */
+void arrow_write_dictionary(FILE* file,
+                            const struct Plan* plan,
+                            const unsigned int* plants) {
+  const struct SymbolTable* symbols = symbol_table_shared();
+  unsigned char* offsets = malloc(4 * ((size_t)plan->num_plants + 1));
+  uint64_t length = 0;
+  arrow_encode(offsets, 0, 4);
+  for (unsigned int i = 0; i < plan->num_plants; ++i) {
+    length += strlen(symbol_table_name(symbols,
+                                       plan->plant_symbols[plants[i]]));
+    arrow_encode(offsets + 4 * (i + 1), length, 4);
+  }
+  uint64_t buffer_sizes[] = {0, 4 * ((uint64_t)plan->num_plants + 1), length};
+
+  struct FlatBuilder builder = {NULL, 0, 0};
+  size_t header = arrow_message(&builder, ARROW_HEADER_DICTIONARY_BATCH,
+                                arrow_body_length(buffer_sizes, 3));
+  struct FlatField fields[] = {
+    {8, ARROW_PLANT_DICTIONARY},  // id
+    {4, 0}                        // data
+  };
+  size_t positions[2];
+  flat_link(&builder, header, flat_table(&builder, fields, 2, positions));
+  flat_link(&builder, positions[1],
+            arrow_record_batch(&builder, plan->num_plants, 1,
+                               buffer_sizes, 3));
+  arrow_write_metadata(file, &builder);
+
+  fwrite(offsets, 1, buffer_sizes[1], file);
+  arrow_write_padding(file, buffer_sizes[1]);
+  for (unsigned int i = 0; i < plan->num_plants; ++i)
+    fputs(symbol_table_name(symbols, plan->plant_symbols[plants[i]]), file);
+  arrow_write_padding(file, length);
+  free(offsets);
+}
+
+/**
+ * Writes a record batch with the productions of consecutive plants
+ *
+ * @param file    The file
+ * @param plan    The plan
+ * @param plants  The indices of the plants, sorted by identifier
+ * @param first   The rank of the first plant of the batch
+ * @param last    The rank after the last plant of the batch
+ */
+void arrow_write_record_batch(FILE* file,
+                              const struct Plan* plan,
+                              const unsigned int* plants,
+                              unsigned int first,
+                              unsigned int last) {
+  int num_timesteps = plan->timeline->num_future_timesteps;
+  uint64_t num_rows = (uint64_t)(last - first) * num_timesteps;
+  uint64_t buffer_sizes[] = {0, 4 * num_rows, 0, 4 * num_rows,
+                             0, 4 * num_rows, 0, 8 * num_rows};
+  struct FlatBuilder builder = {NULL, 0, 0};
+  size_t header = arrow_message(&builder, ARROW_HEADER_RECORD_BATCH,
+                                arrow_body_length(buffer_sizes, 8));
+  flat_link(&builder, header,
+            arrow_record_batch(&builder, num_rows, ARROW_PLAN_NUM_COLUMNS,
+                               buffer_sizes, 8));
+  arrow_write_metadata(file, &builder);
+
+  // The columns of each plant, encoded by chunks of whole timesteps
+  unsigned char chunk[ARROW_CHUNK_SIZE];
+  for (unsigned int column = 0; column < ARROW_PLAN_NUM_COLUMNS; ++column) {
+    size_t value_size = column == ARROW_PLAN_NUM_COLUMNS - 1 ? 8 : 4;
+    size_t chunk_values = sizeof(chunk) / value_size;
+    for (unsigned int i = first; i < last; ++i) {
+      for (int start = 0; start < num_timesteps; start += chunk_values) {
+        int end = num_timesteps - start < (int)chunk_values ?
+                  num_timesteps :
+                  start + (int)chunk_values;
+        for (int t = start; t < end; ++t) {
+          uint64_t value = t;
+          if (column == 1) {
+            value = plan->timeline->future_durations[t];
+          } else if (column == 2) {
+            value = i;
+          } else if (column == 3) {
+            double production =
+              plan_get_production_by_index(plan, t, plants[i]);
+            memcpy(&value, &production, sizeof(value));
+          }
+          arrow_encode(chunk + (t - start) * value_size, value, value_size);
+        }
+        fwrite(chunk, value_size, end - start, file);
+      }
+    }
+    arrow_write_padding(file, value_size * num_rows);
+  }
+}
+
+// Writing
+// -------
+
+void plan_write_arrow(const struct Plan* plan, FILE* file) {
+  unsigned int* plants = plan_plants_by_id(plan);
+  arrow_write_schema(file);
+  arrow_write_dictionary(file, plan, plants);
+  int num_timesteps = plan->timeline->num_future_timesteps;
+  if (num_timesteps > 0) {
+    unsigned int batch_plants = ARROW_BATCH_MAX_ROWS / num_timesteps;
+    if (batch_plants == 0)
+      batch_plants = 1;
+    for (unsigned int first = 0; first < plan->num_plants;
+         first += batch_plants) {
+      unsigned int last = plan->num_plants - first < batch_plants ?
+                          plan->num_plants :
+                          first + batch_plants;
+      arrow_write_record_batch(file, plan, plants, first, last);
+    }
+  }
+  // The end-of-stream marker
+  unsigned char end[8];
+  arrow_encode(end, ARROW_CONTINUATION, 4);
+  arrow_encode(end + 4, 0, 4);
+  fwrite(end, 1, sizeof(end), file);
+  free(plants);
+}
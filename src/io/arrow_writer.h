@@ -0,0 +1,44 @@
+#ifndef ARROW_WRITER_H
+#define ARROW_WRITER_H
+
+#include <stdio.h>
+
+#include "plan.h"
+
+// The largest number of rows of a record batch
+#define ARROW_BATCH_MAX_ROWS 65536
+// The alignment of the metadata and buffers of Arrow messages
+#define ARROW_ALIGNMENT 8
+
+// Arrow IPC output
+// ----------------
+//
+// A plan can be written as an Arrow IPC stream (the "streaming format" of
+// https://arrow.apache.org/docs/format/Columnar.html), which columnar tools
+// such as pandas, polars or DuckDB read without reshaping. The stream holds
+// one row per plant and timestep, with the columns:
+//
+// - "timestep", the index of the future timestep, as int32;
+// - "duration", the duration of the timestep in minutes, as int32;
+// - "plant_id", the identifier of the plant, as a dictionary-encoded string;
+// - "production", the production of the plant, as float64.
+//
+// The rows are grouped by plant, the plants being sorted by identifier as in
+// JSON plans. The stream is made of the schema, the dictionary of the plant
+// identifiers, record batches of at most ARROW_BATCH_MAX_ROWS rows (each with
+// whole plants, unless a plant has more timesteps) and the end-of-stream
+// marker. Every number is in little-endian order and every buffer is aligned
+// on ARROW_ALIGNMENT bytes, so that the columns can be mapped in memory.
+
+/**
+ * Writes a plan as an Arrow IPC stream
+ *
+ * Nothing is checked while writing: write errors are left in the error
+ * indicator of the file.
+ *
+ * @param plan  The plan to write
+ * @param file  The file to which the stream is written
+ */
+void plan_write_arrow(const struct Plan* plan, FILE* file);
+
+#endif
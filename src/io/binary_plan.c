@@ -0,0 +1,381 @@
+#include "binary_plan.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "io/json_input.h"
+#include "timeline.h"
+#include "utils/symbol_index.h"
+#include "utils/symbol_table.h"
+#include "validation.h"
+
+// The number of bytes copied at once from the temporary production matrix
+#define BINARY_PLAN_COPY_SIZE 65536
+
+// Types
+// -----
+
+// The state of the conversion of a JSON plan to the binary format
+struct BinaryPlanConversion {
+  // The reader of the JSON plan
+  struct JsonReader reader;
+  // The timeline, or NULL if not read yet
+  const struct Timeline* timeline;
+  // The number of productions of each plant, or -1 before the first plant
+  long num_timesteps;
+  // The number of plants
+  uint32_t num_plants;
+  // The identifiers of the plants
+  char (*ids)[BINARY_PLAN_ID_SIZE];
+  // The index of the plants by symbol
+  struct SymbolIndex plant_index;
+  // The production matrix, written as the plants are read
+  FILE* productions;
+};
+
+// Help functions
+// --------------
+
+/**
+ * Writes an unsigned integer in little-endian order
+ *
+ * @param bytes  The destination
+ * @param value  The value
+ * @param size   The number of bytes of the value
+ */
+void binary_plan_encode(unsigned char* bytes, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; ++i)
+    bytes[i] = value >> (8 * i);
+}
+
+/**
+ * Reads an unsigned integer stored in little-endian order
+ *
+ * @param bytes  The source
+ * @param size   The number of bytes of the value
+ * @return       The value
+ */
+uint64_t binary_plan_decode(const unsigned char* bytes, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i)
+    value |= (uint64_t)bytes[i] << (8 * i);
+  return value;
+}
+
+/**
+ * Writes a production in little-endian order
+ *
+ * @param file        The file
+ * @param production  The production
+ */
+void binary_plan_write_production(FILE* file, double production) {
+  uint64_t bits;
+  memcpy(&bits, &production, sizeof(bits));
+  unsigned char bytes[sizeof(bits)];
+  binary_plan_encode(bytes, bits, sizeof(bytes));
+  fwrite(bytes, 1, sizeof(bytes), file);
+}
+
+/**
+ * Reads a production stored in little-endian order
+ *
+ * @param bytes  The source
+ * @return       The production
+ */
+double binary_plan_read_production(const unsigned char* bytes) {
+  uint64_t bits = binary_plan_decode(bytes, sizeof(bits));
+  double production;
+  memcpy(&production, &bits, sizeof(production));
+  return production;
+}
+
+/**
+ * Computes the offsets of the sections of a binary plan
+ *
+ * @param header  The header, whose counts are set
+ */
+void binary_plan_layout(struct BinaryPlanHeader* header) {
+  header->durations_offset = BINARY_PLAN_HEADER_SIZE;
+  header->ids_offset = (header->durations_offset +
+                        4 * (uint64_t)header->num_timesteps + 7) / 8 * 8;
+  uint64_t ids_end = header->ids_offset +
+                     (uint64_t)header->num_plants * BINARY_PLAN_ID_SIZE;
+  header->productions_offset = (ids_end + SERIES_ALIGNMENT - 1) /
+                               SERIES_ALIGNMENT * SERIES_ALIGNMENT;
+  header->size = header->productions_offset +
+                 8 * (uint64_t)header->num_timesteps * header->num_plants;
+}
+
+/**
+ * Writes the sections of a binary plan preceding the production matrix
+ *
+ * @param file       The file
+ * @param timeline   The timeline of the plan
+ * @param num_plants The number of plants
+ * @param ids        The identifier of each plant, zero-padded
+ */
+void binary_plan_write_prefix(FILE* file,
+                              const struct Timeline* timeline,
+                              uint32_t num_plants,
+                              const char (*ids)[BINARY_PLAN_ID_SIZE]) {
+  struct BinaryPlanHeader header = {
+    .version = BINARY_PLAN_VERSION,
+    .num_timesteps = timeline->num_future_timesteps,
+    .num_plants = num_plants
+  };
+  binary_plan_layout(&header);
+  unsigned char bytes[BINARY_PLAN_HEADER_SIZE] = {0};
+  memcpy(bytes, BINARY_PLAN_MAGIC, sizeof(BINARY_PLAN_MAGIC));
+  binary_plan_encode(bytes + 8, header.version, 4);
+  binary_plan_encode(bytes + 12, header.num_timesteps, 4);
+  binary_plan_encode(bytes + 16, header.num_plants, 4);
+  binary_plan_encode(bytes + 24, header.durations_offset, 8);
+  binary_plan_encode(bytes + 32, header.ids_offset, 8);
+  binary_plan_encode(bytes + 40, header.productions_offset, 8);
+  binary_plan_encode(bytes + 48, header.size, 8);
+  fwrite(bytes, 1, sizeof(bytes), file);
+  uint64_t position = sizeof(bytes);
+  for (unsigned int t = 0; t < header.num_timesteps; ++t) {
+    binary_plan_encode(bytes, (uint32_t)timeline->future_durations[t], 4);
+    fwrite(bytes, 1, 4, file);
+    position += 4;
+  }
+  for (; position < header.ids_offset; ++position)
+    fputc(0, file);
+  if (num_plants > 0)
+    fwrite(ids, BINARY_PLAN_ID_SIZE, num_plants, file);
+  position += (uint64_t)num_plants * BINARY_PLAN_ID_SIZE;
+  for (; position < header.productions_offset; ++position)
+    fputc(0, file);
+}
+
+/**
+ * Copies an identifier to a zero-padded entry of an identifier table
+ *
+ * @param entry  The entry
+ * @param id     The identifier
+ */
+void binary_plan_set_id(char* entry, const char* id) {
+  memset(entry, 0, BINARY_PLAN_ID_SIZE);
+  strncpy(entry, id, ID_MAX_LENGTH);
+}
+
+/**
+ * Reads the productions of a plant of a JSON plan into the matrix
+ *
+ * A plant appearing twice overwrites its first productions, as when reading
+ * the plan.
+ *
+ * @param conversion  The conversion, after the key of the plant
+ */
+void binary_plan_convert_plant(struct BinaryPlanConversion* conversion) {
+  struct JsonReader* reader = &conversion->reader;
+  unsigned int symbol = symbol_table_intern(symbol_table_shared(),
+                                            reader->string);
+  uint32_t p = symbol_index_insert(&conversion->plant_index,
+                                   symbol,
+                                   conversion->num_plants);
+  if (p == conversion->num_plants) {
+    conversion->ids = realloc(conversion->ids,
+                              (p + 1) * sizeof(*conversion->ids));
+    binary_plan_set_id(conversion->ids[p], reader->string);
+    ++conversion->num_plants;
+  }
+  ensure_json_value_has_type(json_reader_next(reader) ==
+                             JSON_EVENT_ARRAY_START,
+                             "an array");
+  if (conversion->num_timesteps >= 0)
+    fseek(conversion->productions,
+          8 * (long)p * conversion->num_timesteps,
+          SEEK_SET);
+  long num_values = 0;
+  enum JsonEvent event;
+  while ((event = json_reader_next(reader)) != JSON_EVENT_ARRAY_END) {
+    double production = json_event_is_number(event) ? reader->real : 0.0;
+    json_reader_skip(reader, event);
+    binary_plan_write_production(conversion->productions, production);
+    ++num_values;
+  }
+  if (conversion->num_timesteps < 0)
+    conversion->num_timesteps = num_values;
+  ensure_json_container_has_size("array",
+                                 num_values,
+                                 conversion->timeline == NULL ?
+                                 conversion->num_timesteps :
+                                 conversion->timeline->num_future_timesteps);
+  fseek(conversion->productions, 0, SEEK_END);
+}
+
+/**
+ * Ensures that a binary plan is valid and returns its header
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param data  The content of the file
+ * @param size  The size of the file
+ * @return      The header
+ */
+struct BinaryPlanHeader binary_plan_read_header(const unsigned char* data,
+                                                size_t size) {
+  ensure_binary_plan_is_valid(
+    size >= BINARY_PLAN_HEADER_SIZE &&
+    memcmp(data, BINARY_PLAN_MAGIC, sizeof(BINARY_PLAN_MAGIC)) == 0,
+    "not a binary plan file");
+  struct BinaryPlanHeader header = {
+    .version = binary_plan_decode(data + 8, 4),
+    .num_timesteps = binary_plan_decode(data + 12, 4),
+    .num_plants = binary_plan_decode(data + 16, 4)
+  };
+  ensure_binary_plan_is_valid(header.version == BINARY_PLAN_VERSION,
+                              "unsupported version");
+  binary_plan_layout(&header);
+  ensure_binary_plan_is_valid(
+    binary_plan_decode(data + 24, 8) == header.durations_offset &&
+    binary_plan_decode(data + 32, 8) == header.ids_offset &&
+    binary_plan_decode(data + 40, 8) == header.productions_offset &&
+    binary_plan_decode(data + 48, 8) == header.size,
+    "unexpected layout");
+  ensure_binary_plan_is_valid(header.size == size,
+                              "unexpected size, the file may be truncated");
+  return header;
+}
+
+// Writing
+// -------
+
+void plan_write_binary(const struct Plan* plan, FILE* file) {
+  const struct SymbolTable* symbols = symbol_table_shared();
+  char (*ids)[BINARY_PLAN_ID_SIZE] =
+    malloc((plan->num_plants + 1) * sizeof(*ids));
+  for (unsigned int p = 0; p < plan->num_plants; ++p)
+    binary_plan_set_id(ids[p],
+                       symbol_table_name(symbols, plan->plant_symbols[p]));
+  binary_plan_write_prefix(file, plan->timeline, plan->num_plants, ids);
+  free(ids);
+  for (unsigned int p = 0; p < plan->num_plants; ++p)
+    for (int t = 0; t < plan->timeline->num_future_timesteps; ++t)
+      binary_plan_write_production(file,
+                                   plan_get_production_by_index(plan, t, p));
+}
+
+void plan_convert_json_to_binary(FILE* input, FILE* output) {
+  struct BinaryPlanConversion* conversion =
+    calloc(1, sizeof(struct BinaryPlanConversion));
+  struct JsonReader* reader = &conversion->reader;
+  json_reader_initialize(reader, input);
+  conversion->num_timesteps = -1;
+  symbol_index_initialize(&conversion->plant_index, NULL);
+  conversion->productions = tmpfile();
+  ensure_file_was_opened(conversion->productions, "a temporary file");
+  bool has_productions = false;
+  ensure_json_value_has_type(json_reader_next(reader) ==
+                             JSON_EVENT_OBJECT_START,
+                             "an object");
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    if (strcmp(reader->string, JSON_PLAN_TIMELINE) == 0) {
+      const struct Timeline* timeline = timeline_read_json(reader);
+      if (conversion->timeline == NULL)
+        conversion->timeline = timeline;
+      else
+        timeline_release(timeline);
+      if (conversion->num_timesteps >= 0)
+        ensure_json_container_has_size(
+          "array",
+          conversion->num_timesteps,
+          conversion->timeline->num_future_timesteps);
+    } else if (strcmp(reader->string, JSON_PLAN_PRODUCTIONS) == 0) {
+      has_productions = true;
+      ensure_json_value_has_type(json_reader_next(reader) ==
+                                 JSON_EVENT_OBJECT_START,
+                                 "an object");
+      while (json_reader_next(reader) == JSON_EVENT_KEY)
+        binary_plan_convert_plant(conversion);
+    } else {
+      json_reader_skip(reader, json_reader_next(reader));
+    }
+  }
+  ensure_json_key_was_found(conversion->timeline != NULL, JSON_PLAN_TIMELINE);
+  ensure_json_value_has_type(has_productions, "an object");
+  json_reader_next(reader);
+
+  binary_plan_write_prefix(output,
+                           conversion->timeline,
+                           conversion->num_plants,
+                           (const char (*)[BINARY_PLAN_ID_SIZE])
+                           conversion->ids);
+  rewind(conversion->productions);
+  char* buffer = malloc(BINARY_PLAN_COPY_SIZE);
+  size_t size;
+  while ((size = fread(buffer, 1, BINARY_PLAN_COPY_SIZE,
+                       conversion->productions)) > 0)
+    fwrite(buffer, 1, size, output);
+  free(buffer);
+  ensure_file_has_no_error(conversion->productions, "a temporary file");
+
+  fclose(conversion->productions);
+  symbol_index_delete(&conversion->plant_index);
+  free(conversion->ids);
+  timeline_release(conversion->timeline);
+  free(conversion);
+}
+
+// Reading
+// -------
+
+bool plan_file_is_binary(FILE* file) {
+  // Only regular files can be mapped, and probed without losing bytes
+  struct stat status;
+  if (fstat(fileno(file), &status) != 0 || !S_ISREG(status.st_mode))
+    return false;
+  char magic[sizeof(BINARY_PLAN_MAGIC)];
+  long position = ftell(file);
+  bool is_binary = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                   memcmp(magic, BINARY_PLAN_MAGIC, sizeof(magic)) == 0;
+  fseek(file, position, SEEK_SET);
+  return is_binary;
+}
+
+void plan_read_binary(struct Plan* plan, const char* filename) {
+  int fd = open(filename, O_RDONLY);
+  ensure_binary_plan_is_valid(fd >= 0, strerror(errno));
+  struct stat status;
+  ensure_binary_plan_is_valid(fstat(fd, &status) == 0, strerror(errno));
+  ensure_binary_plan_is_valid(status.st_size >= BINARY_PLAN_HEADER_SIZE,
+                              "truncated header");
+  size_t size = status.st_size;
+  const unsigned char* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ensure_binary_plan_is_valid(data != MAP_FAILED, strerror(errno));
+  close(fd);
+  struct BinaryPlanHeader header = binary_plan_read_header(data, size);
+
+  int* durations = malloc((header.num_timesteps + 1) * sizeof(int));
+  for (unsigned int t = 0; t < header.num_timesteps; ++t)
+    durations[t] = (int32_t)binary_plan_decode(data +
+                                               header.durations_offset + 4 * t,
+                                               4);
+  const struct Timeline* timeline = timeline_create(header.num_timesteps,
+                                                    durations);
+  free(durations);
+  plan_initialize(plan, timeline);
+  timeline_release(timeline);
+  for (unsigned int p = 0; p < header.num_plants; ++p) {
+    const char* id = (const char*)data + header.ids_offset +
+                     (size_t)p * BINARY_PLAN_ID_SIZE;
+    ensure_binary_plan_is_valid(id[ID_MAX_LENGTH] == '\0',
+                                "identifier is not terminated");
+    unsigned int index = plan_add_plant(plan, id);
+    const unsigned char* row = data + header.productions_offset +
+                               8 * (size_t)p * header.num_timesteps;
+    for (unsigned int t = 0; t < header.num_timesteps; ++t)
+      plan_set_production_by_index(plan,
+                                   t,
+                                   index,
+                                   binary_plan_read_production(row + 8 * t));
+  }
+  munmap((void*)data, size);
+}
@@ -0,0 +1,109 @@
+#ifndef BINARY_PLAN_H
+#define BINARY_PLAN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "plan.h"
+
+// The extension of binary plan files
+#define BINARY_PLAN_EXTENSION ".simplan"
+// The first bytes of a binary plan file
+#define BINARY_PLAN_MAGIC "SIMPLAN"
+// The version of the binary plan format
+#define BINARY_PLAN_VERSION 1
+// The size of the header of a binary plan
+#define BINARY_PLAN_HEADER_SIZE 64
+// The size of an entry of the identifier table of a binary plan
+#define BINARY_PLAN_ID_SIZE (ID_MAX_LENGTH + 1)
+
+// Types
+// -----
+
+// The header of a binary plan (`.simplan` file)
+//
+// The header takes BINARY_PLAN_HEADER_SIZE bytes: the magic, zero-padded to 8
+// bytes, the version, the number of timesteps, the number of plants, 4 zero
+// bytes, the offsets of the sections and the size of the file, followed by
+// zeros. It is followed by:
+//
+// - the duration of each future timestep, as int32;
+// - the identifier table, with one zero-padded entry of BINARY_PLAN_ID_SIZE
+//   bytes per plant;
+// - the production matrix, with one row of num_timesteps doubles per plant,
+//   starting on a SERIES_ALIGNMENT boundary.
+//
+// Every number is stored in little-endian order, whatever the machine, so
+// that the production matrix can be mapped in memory by other tools.
+struct BinaryPlanHeader {
+  // BINARY_PLAN_VERSION
+  uint32_t version;
+  // The number of future timesteps
+  uint32_t num_timesteps;
+  // The number of plants
+  uint32_t num_plants;
+  // The offset of the durations
+  uint64_t durations_offset;
+  // The offset of the identifier table
+  uint64_t ids_offset;
+  // The offset of the production matrix
+  uint64_t productions_offset;
+  // The size of the file
+  uint64_t size;
+};
+
+// Writing
+// -------
+
+/**
+ * Writes a plan in the binary format
+ *
+ * Write errors are left for the caller to check with ferror.
+ *
+ * @param plan  The plan
+ * @param file  The file to which the plan is written
+ */
+void plan_write_binary(const struct Plan* plan, FILE* file);
+
+/**
+ * Converts a JSON plan to the binary format, as a stream
+ *
+ * The productions are written as they are read, so that the memory used does
+ * not depend on the number of timesteps. If the JSON document is not a valid
+ * plan, or if the temporary file holding the productions fails, prints an
+ * error message and exits the program. Errors writing the output are left for
+ * the caller to check with ferror.
+ *
+ * @param input   The file containing the JSON plan
+ * @param output  The file to which the binary plan is written
+ */
+void plan_convert_json_to_binary(FILE* input, FILE* output);
+
+// Reading
+// -------
+
+/**
+ * Indicates if a file starts as a binary plan
+ *
+ * Only regular files are probed, and their position is restored. Nothing is
+ * read from other files, such as pipes, which are never binary plans.
+ *
+ * @param file  The file
+ * @return      true if and only if the file starts with BINARY_PLAN_MAGIC
+ */
+bool plan_file_is_binary(FILE* file);
+
+/**
+ * Initializes a plan from a binary plan file, mapped in memory
+ *
+ * If the file cannot be mapped or is invalid, prints an error message and
+ * exits the program.
+ *
+ * @param plan      The plan to initialize
+ * @param filename  The path of the file
+ */
+void plan_read_binary(struct Plan* plan, const char* filename);
+
+#endif
@@ -0,0 +1,377 @@
+#include "csv_input.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include <jansson.h>
+
+#include "component/link.h"
+#include "component/plant.h"
+#include "component/zone.h"
+#include "utils/float_parser.h"
+#include "utils/symbol_table.h"
+#include "validation.h"
+
+// The length of error messages, at most
+#define CSV_PROBLEM_SIZE 128
+
+// Types
+// -----
+
+// A reader of the lines of a CSV file
+struct CsvReader {
+  // The file
+  FILE* file;
+  // The path of the file
+  const char* filename;
+  // The number of the current line, starting at 1
+  unsigned int line;
+  // The current line, without its line break
+  char* text;
+  // The number of characters of the current line
+  size_t length;
+  // The capacity of the current line
+  size_t capacity;
+};
+
+// Help functions
+// --------------
+
+/**
+ * Reports a problem at the current line of a CSV file and exits the program
+ *
+ * @param reader   The reader
+ * @param problem  The description of the problem
+ */
+void csv_reader_fail(const struct CsvReader* reader, const char* problem) {
+  ensure_csv_is_valid(false, reader->filename, reader->line, problem);
+}
+
+/**
+ * Reads the next line of a CSV file
+ *
+ * @param reader  The reader
+ * @return        false if and only if the end of the file was reached
+ */
+bool csv_reader_next(struct CsvReader* reader) {
+  ssize_t length = getline(&reader->text, &reader->capacity, reader->file);
+  if (length < 0)
+    return false;
+  ++reader->line;
+  while (length > 0 && (reader->text[length - 1] == '\n' ||
+                        reader->text[length - 1] == '\r'))
+    --length;
+  reader->length = length;
+  return true;
+}
+
+/**
+ * Skips the spaces and tabulations of a text
+ *
+ * @param c    The start of the text
+ * @param end  The end of the text
+ * @return     The first character that is not blank
+ */
+const char* csv_skip_blanks(const char* c, const char* end) {
+  while (c < end && (*c == ' ' || *c == '\t'))
+    ++c;
+  return c;
+}
+
+/**
+ * Returns the path of a file given relatively to another file
+ *
+ * @param reference  The path of the reference file
+ * @param filename   The path of the file, relative to the directory of the
+ *                   reference file unless absolute
+ * @return           The path of the file, to be freed by the caller
+ */
+char* csv_input_path(const char* reference, const char* filename) {
+  const char* slash = strrchr(reference, '/');
+  size_t prefix = filename[0] == '/' || slash == NULL ?
+                  0 :
+                  (size_t)(slash - reference) + 1;
+  char* path = malloc(prefix + strlen(filename) + 1);
+  memcpy(path, reference, prefix);
+  strcpy(path + prefix, filename);
+  return path;
+}
+
+/**
+ * Reads the header of a CSV file of time series
+ *
+ * Each column is mapped to the index of its component in the scenario, or to
+ * -1 for the optional "timestep" column.
+ *
+ * @param reader          The reader, before the header
+ * @param index           The symbol index of the components
+ * @param num_components  The number of components
+ * @param kind            The kind of the components (e.g. "zone")
+ * @param num_columns     The number of columns
+ * @return                The component of each column, to be freed by the
+ *                        caller
+ */
+int* csv_read_header(struct CsvReader* reader,
+                     const struct SymbolIndex* index,
+                     unsigned int num_components,
+                     const char* kind,
+                     unsigned int* num_columns) {
+  if (!csv_reader_next(reader))
+    csv_reader_fail(reader, "missing header");
+  int* columns = malloc((reader->length + 1) * sizeof(int));
+  bool* found = calloc(num_components + 1, sizeof(bool));
+  char problem[CSV_PROBLEM_SIZE];
+  *num_columns = 0;
+  const char* end = reader->text + reader->length;
+  for (char* c = reader->text; c <= end; ++c) {
+    c = (char*)csv_skip_blanks(c, end);
+    char* cell = c;
+    while (c < end && *c != ',')
+      ++c;
+    char* cell_end = c;
+    while (cell_end > cell && (cell_end[-1] == ' ' || cell_end[-1] == '\t'))
+      --cell_end;
+    if (cell_end - cell >= 2 && *cell == '"' && cell_end[-1] == '"') {
+      ++cell;
+      --cell_end;
+    }
+    *cell_end = '\0';
+    int component = -1;
+    if (*num_columns > 0 || strcmp(cell, CSV_TIMESTEP_COLUMN) != 0) {
+      int symbol = symbol_table_find(symbol_table_shared(), cell);
+      component = symbol < 0 ? -1 : symbol_index_find(index, symbol);
+      if (component < 0 || found[component]) {
+        snprintf(problem, sizeof(problem), "%s %s identifier: %.64s",
+                 component < 0 ? "unknown" : "duplicate", kind, cell);
+        csv_reader_fail(reader, problem);
+      }
+      found[component] = true;
+    }
+    columns[(*num_columns)++] = component;
+  }
+  for (unsigned int b = 0; b < index->num_buckets; ++b)
+    if (index->values[b] != 0 && !found[index->values[b] - 1]) {
+      snprintf(problem, sizeof(problem), "missing column for %s %.64s", kind,
+               symbol_table_name(symbol_table_shared(), index->symbols[b]));
+      csv_reader_fail(reader, problem);
+    }
+  free(found);
+  return columns;
+}
+
+/**
+ * Reads a CSV file of time series, one column per component
+ *
+ * @param filename        The path of the CSV file
+ * @param num_timesteps   The number of rows of values
+ * @param index           The symbol index of the components
+ * @param num_components  The number of components
+ * @param kind            The kind of the components (e.g. "zone")
+ * @param series          The series of each component, filled by the function
+ */
+void csv_read_series(const char* filename,
+                     unsigned int num_timesteps,
+                     const struct SymbolIndex* index,
+                     unsigned int num_components,
+                     const char* kind,
+                     stored_mw** series) {
+  struct CsvReader reader = {fopen(filename, "r"), filename, 0, NULL, 0, 0};
+  ensure_file_was_opened(reader.file, filename);
+  unsigned int num_columns;
+  int* columns =
+    csv_read_header(&reader, index, num_components, kind, &num_columns);
+  for (unsigned int t = 0; t < num_timesteps; ++t) {
+    if (!csv_reader_next(&reader)) {
+      ++reader.line;
+      csv_reader_fail(&reader, "missing row of values");
+    }
+    const char* c = reader.text;
+    const char* end = reader.text + reader.length;
+    for (unsigned int i = 0; i < num_columns; ++i) {
+      if (i > 0 && c == end)
+        csv_reader_fail(&reader, "missing values");
+      else if (i > 0 && *c++ != ',')
+        csv_reader_fail(&reader, "invalid number");
+      c = csv_skip_blanks(c, end);
+      if (columns[i] < 0) {
+        while (c < end && *c != ',')
+          ++c;
+        continue;
+      }
+      double value;
+      c = float_parse(c, end, &value);
+      if (c == NULL)
+        csv_reader_fail(&reader, "invalid number");
+      series[columns[i]][t] = mw_store(value);
+      c = csv_skip_blanks(c, end);
+    }
+    if (c != end)
+      csv_reader_fail(&reader, *c == ',' ? "too many values" :
+                                           "invalid number");
+  }
+  while (csv_reader_next(&reader))
+    if (csv_skip_blanks(reader.text, reader.text + reader.length) !=
+        reader.text + reader.length)
+      csv_reader_fail(&reader, "too many rows");
+  free(columns);
+  free(reader.text);
+  fclose(reader.file);
+}
+
+/**
+ * Returns the index of the zone referenced by a key of a topology component
+ *
+ * @param scenario  The scenario
+ * @param j         The JSON component
+ * @param key       The key of the zone
+ * @return          The index of the zone
+ */
+unsigned int csv_input_zone_index(const struct Scenario* scenario,
+                                  const json_t* j,
+                                  const char* key) {
+  ensure_json_object_contains_key(j, key);
+  const json_t* j_zone = json_object_get(j, key);
+  ensure_json_is_string(j_zone);
+  const char* id = json_string_value(j_zone);
+  int zone = scenario_zone_index_by_id(scenario, id);
+  ensure_zone_exists(zone, id);
+  return zone;
+}
+
+/**
+ * Returns the identifier of a zone or a plant of a topology
+ *
+ * @param j     The JSON component
+ * @param size  The number of keys of the component
+ * @return      The identifier
+ */
+const char* csv_input_id(const json_t* j, int size) {
+  ensure_json_object_has_size(j, size);
+  ensure_json_object_contains_key(j, JSON_ZONE_ID);
+  const json_t* j_id = json_object_get(j, JSON_ZONE_ID);
+  ensure_json_is_string(j_id);
+  return json_string_value(j_id);
+}
+
+/**
+ * Returns an array of a topology, or NULL if it has none
+ *
+ * @param j    The JSON topology
+ * @param key  The key of the array
+ * @return     The array, or NULL
+ */
+const json_t* csv_input_array(const json_t* j, const char* key) {
+  const json_t* j_array = json_object_get(j, key);
+  if (j_array != NULL)
+    ensure_json_is_array(j_array);
+  return j_array;
+}
+
+/**
+ * Adds the components of a topology to a scenario
+ *
+ * @param scenario  The scenario, with a timeline
+ * @param j         The JSON topology
+ */
+void csv_input_add_components(struct Scenario* scenario, const json_t* j) {
+  const json_t* j_zones = csv_input_array(j, JSON_SCENARIO_ZONES);
+  const json_t* j_links = csv_input_array(j, JSON_SCENARIO_LINKS);
+  const json_t* j_plants = csv_input_array(j, JSON_SCENARIO_PLANTS);
+  scenario_reserve(scenario,
+                   json_array_size(j_links),
+                   json_array_size(j_plants),
+                   json_array_size(j_zones));
+  for (size_t z = 0; z < json_array_size(j_zones); ++z)
+    scenario_emplace_zone(scenario,
+                          csv_input_id(json_array_get(j_zones, z), 1));
+  for (size_t l = 0; l < json_array_size(j_links); ++l) {
+    const json_t* j_link = json_array_get(j_links, l);
+    unsigned int source =
+      csv_input_zone_index(scenario, j_link, JSON_LINK_SOURCE);
+    unsigned int target =
+      csv_input_zone_index(scenario, j_link, JSON_LINK_TARGET);
+    link_validate_json(scenario->zones, source, target, j_link);
+    const char* id = json_string_value(json_object_get(j_link, JSON_LINK_ID));
+    scenario_emplace_link(scenario, id, source, target);
+  }
+  for (size_t p = 0; p < json_array_size(j_plants); ++p) {
+    const json_t* j_plant = json_array_get(j_plants, p);
+    unsigned int zone = csv_input_zone_index(scenario, j_plant,
+                                             JSON_PLANT_ZONE);
+    scenario_emplace_plant(scenario, csv_input_id(j_plant, 2), zone);
+  }
+}
+
+/**
+ * Reads the CSV file of a kind of series given by a topology
+ *
+ * @param filename        The path of the topology file
+ * @param j_series        The JSON object giving the CSV files
+ * @param key             The key of the CSV file of the series
+ * @param index           The symbol index of the components
+ * @param num_components  The number of components
+ * @param kind            The kind of the components (e.g. "zone")
+ * @param num_timesteps   The number of timesteps
+ * @param series          The series of each component
+ */
+void csv_input_read_series(const char* filename,
+                           const json_t* j_series,
+                           const char* key,
+                           const struct SymbolIndex* index,
+                           unsigned int num_components,
+                           const char* kind,
+                           unsigned int num_timesteps,
+                           stored_mw** series) {
+  if (num_components == 0 && json_object_get(j_series, key) == NULL)
+    return;
+  ensure_json_object_contains_key(j_series, key);
+  const json_t* j_filename = json_object_get(j_series, key);
+  ensure_json_is_string(j_filename);
+  char* path = csv_input_path(filename, json_string_value(j_filename));
+  csv_read_series(path, num_timesteps, index, num_components, kind, series);
+  free(path);
+}
+
+// Reading
+// -------
+
+void scenario_read_csv(struct Scenario* scenario, const char* filename) {
+  json_error_t error;
+  json_t* j = json_load_file(filename, 0, &error);
+  ensure_json_was_loaded(j, &error);
+  ensure_json_is_object(j);
+  ensure_json_object_contains_key(j, JSON_SCENARIO_TIMELINE);
+  ensure_json_object_contains_key(j, JSON_TOPOLOGY_SERIES);
+  const json_t* j_series = json_object_get(j, JSON_TOPOLOGY_SERIES);
+  ensure_json_is_object(j_series);
+  const struct Timeline* timeline =
+    timeline_from_json(json_object_get(j, JSON_SCENARIO_TIMELINE));
+  scenario_initialize(scenario, timeline);
+  timeline_release(timeline);
+  csv_input_add_components(scenario, j);
+
+  unsigned int num_timesteps = scenario->timeline->num_future_timesteps;
+  unsigned int num_series = scenario->num_plants > scenario->num_zones ?
+                            scenario->num_plants :
+                            scenario->num_zones;
+  stored_mw** series = malloc((num_series + 1) * sizeof(stored_mw*));
+  for (unsigned int z = 0; z < scenario->num_zones; ++z)
+    series[z] = scenario_modify_zone_expected_demands(scenario, z);
+  csv_input_read_series(filename, j_series, JSON_ZONE_EXPECTED_DEMANDS,
+                        &scenario->zone_index, scenario->num_zones, "zone",
+                        num_timesteps, series);
+  for (unsigned int p = 0; p < scenario->num_plants; ++p)
+    series[p] = scenario_modify_plant_min_powers(scenario, p);
+  csv_input_read_series(filename, j_series, JSON_PLANT_MIN_POWERS,
+                        &scenario->plant_index, scenario->num_plants, "plant",
+                        num_timesteps, series);
+  for (unsigned int p = 0; p < scenario->num_plants; ++p)
+    series[p] = scenario_modify_plant_max_powers(scenario, p);
+  csv_input_read_series(filename, j_series, JSON_PLANT_MAX_POWERS,
+                        &scenario->plant_index, scenario->num_plants, "plant",
+                        num_timesteps, series);
+  free(series);
+  json_decref(j);
+}
@@ -0,0 +1,42 @@
+#ifndef CSV_INPUT_H
+#define CSV_INPUT_H
+
+#include "scenario.h"
+
+// The key of the topology giving the CSV files of the time series
+#define JSON_TOPOLOGY_SERIES "series"
+// The name of an optional first CSV column, which is ignored
+#define CSV_TIMESTEP_COLUMN "timestep"
+
+// CSV input
+// ---------
+//
+// A scenario can be split into a topology and time series. The topology is a
+// JSON scenario whose zones only have an "id", and whose plants only have an
+// "id" and a "zone". Its "series" object gives the CSV files of the expected
+// demands, the minimum powers and the maximum powers, relative to the
+// topology file:
+//
+//   "series": {
+//     "expected-demands": "demands.csv",
+//     "max-powers": "max-powers.csv",
+//     "min-powers": "min-powers.csv"
+//   }
+//
+// Each CSV file is a wide table: a header with the identifiers of the
+// components, then one row per timestep. An optional first column named
+// "timestep" is ignored. The numbers are parsed straight into the series of
+// the scenario, without intermediate representation.
+
+/**
+ * Initializes a scenario from a topology file and CSV time series
+ *
+ * If the files do not describe a valid scenario, prints an error message and
+ * exits the program.
+ *
+ * @param scenario  The scenario to initialize
+ * @param filename  The path of the topology file
+ */
+void scenario_read_csv(struct Scenario* scenario, const char* filename);
+
+#endif
@@ -0,0 +1,697 @@
+#include "json_input.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "component/link.h"
+#include "component/plant.h"
+#include "component/zone.h"
+#include "series.h"
+#include "utils/symbol_table.h"
+#include "validation.h"
+
+// Types
+// -----
+
+// A time series read from a JSON stream
+struct StagedSeries {
+  // The breakpoints of a compact series
+  struct Series runs;
+  // The values of a dense series
+  stored_mw* values;
+  // The number of values of a dense series
+  unsigned int num_values;
+  // The number of values the buffer can hold
+  unsigned int capacity;
+  // Whether the series is given by breakpoints
+  bool compact;
+};
+
+// A component read from a JSON stream
+struct StagedComponent {
+  // The identifier of the component
+  char id[ID_MAX_LENGTH + 1];
+  // The zone of a plant, or the source and target zones of a link
+  char zone_ids[2][ID_MAX_LENGTH + 1];
+  // The demands of a zone, or the minimum and maximum powers of a plant
+  struct StagedSeries series[2];
+};
+
+// Components of a kind waiting for their dependencies
+struct StagedComponents {
+  // The number of components
+  unsigned int num_components;
+  // The number of components the table can hold
+  unsigned int capacity;
+  // The components, in reading order
+  struct StagedComponent* components;
+};
+
+// The state of the streaming input of a scenario
+struct ScenarioInput {
+  // The reader of the JSON stream
+  struct JsonReader reader;
+  // The scenario being filled, initialized once the timeline is read
+  struct Scenario* scenario;
+  // Whether the timeline was read
+  bool has_timeline;
+  // Whether all zones were read
+  bool has_zones;
+  // The zones read before the timeline
+  struct StagedComponents zones;
+  // The links read before the timeline or the zones
+  struct StagedComponents links;
+  // The plants read before the timeline or the zones
+  struct StagedComponents plants;
+  // The component being read, whose series buffers are reused
+  struct StagedComponent component;
+};
+
+// The state of the streaming input of a plan
+struct PlanInput {
+  // The reader of the JSON stream
+  struct JsonReader reader;
+  // The plan being filled, initialized once the timeline is read
+  struct Plan* plan;
+  // Whether the timeline was read
+  bool has_timeline;
+  // The productions of the plants read before the timeline, as components
+  // whose first series holds the productions
+  struct StagedComponents plants;
+  // The productions of the plant being read
+  struct StagedComponent plant;
+};
+
+// Help functions
+// --------------
+
+/**
+ * Reads the next event of a stream and ensures that it has a given type
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param reader    The reader
+ * @param expected  The expected event
+ * @param type      The expected type, with its article
+ */
+void json_input_expect(struct JsonReader* reader,
+                       enum JsonEvent expected,
+                       const char* type) {
+  ensure_json_value_has_type(json_reader_next(reader) == expected, type);
+}
+
+/**
+ * Reads a string identifier from a stream
+ *
+ * @param reader  The reader
+ * @param id      The identifier, truncated to ID_MAX_LENGTH characters
+ */
+void json_input_read_id(struct JsonReader* reader, char* id) {
+  json_input_expect(reader, JSON_EVENT_STRING, "a string");
+  strncpy(id, reader->string, ID_MAX_LENGTH);
+  id[ID_MAX_LENGTH] = '\0';
+}
+
+/**
+ * Appends a value to a dense staged series
+ *
+ * @param series  The series
+ * @param value   The value
+ */
+void staged_series_append_value(struct StagedSeries* series, stored_mw value) {
+  if (series->num_values == series->capacity) {
+    series->capacity = series->capacity == 0 ? 64 : 2 * series->capacity;
+    series->values =
+      realloc(series->values, series->capacity * sizeof(stored_mw));
+  }
+  series->values[series->num_values++] = value;
+}
+
+/**
+ * Writes the values of a staged series at every timestep
+ *
+ * @param series         The series, checked with json_input_check_series
+ * @param num_timesteps  The number of timesteps
+ * @param values         The values, filled by the function
+ */
+void staged_series_decode(const struct StagedSeries* series,
+                          unsigned int num_timesteps,
+                          stored_mw* values) {
+  if (series->compact)
+    series_decode(&series->runs, num_timesteps, values);
+  else
+    memcpy(values, series->values, num_timesteps * sizeof(stored_mw));
+}
+
+/**
+ * Frees the buffers of a staged series
+ *
+ * @param series  The series
+ */
+void staged_series_free(struct StagedSeries* series) {
+  series_free(&series->runs);
+  free(series->values);
+}
+
+/**
+ * Reads a breakpoint of a compact series from a stream
+ *
+ * @param reader         The reader, after the start of the breakpoint
+ * @param series         The series to which the breakpoint is appended
+ * @param num_timesteps  The number of timesteps, or UINT_MAX if unknown
+ */
+void json_input_read_breakpoint(struct JsonReader* reader,
+                                struct StagedSeries* series,
+                                unsigned int num_timesteps) {
+  int num_keys = 0;
+  bool has_value = false, has_from = false;
+  mw value = 0.0;
+  long from = 0;
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    ++num_keys;
+    if (strcmp(reader->string, JSON_SERIES_VALUE) == 0) {
+      has_value = true;
+      ensure_json_value_has_type(json_event_is_number(json_reader_next(reader)),
+                                 "a number");
+      value = reader->real;
+    } else if (strcmp(reader->string, JSON_SERIES_FROM) == 0) {
+      has_from = true;
+      json_input_expect(reader, JSON_EVENT_INTEGER, "an integer");
+      from = reader->integer;
+    } else {
+      json_reader_skip(reader, json_reader_next(reader));
+    }
+  }
+  ensure_json_container_has_size("object", num_keys, 2);
+  ensure_json_key_was_found(has_value, JSON_SERIES_VALUE);
+  ensure_json_key_was_found(has_from, JSON_SERIES_FROM);
+  struct Series* runs = &series->runs;
+  long previous_from = runs->num_runs == 0 ?
+                       0 :
+                       (long)runs->starts[runs->num_runs - 1];
+  ensure_series_breakpoint_is_valid(runs->num_runs,
+                                    from,
+                                    previous_from,
+                                    num_timesteps);
+  series_append(runs, from, mw_store(value));
+}
+
+/**
+ * Reads a dense or compact time series from a stream
+ *
+ * @param reader         The reader, before the series
+ * @param series         The series, whose buffers are reused
+ * @param num_timesteps  The number of timesteps, or UINT_MAX if unknown
+ */
+void json_input_read_series(struct JsonReader* reader,
+                            struct StagedSeries* series,
+                            unsigned int num_timesteps) {
+  json_input_expect(reader, JSON_EVENT_ARRAY_START, "an array");
+  series->runs.num_runs = 0;
+  series->num_values = 0;
+  enum JsonEvent event = json_reader_next(reader);
+  series->compact = event == JSON_EVENT_OBJECT_START;
+  for (int i = 0; event != JSON_EVENT_ARRAY_END; ++i) {
+    if (series->compact) {
+      ensure_json_value_has_type(event == JSON_EVENT_OBJECT_START,
+                                 "an object");
+      json_input_read_breakpoint(reader, series, num_timesteps);
+    } else {
+      ensure_json_array_value_has_type(json_event_is_number(event),
+                                       i,
+                                       "a number");
+      staged_series_append_value(series, mw_store(reader->real));
+    }
+    event = json_reader_next(reader);
+  }
+}
+
+/**
+ * Ensures that a staged series fits a timeline
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param series         The series
+ * @param num_timesteps  The number of timesteps
+ */
+void json_input_check_series(const struct StagedSeries* series,
+                             unsigned int num_timesteps) {
+  if (!series->compact) {
+    ensure_json_container_has_size("array", series->num_values, num_timesteps);
+    return;
+  }
+  const struct Series* runs = &series->runs;
+  unsigned int last = runs->num_runs - 1;
+  ensure_series_breakpoint_is_valid(last,
+                                    runs->starts[last],
+                                    last == 0 ? 0 : runs->starts[last - 1],
+                                    num_timesteps);
+}
+
+/**
+ * Returns the number of timesteps of the series being read in a scenario
+ *
+ * @param input  The scenario input
+ * @return       The number of timesteps, or UINT_MAX if not known yet
+ */
+unsigned int scenario_input_num_timesteps(const struct ScenarioInput* input) {
+  return input->has_timeline ?
+         input->scenario->timeline->num_future_timesteps :
+         UINT_MAX;
+}
+
+/**
+ * Returns the index of a zone of the scenario being read
+ *
+ * If the zone does not exist, prints an error message and exits the program.
+ *
+ * @param input  The scenario input
+ * @param id     The identifier of the zone
+ * @return       The index of the zone
+ */
+unsigned int scenario_input_zone_index(const struct ScenarioInput* input,
+                                       const char* id) {
+  int zone = scenario_zone_index_by_id(input->scenario, id);
+  ensure_zone_exists(zone, id);
+  return zone;
+}
+
+/**
+ * Reads a zone from a stream into the current component
+ *
+ * @param input  The scenario input
+ * @param event  The first event of the zone
+ */
+void scenario_input_read_zone(struct ScenarioInput* input,
+                              enum JsonEvent event) {
+  struct JsonReader* reader = &input->reader;
+  struct StagedComponent* zone = &input->component;
+  ensure_json_value_has_type(event == JSON_EVENT_OBJECT_START, "an object");
+  int num_keys = 0;
+  bool has_id = false, has_demands = false;
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    ++num_keys;
+    if (strcmp(reader->string, JSON_ZONE_ID) == 0) {
+      has_id = true;
+      json_input_read_id(reader, zone->id);
+    } else if (strcmp(reader->string, JSON_ZONE_EXPECTED_DEMANDS) == 0) {
+      has_demands = true;
+      json_input_read_series(reader,
+                             &zone->series[0],
+                             scenario_input_num_timesteps(input));
+    } else {
+      json_reader_skip(reader, json_reader_next(reader));
+    }
+  }
+  ensure_json_container_has_size("object", num_keys, 2);
+  ensure_json_key_was_found(has_id, JSON_ZONE_ID);
+  ensure_json_key_was_found(has_demands, JSON_ZONE_EXPECTED_DEMANDS);
+}
+
+/**
+ * Reads a link from a stream into the current component
+ *
+ * @param input  The scenario input
+ * @param event  The first event of the link
+ */
+void scenario_input_read_link(struct ScenarioInput* input,
+                              enum JsonEvent event) {
+  struct JsonReader* reader = &input->reader;
+  struct StagedComponent* link = &input->component;
+  ensure_json_value_has_type(event == JSON_EVENT_OBJECT_START, "an object");
+  int num_keys = 0;
+  bool has_id = false, has_source = false, has_target = false;
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    ++num_keys;
+    if (strcmp(reader->string, JSON_LINK_ID) == 0) {
+      has_id = true;
+      json_input_read_id(reader, link->id);
+    } else if (strcmp(reader->string, JSON_LINK_SOURCE) == 0) {
+      has_source = true;
+      json_input_read_id(reader, link->zone_ids[0]);
+    } else if (strcmp(reader->string, JSON_LINK_TARGET) == 0) {
+      has_target = true;
+      json_input_read_id(reader, link->zone_ids[1]);
+    } else {
+      json_reader_skip(reader, json_reader_next(reader));
+    }
+  }
+  ensure_json_container_has_size("object", num_keys, 3);
+  ensure_json_key_was_found(has_id, JSON_LINK_ID);
+  ensure_json_key_was_found(has_source, JSON_LINK_SOURCE);
+  ensure_json_key_was_found(has_target, JSON_LINK_TARGET);
+}
+
+/**
+ * Reads a plant from a stream into the current component
+ *
+ * @param input  The scenario input
+ * @param event  The first event of the plant
+ */
+void scenario_input_read_plant(struct ScenarioInput* input,
+                               enum JsonEvent event) {
+  struct JsonReader* reader = &input->reader;
+  struct StagedComponent* plant = &input->component;
+  ensure_json_value_has_type(event == JSON_EVENT_OBJECT_START, "an object");
+  int num_keys = 0;
+  bool has_id = false, has_zone = false, has_min = false, has_max = false;
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    ++num_keys;
+    if (strcmp(reader->string, JSON_PLANT_ID) == 0) {
+      has_id = true;
+      json_input_read_id(reader, plant->id);
+    } else if (strcmp(reader->string, JSON_PLANT_ZONE) == 0) {
+      has_zone = true;
+      json_input_read_id(reader, plant->zone_ids[0]);
+    } else if (strcmp(reader->string, JSON_PLANT_MIN_POWERS) == 0) {
+      has_min = true;
+      json_input_read_series(reader,
+                             &plant->series[0],
+                             scenario_input_num_timesteps(input));
+    } else if (strcmp(reader->string, JSON_PLANT_MAX_POWERS) == 0) {
+      has_max = true;
+      json_input_read_series(reader,
+                             &plant->series[1],
+                             scenario_input_num_timesteps(input));
+    } else {
+      json_reader_skip(reader, json_reader_next(reader));
+    }
+  }
+  ensure_json_container_has_size("object", num_keys, 4);
+  ensure_json_key_was_found(has_id, JSON_PLANT_ID);
+  ensure_json_key_was_found(has_zone, JSON_PLANT_ZONE);
+  ensure_json_key_was_found(has_min, JSON_PLANT_MIN_POWERS);
+  ensure_json_key_was_found(has_max, JSON_PLANT_MAX_POWERS);
+}
+
+/**
+ * Adds a zone read from a stream to the scenario
+ *
+ * @param input  The scenario input, whose timeline is known
+ * @param zone   The zone
+ */
+void scenario_input_add_zone(struct ScenarioInput* input,
+                             const struct StagedComponent* zone) {
+  unsigned int num_timesteps = input->scenario->timeline->num_future_timesteps;
+  json_input_check_series(&zone->series[0], num_timesteps);
+  struct Zone* dest = scenario_emplace_zone(input->scenario, zone->id);
+  staged_series_decode(&zone->series[0], num_timesteps, dest->expected_demands);
+}
+
+/**
+ * Adds a link read from a stream to the scenario
+ *
+ * @param input  The scenario input, whose zones are known
+ * @param link   The link
+ */
+void scenario_input_add_link(struct ScenarioInput* input,
+                             const struct StagedComponent* link) {
+  unsigned int source = scenario_input_zone_index(input, link->zone_ids[0]);
+  unsigned int target = scenario_input_zone_index(input, link->zone_ids[1]);
+  scenario_emplace_link(input->scenario, link->id, source, target);
+}
+
+/**
+ * Adds a plant read from a stream to the scenario
+ *
+ * @param input  The scenario input, whose timeline and zones are known
+ * @param plant  The plant
+ */
+void scenario_input_add_plant(struct ScenarioInput* input,
+                              const struct StagedComponent* plant) {
+  unsigned int num_timesteps = input->scenario->timeline->num_future_timesteps;
+  unsigned int zone = scenario_input_zone_index(input, plant->zone_ids[0]);
+  json_input_check_series(&plant->series[0], num_timesteps);
+  json_input_check_series(&plant->series[1], num_timesteps);
+  struct Plant* dest = scenario_emplace_plant(input->scenario, plant->id, zone);
+  staged_series_decode(&plant->series[0], num_timesteps, dest->min_powers);
+  staged_series_decode(&plant->series[1], num_timesteps, dest->max_powers);
+}
+
+/**
+ * Moves a component to the components waiting for their dependencies
+ *
+ * The series of the component are handed over to the staged copy, and reset.
+ *
+ * @param staged     The staged components of the same kind
+ * @param component  The component
+ */
+void staged_components_append(struct StagedComponents* staged,
+                              struct StagedComponent* component) {
+  if (staged->num_components == staged->capacity) {
+    staged->capacity = staged->capacity == 0 ? 16 : 2 * staged->capacity;
+    staged->components =
+      realloc(staged->components,
+              staged->capacity * sizeof(struct StagedComponent));
+  }
+  staged->components[staged->num_components++] = *component;
+  memset(component->series, 0, sizeof(component->series));
+}
+
+/**
+ * Adds the staged components of a kind to the scenario
+ *
+ * @param input   The scenario input
+ * @param staged  The staged components
+ * @param add     The function adding a component to the scenario
+ */
+void scenario_input_unstage(
+  struct ScenarioInput* input,
+  struct StagedComponents* staged,
+  void (*add)(struct ScenarioInput*, const struct StagedComponent*)) {
+  for (unsigned int c = 0; c < staged->num_components; ++c) {
+    add(input, staged->components + c);
+    staged_series_free(&staged->components[c].series[0]);
+    staged_series_free(&staged->components[c].series[1]);
+  }
+  free(staged->components);
+  staged->num_components = 0;
+  staged->capacity = 0;
+  staged->components = NULL;
+}
+
+/**
+ * Adds the staged components whose dependencies are known to the scenario
+ *
+ * @param input  The scenario input
+ */
+void scenario_input_flush(struct ScenarioInput* input) {
+  if (!input->has_timeline)
+    return;
+  scenario_input_unstage(input, &input->zones, scenario_input_add_zone);
+  if (!input->has_zones)
+    return;
+  scenario_input_unstage(input, &input->links, scenario_input_add_link);
+  scenario_input_unstage(input, &input->plants, scenario_input_add_plant);
+}
+
+/**
+ * Reads an array of components of a scenario from a stream
+ *
+ * Each component is added to the scenario as soon as it is read if its
+ * dependencies are known, and staged otherwise.
+ *
+ * @param input   The scenario input
+ * @param read    The function reading a component
+ * @param add     The function adding a component to the scenario
+ * @param staged  The staged components of the same kind
+ * @param ready   Whether the dependencies of the components are known
+ */
+void scenario_input_read_components(
+  struct ScenarioInput* input,
+  void (*read)(struct ScenarioInput*, enum JsonEvent),
+  void (*add)(struct ScenarioInput*, const struct StagedComponent*),
+  struct StagedComponents* staged,
+  bool ready) {
+  json_input_expect(&input->reader, JSON_EVENT_ARRAY_START, "an array");
+  enum JsonEvent event;
+  while ((event = json_reader_next(&input->reader)) != JSON_EVENT_ARRAY_END) {
+    read(input, event);
+    if (ready)
+      add(input, &input->component);
+    else
+      staged_components_append(staged, &input->component);
+  }
+}
+
+/**
+ * Adds the productions of a plant read from a stream to the plan
+ *
+ * @param input  The plan input, whose timeline is known
+ * @param plant  The productions of the plant
+ */
+void plan_input_add_plant(struct PlanInput* input,
+                          const struct StagedComponent* plant) {
+  struct Plan* plan = input->plan;
+  const struct StagedSeries* productions = &plant->series[0];
+  unsigned int num_timesteps = plan->timeline->num_future_timesteps;
+  json_input_check_series(productions, num_timesteps);
+  unsigned int p = plan_add_plant(plan, plant->id);
+  staged_series_decode(productions,
+                       num_timesteps,
+                       plan->productions + (size_t)p * num_timesteps);
+}
+
+/**
+ * Reads the productions of the plants of a plan from a stream
+ *
+ * @param input  The plan input
+ */
+void plan_input_read_productions(struct PlanInput* input) {
+  struct JsonReader* reader = &input->reader;
+  struct StagedComponent* plant = &input->plant;
+  json_input_expect(reader, JSON_EVENT_OBJECT_START, "an object");
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    strncpy(plant->id, reader->string, ID_MAX_LENGTH);
+    plant->id[ID_MAX_LENGTH] = '\0';
+    json_input_expect(reader, JSON_EVENT_ARRAY_START, "an array");
+    plant->series[0].num_values = 0;
+    enum JsonEvent event;
+    while ((event = json_reader_next(reader)) != JSON_EVENT_ARRAY_END) {
+      mw production = json_event_is_number(event) ? reader->real : 0.0;
+      json_reader_skip(reader, event);
+      staged_series_append_value(&plant->series[0], mw_store(production));
+    }
+    if (input->has_timeline)
+      plan_input_add_plant(input, plant);
+    else
+      staged_components_append(&input->plants, plant);
+  }
+}
+
+/**
+ * Adds the productions read before the timeline to the plan
+ *
+ * @param input  The plan input, whose timeline is known
+ */
+void plan_input_flush(struct PlanInput* input) {
+  struct StagedComponents* staged = &input->plants;
+  for (unsigned int p = 0; p < staged->num_components; ++p) {
+    plan_input_add_plant(input, staged->components + p);
+    staged_series_free(&staged->components[p].series[0]);
+  }
+  free(staged->components);
+  staged->num_components = 0;
+  staged->capacity = 0;
+  staged->components = NULL;
+}
+
+// Timeline
+// --------
+
+const struct Timeline* timeline_read_json(struct JsonReader* reader) {
+  json_input_expect(reader, JSON_EVENT_OBJECT_START, "an object");
+  int num_keys = 0;
+  bool has_durations = false;
+  unsigned int num_timesteps = 0, capacity = 0;
+  int* durations = NULL;
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    ++num_keys;
+    if (strcmp(reader->string, JSON_TIMELINE_FUTURE_DURATIONS) != 0) {
+      json_reader_skip(reader, json_reader_next(reader));
+      continue;
+    }
+    has_durations = true;
+    num_timesteps = 0;
+    json_input_expect(reader, JSON_EVENT_ARRAY_START, "an array");
+    enum JsonEvent event;
+    while ((event = json_reader_next(reader)) != JSON_EVENT_ARRAY_END) {
+      ensure_json_array_value_has_type(event == JSON_EVENT_INTEGER,
+                                       num_timesteps,
+                                       "an integer");
+      if (num_timesteps == capacity) {
+        capacity = capacity == 0 ? 64 : 2 * capacity;
+        durations = realloc(durations, capacity * sizeof(int));
+      }
+      durations[num_timesteps++] = reader->integer;
+    }
+  }
+  ensure_json_container_has_size("object", num_keys, 1);
+  ensure_json_key_was_found(has_durations, JSON_TIMELINE_FUTURE_DURATIONS);
+  const struct Timeline* timeline = timeline_create(num_timesteps, durations);
+  free(durations);
+  return timeline;
+}
+
+// Scenario
+// --------
+
+void scenario_read_json(struct Scenario* scenario, FILE* file) {
+  struct ScenarioInput* input = calloc(1, sizeof(struct ScenarioInput));
+  struct JsonReader* reader = &input->reader;
+  json_reader_initialize(reader, file);
+  input->scenario = scenario;
+  json_input_expect(reader, JSON_EVENT_OBJECT_START, "an object");
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    bool ready = input->has_timeline && input->has_zones;
+    if (strcmp(reader->string, JSON_SCENARIO_TIMELINE) == 0) {
+      const struct Timeline* timeline = timeline_read_json(reader);
+      if (!input->has_timeline)
+        scenario_initialize(scenario, timeline);
+      timeline_release(timeline);
+      input->has_timeline = true;
+    } else if (strcmp(reader->string, JSON_SCENARIO_ZONES) == 0) {
+      scenario_input_read_components(input,
+                                     scenario_input_read_zone,
+                                     scenario_input_add_zone,
+                                     &input->zones,
+                                     input->has_timeline);
+      input->has_zones = true;
+    } else if (strcmp(reader->string, JSON_SCENARIO_LINKS) == 0) {
+      scenario_input_read_components(input,
+                                     scenario_input_read_link,
+                                     scenario_input_add_link,
+                                     &input->links,
+                                     ready);
+    } else if (strcmp(reader->string, JSON_SCENARIO_PLANTS) == 0) {
+      scenario_input_read_components(input,
+                                     scenario_input_read_plant,
+                                     scenario_input_add_plant,
+                                     &input->plants,
+                                     ready);
+    } else {
+      json_reader_skip(reader, json_reader_next(reader));
+    }
+    scenario_input_flush(input);
+  }
+  ensure_json_key_was_found(input->has_timeline, JSON_SCENARIO_TIMELINE);
+  input->has_zones = true;
+  scenario_input_flush(input);
+  json_reader_next(reader);
+  staged_series_free(&input->component.series[0]);
+  staged_series_free(&input->component.series[1]);
+  free(input);
+}
+
+// Plan
+// ----
+
+void plan_read_json(struct Plan* plan, FILE* file) {
+  struct PlanInput* input = calloc(1, sizeof(struct PlanInput));
+  struct JsonReader* reader = &input->reader;
+  json_reader_initialize(reader, file);
+  input->plan = plan;
+  bool has_productions = false;
+  json_input_expect(reader, JSON_EVENT_OBJECT_START, "an object");
+  while (json_reader_next(reader) == JSON_EVENT_KEY) {
+    if (strcmp(reader->string, JSON_PLAN_TIMELINE) == 0) {
+      const struct Timeline* timeline = timeline_read_json(reader);
+      if (!input->has_timeline)
+        plan_initialize(plan, timeline);
+      timeline_release(timeline);
+      input->has_timeline = true;
+      plan_input_flush(input);
+    } else if (strcmp(reader->string, JSON_PLAN_PRODUCTIONS) == 0) {
+      plan_input_read_productions(input);
+      has_productions = true;
+    } else {
+      json_reader_skip(reader, json_reader_next(reader));
+    }
+  }
+  ensure_json_key_was_found(input->has_timeline, JSON_PLAN_TIMELINE);
+  ensure_json_value_has_type(has_productions, "an object");
+  json_reader_next(reader);
+  staged_series_free(&input->plant.series[0]);
+  free(input);
+}
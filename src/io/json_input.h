@@ -0,0 +1,53 @@
+#ifndef JSON_INPUT_H
+#define JSON_INPUT_H
+
+#include <stdio.h>
+
+#include "io/json_reader.h"
+#include "plan.h"
+#include "scenario.h"
+#include "timeline.h"
+
+// Streaming JSON input
+// --------------------
+//
+// Scenarios and plans are filled while their JSON document is read, without
+// building the document in memory. The documents and the error messages are
+// the same as for scenario_from_json and plan_from_json. Since keys may come
+// in any order, components that cannot be added yet (e.g. plants read before
+// the timeline or the zones) are kept aside until their dependencies are
+// known: writing the timeline first, then the zones, lets every component be
+// added as soon as it is read. Components kept aside hold their series as
+// read, so that the memory used then grows with the document.
+
+/**
+ * Reads a timeline from a JSON stream
+ *
+ * @param reader  The reader, before the timeline
+ * @return        The timeline, to be released by the caller
+ */
+const struct Timeline* timeline_read_json(struct JsonReader* reader);
+
+/**
+ * Initializes a scenario from a JSON file, read as a stream
+ *
+ * If the document is not a valid scenario, prints an error message and exits
+ * the program.
+ *
+ * @param scenario  The scenario to initialize
+ * @param file      The file containing the JSON scenario
+ */
+void scenario_read_json(struct Scenario* scenario, FILE* file);
+
+/**
+ * Initializes a plan from a JSON file, read as a stream
+ *
+ * If the document is not a valid plan, prints an error message and exits the
+ * program.
+ *
+ * @param plan  The plan to initialize
+ * @param file  The file containing the JSON plan
+ */
+void plan_read_json(struct Plan* plan, FILE* file);
+
+#endif
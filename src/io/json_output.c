@@ -0,0 +1,148 @@
+#include "json_output.h"
+
+#include <stdlib.h>
+
+#include "component/link.h"
+#include "component/plant.h"
+#include "component/zone.h"
+#include "utils/symbol_table.h"
+
+// Help functions
+// --------------
+
+/**
+ * Writes a dense time series as an array of reals
+ *
+ * @param writer         The writer
+ * @param values         The values of the series
+ * @param num_timesteps  The number of values
+ */
+void json_output_series(struct JsonWriter* writer,
+                        const stored_mw* values,
+                        int num_timesteps) {
+  json_writer_start_array(writer);
+  for (int t = 0; t < num_timesteps; ++t)
+    json_writer_real(writer, mw_load(values[t]));
+  json_writer_end_array(writer);
+}
+
+/**
+ * Writes a link to a JSON stream
+ *
+ * @param writer  The writer
+ * @param link    The link to write
+ * @param zones   The zones of the scenario of the link
+ */
+void link_write_json(struct JsonWriter* writer,
+                     const struct Link* link,
+                     const struct Zone* zones) {
+  json_writer_start_object(writer);
+  json_writer_key(writer, JSON_LINK_ID);
+  json_writer_string(writer, link->id);
+  json_writer_key(writer, JSON_LINK_SOURCE);
+  json_writer_string(writer, zones[link->source].id);
+  json_writer_key(writer, JSON_LINK_TARGET);
+  json_writer_string(writer, zones[link->target].id);
+  json_writer_end_object(writer);
+}
+
+/**
+ * Writes a plant to a JSON stream
+ *
+ * @param writer  The writer
+ * @param plant   The plant to write
+ * @param zones   The zones of the scenario of the plant
+ */
+void plant_write_json(struct JsonWriter* writer,
+                      const struct Plant* plant,
+                      const struct Zone* zones) {
+  int num_timesteps = plant->timeline->num_future_timesteps;
+  json_writer_start_object(writer);
+  json_writer_key(writer, JSON_PLANT_ID);
+  json_writer_string(writer, plant->id);
+  json_writer_key(writer, JSON_PLANT_MAX_POWERS);
+  json_output_series(writer, plant->max_powers, num_timesteps);
+  json_writer_key(writer, JSON_PLANT_MIN_POWERS);
+  json_output_series(writer, plant->min_powers, num_timesteps);
+  json_writer_key(writer, JSON_PLANT_ZONE);
+  json_writer_string(writer, zones[plant->zone].id);
+  json_writer_end_object(writer);
+}
+
+/**
+ * Writes a zone to a JSON stream
+ *
+ * @param writer  The writer
+ * @param zone    The zone to write
+ */
+void zone_write_json(struct JsonWriter* writer, const struct Zone* zone) {
+  json_writer_start_object(writer);
+  json_writer_key(writer, JSON_ZONE_EXPECTED_DEMANDS);
+  json_output_series(writer, zone->expected_demands,
+                     zone->timeline->num_future_timesteps);
+  json_writer_key(writer, JSON_ZONE_ID);
+  json_writer_string(writer, zone->id);
+  json_writer_end_object(writer);
+}
+
+// Writing
+// -------
+
+void timeline_write_json(struct JsonWriter* writer,
+                         const struct Timeline* timeline) {
+  json_writer_start_object(writer);
+  json_writer_key(writer, JSON_TIMELINE_FUTURE_DURATIONS);
+  json_writer_start_array(writer);
+  for (int t = 0; t < timeline->num_future_timesteps; ++t)
+    json_writer_integer(writer, timeline->future_durations[t]);
+  json_writer_end_array(writer);
+  json_writer_end_object(writer);
+}
+
+void scenario_write_json(struct JsonWriter* writer,
+                         const struct Scenario* scenario) {
+  json_writer_start_object(writer);
+  json_writer_key(writer, JSON_SCENARIO_LINKS);
+  json_writer_start_array(writer);
+  for (int l = 0; l < scenario->num_links; ++l)
+    link_write_json(writer, scenario->links + l, scenario->zones);
+  json_writer_end_array(writer);
+  json_writer_key(writer, JSON_SCENARIO_PLANTS);
+  json_writer_start_array(writer);
+  for (int p = 0; p < scenario->num_plants; ++p)
+    plant_write_json(writer, scenario->plants + p, scenario->zones);
+  json_writer_end_array(writer);
+  json_writer_key(writer, JSON_SCENARIO_TIMELINE);
+  timeline_write_json(writer, scenario->timeline);
+  json_writer_key(writer, JSON_SCENARIO_ZONES);
+  json_writer_start_array(writer);
+  for (int z = 0; z < scenario->num_zones; ++z)
+    zone_write_json(writer, scenario->zones + z);
+  json_writer_end_array(writer);
+  json_writer_end_object(writer);
+}
+
+void plan_write_json(struct JsonWriter* writer, const struct Plan* plan) {
+  int num_timesteps = plan->timeline->num_future_timesteps;
+  json_writer_start_object(writer);
+  json_writer_key(writer, JSON_PLAN_PRODUCTIONS);
+  json_writer_start_object(writer);
+  if (num_timesteps > 0) {
+    const struct SymbolTable* symbols = symbol_table_shared();
+    unsigned int* plants = plan_plants_by_id(plan);
+    for (unsigned int i = 0; i < plan->num_plants; ++i) {
+      unsigned int symbol = plan->plant_symbols[plants[i]];
+      json_writer_key(writer, symbol_table_name(symbols, symbol));
+      json_writer_start_array(writer);
+      for (int t = 0; t < num_timesteps; ++t)
+        json_writer_real(writer,
+                         plan_get_production_by_index(plan, t, plants[i]));
+      json_writer_end_array(writer);
+    }
+    free(plants);
+  }
+  json_writer_end_object(writer);
+  json_writer_key(writer, JSON_PLAN_TIMELINE);
+  timeline_write_json(writer, plan->timeline);
+  json_writer_end_object(writer);
+}
@@ -0,0 +1,45 @@
+#ifndef JSON_OUTPUT_H
+#define JSON_OUTPUT_H
+
+#include "io/json_writer.h"
+#include "plan.h"
+#include "scenario.h"
+#include "timeline.h"
+
+// Streaming JSON output
+// ---------------------
+//
+// Scenarios and plans are written as they are traversed, without building the
+// document in memory. The documents are byte for byte the ones obtained by
+// dumping scenario_to_json and plan_to_json with JSON_INDENT(2): same keys,
+// same key order, same layout.
+
+/**
+ * Writes a timeline to a JSON stream
+ *
+ * @param writer    The writer
+ * @param timeline  The timeline to write
+ */
+void timeline_write_json(struct JsonWriter* writer,
+                         const struct Timeline* timeline);
+
+/**
+ * Writes a scenario to a JSON stream
+ *
+ * @param writer    The writer
+ * @param scenario  The scenario to write
+ */
+void scenario_write_json(struct JsonWriter* writer,
+                         const struct Scenario* scenario);
+
+/**
+ * Writes a plan to a JSON stream
+ *
+ * The productions are written by plant identifier, as for plan_to_json.
+ *
+ * @param writer  The writer
+ * @param plan    The plan to write
+ */
+void plan_write_json(struct JsonWriter* writer, const struct Plan* plan);
+
+#endif
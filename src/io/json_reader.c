@@ -0,0 +1,469 @@
+#include "json_reader.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+
+// The parsing states of a document, and of its arrays and objects
+#define JSON_STATE_ROOT 0                // Before the value of the document
+#define JSON_STATE_DONE 1                // After the value of the document
+#define JSON_STATE_OBJECT_FIRST_KEY 2    // After '{'
+#define JSON_STATE_OBJECT_KEY 3          // After ',' in an object
+#define JSON_STATE_OBJECT_COLON 4        // After a key
+#define JSON_STATE_OBJECT_AFTER_VALUE 5  // After a value in an object
+#define JSON_STATE_ARRAY_FIRST_VALUE 6   // After '['
+#define JSON_STATE_ARRAY_AFTER_VALUE 7   // After a value in an array
+
+// Help functions
+// --------------
+
+/**
+ * Returns the next byte of a document without consuming it
+ *
+ * @param reader  The reader
+ * @return        The next byte, or EOF at the end of the file
+ */
+int json_reader_peek(struct JsonReader* reader) {
+  if (reader->position == reader->size) {
+    reader->size = fread(reader->buffer, 1, JSON_READER_BUFFER_SIZE,
+                         reader->file);
+    reader->position = 0;
+    if (reader->size == 0)
+      return EOF;
+  }
+  return (unsigned char)reader->buffer[reader->position];
+}
+
+/**
+ * Consumes the next byte of a document
+ *
+ * @param reader  The reader, whose next byte was peeked
+ */
+void json_reader_advance(struct JsonReader* reader) {
+  if (reader->buffer[reader->position] == '\n') {
+    ++reader->line;
+    reader->column = 1;
+  } else {
+    ++reader->column;
+  }
+  ++reader->position;
+}
+
+/**
+ * Consumes whitespace and returns the next byte of a document
+ *
+ * @param reader  The reader
+ * @return        The next byte that is not whitespace, or EOF
+ */
+int json_reader_skip_whitespace(struct JsonReader* reader) {
+  int c = json_reader_peek(reader);
+  while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+    json_reader_advance(reader);
+    c = json_reader_peek(reader);
+  }
+  return c;
+}
+
+/**
+ * Consumes an expected byte of a document
+ *
+ * @param reader    The reader
+ * @param expected  The expected byte
+ * @param message   The error reported if the next byte is not the expected one
+ */
+void json_reader_expect(struct JsonReader* reader,
+                        int expected,
+                        const char* message) {
+  if (json_reader_peek(reader) != expected)
+    json_reader_fail(reader, message);
+  json_reader_advance(reader);
+}
+
+/**
+ * Appends a byte to the string being read
+ *
+ * @param reader  The reader
+ * @param length  The length of the string, incremented by the function
+ * @param c       The byte
+ */
+void json_reader_append(struct JsonReader* reader, size_t* length, int c) {
+  if (*length == JSON_READER_MAX_STRING_LENGTH)
+    json_reader_fail(reader, "string too long");
+  reader->string[(*length)++] = c;
+}
+
+/**
+ * Reads the 4 hexadecimal digits of a \u escape
+ *
+ * @param reader  The reader
+ * @return        The code unit
+ */
+unsigned int json_reader_read_code_unit(struct JsonReader* reader) {
+  unsigned int code = 0;
+  for (int i = 0; i < 4; ++i) {
+    int c = json_reader_peek(reader);
+    unsigned int digit;
+    if (c >= '0' && c <= '9')
+      digit = c - '0';
+    else if (c >= 'a' && c <= 'f')
+      digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      digit = c - 'A' + 10;
+    else
+      json_reader_fail(reader, "invalid escape");
+    json_reader_advance(reader);
+    code = 16 * code + digit;
+  }
+  return code;
+}
+
+/**
+ * Reads a \u escape and appends its UTF-8 encoding to the string being read
+ *
+ * @param reader  The reader, after "\u"
+ * @param length  The length of the string, updated by the function
+ */
+void json_reader_read_unicode_escape(struct JsonReader* reader,
+                                     size_t* length) {
+  unsigned long code = json_reader_read_code_unit(reader);
+  if (code >= 0xD800 && code <= 0xDBFF) {
+    json_reader_expect(reader, '\\', "invalid Unicode surrogate pair");
+    json_reader_expect(reader, 'u', "invalid Unicode surrogate pair");
+    unsigned long low = json_reader_read_code_unit(reader);
+    if (low < 0xDC00 || low > 0xDFFF)
+      json_reader_fail(reader, "invalid Unicode surrogate pair");
+    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+  } else if (code >= 0xDC00 && code <= 0xDFFF) {
+    json_reader_fail(reader, "invalid Unicode surrogate pair");
+  } else if (code == 0) {
+    json_reader_fail(reader, "\\u0000 is not allowed");
+  }
+  if (code < 0x80) {
+    json_reader_append(reader, length, code);
+  } else if (code < 0x800) {
+    json_reader_append(reader, length, 0xC0 | (code >> 6));
+    json_reader_append(reader, length, 0x80 | (code & 0x3F));
+  } else if (code < 0x10000) {
+    json_reader_append(reader, length, 0xE0 | (code >> 12));
+    json_reader_append(reader, length, 0x80 | ((code >> 6) & 0x3F));
+    json_reader_append(reader, length, 0x80 | (code & 0x3F));
+  } else {
+    json_reader_append(reader, length, 0xF0 | (code >> 18));
+    json_reader_append(reader, length, 0x80 | ((code >> 12) & 0x3F));
+    json_reader_append(reader, length, 0x80 | ((code >> 6) & 0x3F));
+    json_reader_append(reader, length, 0x80 | (code & 0x3F));
+  }
+}
+
+/**
+ * Reads a string into the string of a reader
+ *
+ * @param reader  The reader, before the opening quote
+ */
+void json_reader_read_string(struct JsonReader* reader) {
+  json_reader_advance(reader);
+  size_t length = 0;
+  for (;;) {
+    int c = json_reader_peek(reader);
+    if (c == EOF)
+      json_reader_fail(reader, "premature end of input");
+    if (c < 0x20)
+      json_reader_fail(reader, "control character in string");
+    json_reader_advance(reader);
+    if (c == '"')
+      break;
+    if (c != '\\') {
+      json_reader_append(reader, &length, c);
+      continue;
+    }
+    c = json_reader_peek(reader);
+    if (c != EOF)
+      json_reader_advance(reader);
+    switch (c) {
+      case '"': case '\\': case '/':
+        json_reader_append(reader, &length, c);
+        break;
+      case 'b': json_reader_append(reader, &length, '\b'); break;
+      case 'f': json_reader_append(reader, &length, '\f'); break;
+      case 'n': json_reader_append(reader, &length, '\n'); break;
+      case 'r': json_reader_append(reader, &length, '\r'); break;
+      case 't': json_reader_append(reader, &length, '\t'); break;
+      case 'u': json_reader_read_unicode_escape(reader, &length); break;
+      default: json_reader_fail(reader, "invalid escape");
+    }
+  }
+  reader->string[length] = '\0';
+}
+
+/**
+ * Appends a character to the text of a number
+ *
+ * If the number is too long, prints an error message and exits the program.
+ *
+ * @param reader  The reader
+ * @param text    The text of the number
+ * @param length  The length of the text, updated by the function
+ * @param c       The character
+ */
+void json_reader_append_to_number(const struct JsonReader* reader,
+                                  char* text,
+                                  size_t* length,
+                                  char c) {
+  if (*length >= JSON_READER_MAX_NUMBER_LENGTH)
+    json_reader_fail(reader, "number too long");
+  text[(*length)++] = c;
+}
+
+/**
+ * Appends the digits of a number to its text
+ *
+ * @param reader  The reader
+ * @param text    The text of the number
+ * @param length  The length of the text, updated by the function
+ * @return        The number of appended digits
+ */
+size_t json_reader_read_digits(struct JsonReader* reader,
+                               char* text,
+                               size_t* length) {
+  size_t num_digits = 0;
+  int c = json_reader_peek(reader);
+  while (c >= '0' && c <= '9') {
+    json_reader_append_to_number(reader, text, length, c);
+    json_reader_advance(reader);
+    ++num_digits;
+    c = json_reader_peek(reader);
+  }
+  return num_digits;
+}
+
+/**
+ * Reads a number
+ *
+ * @param reader  The reader, before the first character of the number
+ * @return        JSON_EVENT_INTEGER or JSON_EVENT_REAL
+ */
+enum JsonEvent json_reader_read_number(struct JsonReader* reader) {
+  char text[JSON_READER_MAX_NUMBER_LENGTH + 1];
+  size_t length = 0;
+  bool is_real = false;
+  if (json_reader_peek(reader) == '-') {
+    json_reader_append_to_number(reader, text, &length, '-');
+    json_reader_advance(reader);
+  }
+  if (json_reader_peek(reader) == '0') {
+    json_reader_append_to_number(reader, text, &length, '0');
+    json_reader_advance(reader);
+  } else if (json_reader_read_digits(reader, text, &length) == 0) {
+    json_reader_fail(reader, "invalid number");
+  }
+  if (json_reader_peek(reader) == '.') {
+    is_real = true;
+    json_reader_append_to_number(reader, text, &length, '.');
+    json_reader_advance(reader);
+    if (json_reader_read_digits(reader, text, &length) == 0)
+      json_reader_fail(reader, "invalid number");
+  }
+  int c = json_reader_peek(reader);
+  if (c == 'e' || c == 'E') {
+    is_real = true;
+    json_reader_append_to_number(reader, text, &length, 'e');
+    json_reader_advance(reader);
+    c = json_reader_peek(reader);
+    if (c == '+' || c == '-') {
+      json_reader_append_to_number(reader, text, &length, c);
+      json_reader_advance(reader);
+    }
+    if (json_reader_read_digits(reader, text, &length) == 0)
+      json_reader_fail(reader, "invalid number");
+  }
+  text[length] = '\0';
+  errno = 0;
+  if (!is_real) {
+    reader->integer = strtoll(text, NULL, 10);
+    if (errno == ERANGE)
+      json_reader_fail(reader, "too big integer");
+    reader->real = reader->integer;
+    return JSON_EVENT_INTEGER;
+  }
+  reader->real = strtod(text, NULL);
+  if (errno == ERANGE && isinf(reader->real))
+    json_reader_fail(reader, "real number overflow");
+  return JSON_EVENT_REAL;
+}
+
+/**
+ * Reads a literal
+ *
+ * @param reader   The reader, before the first character of the literal
+ * @param literal  The expected literal
+ * @param event    The event of the literal
+ * @return         The event of the literal
+ */
+enum JsonEvent json_reader_read_literal(struct JsonReader* reader,
+                                        const char* literal,
+                                        enum JsonEvent event) {
+  for (const char* c = literal; *c != '\0'; ++c)
+    json_reader_expect(reader, *c, "invalid token");
+  return event;
+}
+
+/**
+ * Enters an array or an object
+ *
+ * @param reader  The reader
+ * @param state   The initial state of the array or object
+ */
+void json_reader_push(struct JsonReader* reader, unsigned char state) {
+  if (reader->depth == JSON_READER_MAX_DEPTH)
+    json_reader_fail(reader, "maximum nesting depth exceeded");
+  json_reader_advance(reader);
+  reader->states[++reader->depth] = state;
+}
+
+/**
+ * Leaves an array or an object
+ *
+ * @param reader  The reader, before the closing bracket or brace
+ * @param event   The event of the end of the array or object
+ * @return        The event
+ */
+enum JsonEvent json_reader_pop(struct JsonReader* reader,
+                               enum JsonEvent event) {
+  json_reader_advance(reader);
+  --reader->depth;
+  return event;
+}
+
+/**
+ * Reads a value
+ *
+ * @param reader  The reader, before the first character of the value
+ * @return        The first event of the value
+ */
+enum JsonEvent json_reader_read_value(struct JsonReader* reader) {
+  switch (json_reader_peek(reader)) {
+    case '{':
+      json_reader_push(reader, JSON_STATE_OBJECT_FIRST_KEY);
+      return JSON_EVENT_OBJECT_START;
+    case '[':
+      json_reader_push(reader, JSON_STATE_ARRAY_FIRST_VALUE);
+      return JSON_EVENT_ARRAY_START;
+    case '"':
+      json_reader_read_string(reader);
+      return JSON_EVENT_STRING;
+    case '-': case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+      return json_reader_read_number(reader);
+    case 't':
+      return json_reader_read_literal(reader, "true", JSON_EVENT_TRUE);
+    case 'f':
+      return json_reader_read_literal(reader, "false", JSON_EVENT_FALSE);
+    case 'n':
+      return json_reader_read_literal(reader, "null", JSON_EVENT_NULL);
+    case EOF:
+      json_reader_fail(reader, "premature end of input");
+      break;
+    default:
+      json_reader_fail(reader, "invalid token");
+      break;
+  }
+  return JSON_EVENT_END;
+}
+
+/**
+ * Reads a key
+ *
+ * @param reader  The reader, before the opening quote of the key
+ * @return        JSON_EVENT_KEY
+ */
+enum JsonEvent json_reader_read_key(struct JsonReader* reader) {
+  if (json_reader_peek(reader) != '"')
+    json_reader_fail(reader, "string expected as object key");
+  json_reader_read_string(reader);
+  reader->states[reader->depth] = JSON_STATE_OBJECT_COLON;
+  return JSON_EVENT_KEY;
+}
+
+// Initialization
+// --------------
+
+void json_reader_initialize(struct JsonReader* reader, FILE* file) {
+  reader->file = file;
+  reader->size = 0;
+  reader->position = 0;
+  reader->line = 1;
+  reader->column = 1;
+  reader->depth = 0;
+  reader->states[0] = JSON_STATE_ROOT;
+  reader->string[0] = '\0';
+  reader->integer = 0;
+  reader->real = 0.0;
+}
+
+// Reading
+// -------
+
+enum JsonEvent json_reader_next(struct JsonReader* reader) {
+  int c = json_reader_skip_whitespace(reader);
+  unsigned char* state = reader->states + reader->depth;
+  switch (*state) {
+    case JSON_STATE_ROOT:
+      if (c != '{' && c != '[')
+        json_reader_fail(reader, "'[' or '{' expected");
+      *state = JSON_STATE_DONE;
+      return json_reader_read_value(reader);
+    case JSON_STATE_DONE:
+      if (c != EOF)
+        json_reader_fail(reader, "end of file expected");
+      return JSON_EVENT_END;
+    case JSON_STATE_OBJECT_FIRST_KEY:
+      if (c == '}')
+        return json_reader_pop(reader, JSON_EVENT_OBJECT_END);
+      return json_reader_read_key(reader);
+    case JSON_STATE_OBJECT_KEY:
+      return json_reader_read_key(reader);
+    case JSON_STATE_OBJECT_COLON:
+      json_reader_expect(reader, ':', "':' expected");
+      json_reader_skip_whitespace(reader);
+      *state = JSON_STATE_OBJECT_AFTER_VALUE;
+      return json_reader_read_value(reader);
+    case JSON_STATE_OBJECT_AFTER_VALUE:
+      if (c == '}')
+        return json_reader_pop(reader, JSON_EVENT_OBJECT_END);
+      json_reader_expect(reader, ',', "',' or '}' expected");
+      json_reader_skip_whitespace(reader);
+      return json_reader_read_key(reader);
+    case JSON_STATE_ARRAY_FIRST_VALUE:
+      if (c == ']')
+        return json_reader_pop(reader, JSON_EVENT_ARRAY_END);
+      *state = JSON_STATE_ARRAY_AFTER_VALUE;
+      return json_reader_read_value(reader);
+    default:
+      if (c == ']')
+        return json_reader_pop(reader, JSON_EVENT_ARRAY_END);
+      json_reader_expect(reader, ',', "',' or ']' expected");
+      json_reader_skip_whitespace(reader);
+      return json_reader_read_value(reader);
+  }
+}
+
+void json_reader_skip(struct JsonReader* reader, enum JsonEvent event) {
+  if (event != JSON_EVENT_OBJECT_START && event != JSON_EVENT_ARRAY_START)
+    return;
+  unsigned int depth = reader->depth - 1;
+  while (reader->depth > depth)
+    json_reader_next(reader);
+}
+
+bool json_event_is_number(enum JsonEvent event) {
+  return event == JSON_EVENT_INTEGER || event == JSON_EVENT_REAL;
+}
+
+void json_reader_fail(const struct JsonReader* reader, const char* message) {
+  fprintf(stderr,
+          "Problem while loading JSON file: %s near line %u, column %u\n",
+          message,
+          reader->line,
+          reader->column);
+  exit(1);
+}
@@ -0,0 +1,115 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// The number of bytes read from the file at once
+#define JSON_READER_BUFFER_SIZE 65536
+// The maximum nesting of arrays and objects
+#define JSON_READER_MAX_DEPTH 64
+// The maximum length of a string or key
+#define JSON_READER_MAX_STRING_LENGTH 1023
+// The maximum length of the text of a number
+#define JSON_READER_MAX_NUMBER_LENGTH 63
+
+// Types
+// -----
+
+// The events produced while reading a JSON document
+enum JsonEvent {
+  JSON_EVENT_OBJECT_START,  // The start of an object
+  JSON_EVENT_OBJECT_END,    // The end of an object
+  JSON_EVENT_ARRAY_START,   // The start of an array
+  JSON_EVENT_ARRAY_END,     // The end of an array
+  JSON_EVENT_KEY,           // A key of an object, in `string`
+  JSON_EVENT_STRING,        // A string, in `string`
+  JSON_EVENT_INTEGER,       // An integer, in `integer` and `real`
+  JSON_EVENT_REAL,          // A real number, in `real`
+  JSON_EVENT_TRUE,          // The literal true
+  JSON_EVENT_FALSE,         // The literal false
+  JSON_EVENT_NULL,          // The literal null
+  JSON_EVENT_END            // The end of the document
+};
+
+// A streaming reader of JSON documents
+//
+// The document is read through a fixed-size buffer and reported as a
+// sequence of events, so that the memory used by the reader does not depend on
+// the size of the document. Syntax errors are reported on stderr, and exit the
+// program.
+struct JsonReader {
+  // The file from which the document is read
+  FILE* file;
+  // The bytes read from the file and not consumed yet
+  char buffer[JSON_READER_BUFFER_SIZE];
+  // The number of bytes in the buffer
+  size_t size;
+  // The position of the next byte in the buffer
+  size_t position;
+  // The line of the next byte, from 1
+  unsigned int line;
+  // The column of the next byte, from 1
+  unsigned int column;
+  // The number of arrays and objects containing the next event
+  unsigned int depth;
+  // The parsing state of the document and of each open array or object
+  unsigned char states[JSON_READER_MAX_DEPTH + 1];
+  // The content of the last string or key
+  char string[JSON_READER_MAX_STRING_LENGTH + 1];
+  // The value of the last integer
+  long long integer;
+  // The value of the last number
+  double real;
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes a reader at the start of a JSON document
+ *
+ * @param reader  The reader to initialize
+ * @param file    The file containing the document
+ */
+void json_reader_initialize(struct JsonReader* reader, FILE* file);
+
+// Reading
+// -------
+
+/**
+ * Reads the next event of a JSON document
+ *
+ * @param reader  The reader
+ * @return        The next event
+ */
+enum JsonEvent json_reader_next(struct JsonReader* reader);
+
+/**
+ * Skips the value starting with a given event
+ *
+ * If the event starts an array or an object, the events up to its end are
+ * consumed. Otherwise, nothing is read.
+ *
+ * @param reader  The reader
+ * @param event   The first event of the value
+ */
+void json_reader_skip(struct JsonReader* reader, enum JsonEvent event);
+
+/**
+ * Indicates if an event is a number
+ *
+ * @param event  The event
+ * @return       true if and only if the event is an integer or a real
+ */
+bool json_event_is_number(enum JsonEvent event);
+
+/**
+ * Reports a syntax error of a JSON document, and exits the program
+ *
+ * @param reader   The reader
+ * @param message  The description of the error
+ */
+void json_reader_fail(const struct JsonReader* reader, const char* message);
+
+#endif
@@ -0,0 +1,328 @@
+#include "json_writer.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utils/grisu.h"
+
+// The size of the text of a number, at most
+#define JSON_WRITER_NUMBER_SIZE 32
+
+// Help functions
+// --------------
+
+/**
+ * Writes bytes to the output of a writer, bypassing its buffer
+ *
+ * If writing fails, the writer is marked as failed and nothing more is
+ * written.
+ *
+ * @param writer  The writer
+ * @param bytes   The bytes
+ * @param size    The number of bytes
+ */
+void json_writer_output(struct JsonWriter* writer,
+                        const char* bytes,
+                        size_t size) {
+  if (writer->failed)
+    return;
+  if (writer->file != NULL) {
+    writer->failed = fwrite(bytes, 1, size, writer->file) < size;
+    return;
+  }
+  while (size > 0) {
+    ssize_t written = write(writer->fd, bytes, size);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0) {
+      writer->failed = true;
+      return;
+    }
+    bytes += written;
+    size -= written;
+  }
+}
+
+/**
+ * Writes bytes to the buffer of a writer
+ *
+ * @param writer  The writer
+ * @param bytes   The bytes
+ * @param size    The number of bytes
+ */
+void json_writer_append(struct JsonWriter* writer,
+                        const char* bytes,
+                        size_t size) {
+  if (writer->size + size > JSON_WRITER_BUFFER_SIZE) {
+    json_writer_flush(writer);
+    if (size > JSON_WRITER_BUFFER_SIZE) {
+      json_writer_output(writer, bytes, size);
+      return;
+    }
+  }
+  memcpy(writer->buffer + writer->size, bytes, size);
+  writer->size += size;
+}
+
+/**
+ * Writes a line break followed by the indentation of a given depth
+ *
+ * @param writer  The writer
+ * @param depth   The depth
+ */
+void json_writer_indent(struct JsonWriter* writer, unsigned int depth) {
+  if (writer->compact)
+    return;
+  static const char spaces[] = "\n                                ";
+  unsigned int num_spaces = depth * JSON_WRITER_INDENT;
+  json_writer_append(writer, spaces, 1);
+  while (num_spaces > 0) {
+    unsigned int n = num_spaces < sizeof(spaces) - 2 ?
+                     num_spaces :
+                     sizeof(spaces) - 2;
+    json_writer_append(writer, spaces + 1, n);
+    num_spaces -= n;
+  }
+}
+
+/**
+ * Writes what precedes a value or a key: a comma and an indentation
+ *
+ * @param writer  The writer
+ */
+void json_writer_separate(struct JsonWriter* writer) {
+  if (writer->after_key) {
+    writer->after_key = false;
+    return;
+  }
+  if (writer->depth == 0)
+    return;
+  if (writer->has_values[writer->depth])
+    json_writer_append(writer, ",", 1);
+  writer->has_values[writer->depth] = true;
+  json_writer_indent(writer, writer->depth);
+}
+
+/**
+ * Opens an array or an object
+ *
+ * @param writer     The writer
+ * @param delimiter  The opening delimiter
+ */
+void json_writer_open(struct JsonWriter* writer, char delimiter) {
+  json_writer_separate(writer);
+  json_writer_append(writer, &delimiter, 1);
+  ++writer->depth;
+  writer->has_values[writer->depth] = false;
+}
+
+/**
+ * Closes an array or an object
+ *
+ * @param writer     The writer
+ * @param delimiter  The closing delimiter
+ */
+void json_writer_close(struct JsonWriter* writer, char delimiter) {
+  --writer->depth;
+  if (writer->has_values[writer->depth + 1])
+    json_writer_indent(writer, writer->depth);
+  json_writer_append(writer, &delimiter, 1);
+}
+
+/**
+ * Writes a quoted and escaped string
+ *
+ * @param writer  The writer
+ * @param value   The string
+ */
+void json_writer_quote(struct JsonWriter* writer, const char* value) {
+  json_writer_append(writer, "\"", 1);
+  const char* start = value;
+  for (const char* c = value; *c != '\0'; ++c) {
+    unsigned char byte = *c;
+    if (byte >= 0x20 && byte != '"' && byte != '\\')
+      continue;
+    json_writer_append(writer, start, c - start);
+    start = c + 1;
+    char escape[8];
+    switch (byte) {
+      case '"': json_writer_append(writer, "\\\"", 2); break;
+      case '\\': json_writer_append(writer, "\\\\", 2); break;
+      case '\b': json_writer_append(writer, "\\b", 2); break;
+      case '\f': json_writer_append(writer, "\\f", 2); break;
+      case '\n': json_writer_append(writer, "\\n", 2); break;
+      case '\r': json_writer_append(writer, "\\r", 2); break;
+      case '\t': json_writer_append(writer, "\\t", 2); break;
+      default:
+        snprintf(escape, sizeof(escape), "\\u%04X", byte);
+        json_writer_append(writer, escape, 6);
+    }
+  }
+  json_writer_append(writer, start, strlen(start));
+  json_writer_append(writer, "\"", 1);
+}
+
+/**
+ * Formats a real with the shortest digits that read back to it
+ *
+ * The layout is the one of "%.17g", fixed up as for
+ * json_writer_format_precision.
+ *
+ * @param text   The buffer, of JSON_WRITER_NUMBER_SIZE characters
+ * @param value  The real, finite
+ * @return       The length of the text
+ */
+int json_writer_format_shortest(char* text, double value) {
+  int length = 0;
+  if (signbit(value)) {
+    text[length++] = '-';
+    value = -value;
+  }
+  if (value == 0.0) {
+    memcpy(text + length, "0.0", 3);
+    return length + 3;
+  }
+  char digits[GRISU_MAX_DIGITS];
+  int exponent;
+  int num_digits = grisu_digits(value, digits, &exponent);
+  // The decimal point is after the first point digits
+  int point = num_digits + exponent;
+  if (point - 1 < -4 || point - 1 >= JSON_WRITER_MAX_PRECISION) {
+    text[length++] = digits[0];
+    if (num_digits > 1) {
+      text[length++] = '.';
+      memcpy(text + length, digits + 1, num_digits - 1);
+      length += num_digits - 1;
+    }
+    length += sprintf(text + length, "e%d", point - 1);
+  } else if (point <= 0) {
+    memcpy(text + length, "0.", 2);
+    memset(text + length + 2, '0', -point);
+    length += 2 - point;
+    memcpy(text + length, digits, num_digits);
+    length += num_digits;
+  } else if (point < num_digits) {
+    memcpy(text + length, digits, point);
+    text[length + point] = '.';
+    memcpy(text + length + point + 1, digits + point, num_digits - point);
+    length += num_digits + 1;
+  } else {
+    memcpy(text + length, digits, num_digits);
+    memset(text + length + num_digits, '0', point - num_digits);
+    length += point;
+    memcpy(text + length, ".0", 2);
+    length += 2;
+  }
+  return length;
+}
+
+/**
+ * Formats a real with a given number of significant digits
+ *
+ * @param text       The buffer, of JSON_WRITER_NUMBER_SIZE characters
+ * @param value      The real, finite
+ * @param precision  The number of significant digits
+ * @return           The length of the text
+ */
+int json_writer_format_precision(char* text, double value, int precision) {
+  int length = snprintf(text, JSON_WRITER_NUMBER_SIZE, "%.*g",
+                        precision, value);
+  // As Jansson: a real always has a dot or an exponent, and its exponent has
+  // no sign "+" and no leading zero
+  char* exponent = strchr(text, 'e');
+  if (exponent == NULL && strchr(text, '.') == NULL) {
+    memcpy(text + length, ".0", 3);
+    length += 2;
+  } else if (exponent != NULL) {
+    char* digits = exponent + 1;
+    char* start = *digits == '-' ? digits + 1 : digits;
+    char* end = *digits == '+' || *digits == '-' ? digits + 1 : digits;
+    while (*end == '0' && end[1] != '\0')
+      ++end;
+    memmove(start, end, strlen(end) + 1);
+    length = strlen(text);
+  }
+  return length;
+}
+
+// Initialization
+// --------------
+
+void json_writer_initialize(struct JsonWriter* writer, FILE* file) {
+  writer->file = file;
+  writer->fd = -1;
+  writer->size = 0;
+  writer->depth = 0;
+  writer->has_values[0] = false;
+  writer->after_key = false;
+  writer->compact = false;
+  writer->precision = 0;
+  writer->failed = false;
+}
+
+void json_writer_initialize_fd(struct JsonWriter* writer, int fd) {
+  json_writer_initialize(writer, NULL);
+  writer->fd = fd;
+}
+
+void json_writer_set_layout(struct JsonWriter* writer,
+                            bool compact,
+                            int precision) {
+  writer->compact = compact;
+  writer->precision = precision;
+}
+
+// Writing
+// -------
+
+void json_writer_start_object(struct JsonWriter* writer) {
+  json_writer_open(writer, '{');
+}
+
+void json_writer_end_object(struct JsonWriter* writer) {
+  json_writer_close(writer, '}');
+}
+
+void json_writer_start_array(struct JsonWriter* writer) {
+  json_writer_open(writer, '[');
+}
+
+void json_writer_end_array(struct JsonWriter* writer) {
+  json_writer_close(writer, ']');
+}
+
+void json_writer_key(struct JsonWriter* writer, const char* key) {
+  json_writer_separate(writer);
+  json_writer_quote(writer, key);
+  json_writer_append(writer, ": ", writer->compact ? 1 : 2);
+  writer->after_key = true;
+}
+
+void json_writer_string(struct JsonWriter* writer, const char* value) {
+  json_writer_separate(writer);
+  json_writer_quote(writer, value);
+}
+
+void json_writer_integer(struct JsonWriter* writer, long long value) {
+  json_writer_separate(writer);
+  char text[JSON_WRITER_NUMBER_SIZE];
+  int length = snprintf(text, sizeof(text), "%lld", value);
+  json_writer_append(writer, text, length);
+}
+
+void json_writer_real(struct JsonWriter* writer, double value) {
+  json_writer_separate(writer);
+  char text[JSON_WRITER_NUMBER_SIZE];
+  int length = writer->precision == 0 ?
+               json_writer_format_shortest(text, value) :
+               json_writer_format_precision(text, value, writer->precision);
+  json_writer_append(writer, text, length);
+}
+
+void json_writer_flush(struct JsonWriter* writer) {
+  json_writer_output(writer, writer->buffer, writer->size);
+  writer->size = 0;
+}
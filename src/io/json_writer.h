@@ -0,0 +1,158 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// The number of bytes buffered before being written to the output
+#define JSON_WRITER_BUFFER_SIZE 65536
+// The maximum nesting of arrays and objects
+#define JSON_WRITER_MAX_DEPTH 64
+// The number of spaces per level of indentation
+#define JSON_WRITER_INDENT 2
+// The largest number of significant digits of reals
+#define JSON_WRITER_MAX_PRECISION 17
+
+// Types
+// -----
+
+// A streaming writer of JSON documents
+//
+// Values are written as they are given, through a fixed-size buffer, so that
+// the memory used by the writer does not depend on the size of the document.
+// The layout is the same as json_dumpf with JSON_INDENT(JSON_WRITER_INDENT):
+// each element and key on its own line, ": " after keys, empty containers as
+// "[]" or "{}". A compact writer has the layout of JSON_COMPACT instead, with
+// no whitespace at all.
+//
+// By default, reals are written with the shortest digits that read back to
+// the same double, computed by grisu_digits. With a given precision, they are
+// written as json_dumpf does with JSON_REAL_PRECISION(precision).
+struct JsonWriter {
+  // The file to which the document is written, or NULL for a descriptor
+  FILE* file;
+  // The file descriptor to which the document is written, if no file
+  int fd;
+  // The bytes not written to the output yet
+  char buffer[JSON_WRITER_BUFFER_SIZE];
+  // The number of bytes in the buffer
+  size_t size;
+  // The number of arrays and objects containing the next value
+  unsigned int depth;
+  // Whether each open array or object has a value already
+  bool has_values[JSON_WRITER_MAX_DEPTH + 1];
+  // Whether the next value follows a key
+  bool after_key;
+  // Whether the document is written without whitespace
+  bool compact;
+  // The number of significant digits of reals, or 0 for the shortest digits
+  int precision;
+  // Whether writing to the output failed, after which nothing is written
+  bool failed;
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes a writer to a file
+ *
+ * @param writer  The writer to initialize
+ * @param file    The file to which the document is written
+ */
+void json_writer_initialize(struct JsonWriter* writer, FILE* file);
+
+/**
+ * Initializes a writer to a file descriptor
+ *
+ * @param writer  The writer to initialize
+ * @param fd      The file descriptor to which the document is written
+ */
+void json_writer_initialize_fd(struct JsonWriter* writer, int fd);
+
+/**
+ * Sets the layout of a writer, before anything is written
+ *
+ * @param writer     The writer
+ * @param compact    Whether the document is written without whitespace
+ * @param precision  The number of significant digits of reals, between 1 and
+ *                   JSON_WRITER_MAX_PRECISION, or 0 for the shortest digits
+ *                   that read back to the same reals
+ */
+void json_writer_set_layout(struct JsonWriter* writer,
+                            bool compact,
+                            int precision);
+
+// Writing
+// -------
+
+/**
+ * Starts an object
+ *
+ * @param writer  The writer
+ */
+void json_writer_start_object(struct JsonWriter* writer);
+
+/**
+ * Ends the current object
+ *
+ * @param writer  The writer
+ */
+void json_writer_end_object(struct JsonWriter* writer);
+
+/**
+ * Starts an array
+ *
+ * @param writer  The writer
+ */
+void json_writer_start_array(struct JsonWriter* writer);
+
+/**
+ * Ends the current array
+ *
+ * @param writer  The writer
+ */
+void json_writer_end_array(struct JsonWriter* writer);
+
+/**
+ * Writes a key of the current object
+ *
+ * @param writer  The writer
+ * @param key     The key
+ */
+void json_writer_key(struct JsonWriter* writer, const char* key);
+
+/**
+ * Writes a string
+ *
+ * @param writer  The writer
+ * @param value   The string, in UTF-8
+ */
+void json_writer_string(struct JsonWriter* writer, const char* value);
+
+/**
+ * Writes an integer
+ *
+ * @param writer  The writer
+ * @param value   The integer
+ */
+void json_writer_integer(struct JsonWriter* writer, long long value);
+
+/**
+ * Writes a real number
+ *
+ * @param writer  The writer
+ * @param value   The real number, which must be finite
+ */
+void json_writer_real(struct JsonWriter* writer, double value);
+
+/**
+ * Writes the buffered bytes to the output
+ *
+ * If writing fails, the writer is marked as failed.
+ *
+ * @param writer  The writer
+ */
+void json_writer_flush(struct JsonWriter* writer);
+
+#endif
@@ -0,0 +1,417 @@
+#include "snapshot.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "timeline.h"
+#include "unit.h"
+#include "utils/symbol_index.h"
+#include "validation.h"
+
+// Help functions
+// --------------
+
+/**
+ * Returns the smallest multiple of SERIES_ALIGNMENT not less than an offset
+ *
+ * @param offset  The offset
+ * @return        The aligned offset
+ */
+uint64_t snapshot_align(uint64_t offset) {
+  return (offset + SERIES_ALIGNMENT - 1) / SERIES_ALIGNMENT * SERIES_ALIGNMENT;
+}
+
+/**
+ * Writes zero bytes to a snapshot up to an offset
+ *
+ * @param file      The file of the snapshot
+ * @param position  The number of bytes written so far, updated
+ * @param offset    The offset up to which zeros are written
+ */
+void snapshot_write_padding(FILE* file, uint64_t* position, uint64_t offset) {
+  for (; *position < offset; ++*position)
+    fputc(0, file);
+}
+
+/**
+ * Writes a section of a snapshot
+ *
+ * @param file      The file of the snapshot
+ * @param position  The number of bytes written so far, updated
+ * @param data      The content of the section
+ * @param size      The size of the section
+ */
+void snapshot_write(FILE* file,
+                    uint64_t* position,
+                    const void* data,
+                    size_t size) {
+  if (size > 0)
+    fwrite(data, 1, size, file);
+  *position += size;
+}
+
+/**
+ * Writes the rows of a series matrix of a snapshot
+ *
+ * The series of a scenario may not be stored contiguously, so the rows are
+ * gathered one at a time.
+ *
+ * @param file           The file of the snapshot
+ * @param position       The number of bytes written so far, updated
+ * @param series         The series of each row
+ * @param num_rows       The number of rows
+ * @param num_timesteps  The number of values of a series
+ * @param stride         The number of values of a row
+ */
+void snapshot_write_matrix(FILE* file,
+                           uint64_t* position,
+                           stored_mw* const* series,
+                           unsigned int num_rows,
+                           unsigned int num_timesteps,
+                           unsigned int stride) {
+  for (unsigned int r = 0; r < num_rows; ++r) {
+    uint64_t row_end = *position + (uint64_t)stride * sizeof(stored_mw);
+    snapshot_write(file,
+                   position,
+                   series[r],
+                   num_timesteps * sizeof(stored_mw));
+    snapshot_write_padding(file, position, row_end);
+  }
+}
+
+/**
+ * Returns the index of an identifier in the table of a snapshot being written
+ *
+ * @param index   The index of the table by symbol
+ * @param ids     The table, grown if the identifier is new
+ * @param num_ids The number of entries of the table, updated
+ * @param symbol  The symbol of the identifier
+ * @param id      The identifier
+ * @return        The index of the identifier in the table
+ */
+uint32_t snapshot_intern_id(struct SymbolIndex* index,
+                            char (**ids)[SNAPSHOT_ID_SIZE],
+                            uint32_t* num_ids,
+                            unsigned int symbol,
+                            const char* id) {
+  uint32_t i = symbol_index_insert(index, symbol, *num_ids);
+  if (i == *num_ids) {
+    *ids = realloc(*ids, (*num_ids + 1) * sizeof(**ids));
+    memset((*ids)[i], 0, SNAPSHOT_ID_SIZE);
+    strncpy((*ids)[i], id, ID_MAX_LENGTH);
+    ++*num_ids;
+  }
+  return i;
+}
+
+/**
+ * Indicates if a section of a snapshot lies in the snapshot
+ *
+ * @param snapshot   The snapshot
+ * @param offset     The offset of the section
+ * @param count      The number of items of the section
+ * @param item_size  The size of an item
+ * @return           true if and only if the section is aligned and in bounds
+ */
+bool snapshot_has_section(const struct Snapshot* snapshot,
+                          uint64_t offset,
+                          uint64_t count,
+                          uint64_t item_size) {
+  return offset % SERIES_ALIGNMENT == 0 &&
+         offset <= snapshot->size &&
+         (count == 0 || item_size <= (snapshot->size - offset) / count);
+}
+
+/**
+ * Returns the identifier at a given index of the table of a snapshot
+ *
+ * If the index or the entry is invalid, prints an error message and exits the
+ * program.
+ *
+ * @param snapshot  The snapshot
+ * @param i         The index of the identifier
+ * @return          The identifier
+ */
+const char* snapshot_id(const struct Snapshot* snapshot, uint32_t i) {
+  const struct SnapshotHeader* header = snapshot->data;
+  ensure_snapshot_is_valid(i < header->num_ids,
+                           "identifier index out of the table");
+  const char* id = (const char*)snapshot->data + header->ids_offset +
+                   (size_t)i * SNAPSHOT_ID_SIZE;
+  ensure_snapshot_is_valid(id[ID_MAX_LENGTH] == '\0',
+                           "identifier is not terminated");
+  return id;
+}
+
+/**
+ * Returns the index of a zone referenced in a snapshot
+ *
+ * If the zone does not exist, prints an error message and exits the program.
+ *
+ * @param snapshot  The snapshot
+ * @param zone      The index of the zone
+ * @return          The index of the zone
+ */
+unsigned int snapshot_zone(const struct Snapshot* snapshot, uint32_t zone) {
+  const struct SnapshotHeader* header = snapshot->data;
+  ensure_snapshot_is_valid(zone < header->num_zones,
+                           "zone index out of the zone table");
+  return zone;
+}
+
+/**
+ * Ensures that the header of a mapped snapshot is valid
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param snapshot  The snapshot
+ */
+void snapshot_validate_header(const struct Snapshot* snapshot) {
+  const struct SnapshotHeader* header = snapshot->data;
+  ensure_snapshot_is_valid(
+    snapshot->size >= sizeof(struct SnapshotHeader) &&
+    memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0,
+    "not a snapshot file");
+  ensure_snapshot_is_valid(header->version == SNAPSHOT_VERSION,
+                           "unsupported version");
+  ensure_snapshot_is_valid(header->byte_order == SNAPSHOT_BYTE_ORDER,
+                           "written with another byte order");
+  ensure_snapshot_is_valid(header->mw_storage == MW_STORAGE &&
+                           header->series_alignment == SERIES_ALIGNMENT,
+                           "written with another storage of time series");
+  ensure_snapshot_is_valid(header->size == snapshot->size,
+                           "unexpected size, the file may be truncated");
+  uint64_t row_size = (uint64_t)header->series_stride * sizeof(stored_mw);
+  ensure_snapshot_is_valid(
+    header->series_stride >= header->num_timesteps &&
+    snapshot_has_section(snapshot,
+                         header->durations_offset,
+                         header->num_timesteps,
+                         sizeof(int32_t)) &&
+    snapshot_has_section(snapshot,
+                         header->ids_offset,
+                         header->num_ids,
+                         SNAPSHOT_ID_SIZE) &&
+    snapshot_has_section(snapshot,
+                         header->zones_offset,
+                         header->num_zones,
+                         sizeof(uint32_t)) &&
+    snapshot_has_section(snapshot,
+                         header->links_offset,
+                         header->num_links,
+                         3 * sizeof(uint32_t)) &&
+    snapshot_has_section(snapshot,
+                         header->plants_offset,
+                         header->num_plants,
+                         2 * sizeof(uint32_t)) &&
+    snapshot_has_section(snapshot,
+                         header->expected_demands_offset,
+                         header->num_zones,
+                         row_size) &&
+    snapshot_has_section(snapshot,
+                         header->min_powers_offset,
+                         header->num_plants,
+                         row_size) &&
+    snapshot_has_section(snapshot,
+                         header->max_powers_offset,
+                         header->num_plants,
+                         row_size),
+    "section out of the file");
+}
+
+// Writing
+// -------
+
+void scenario_write_snapshot(const struct Scenario* scenario, FILE* file) {
+  const struct Timeline* timeline = scenario->timeline;
+  unsigned int num_timesteps = timeline->num_future_timesteps;
+  unsigned int stride = scenario->series_stride;
+  uint64_t row_size = (uint64_t)stride * sizeof(stored_mw);
+
+  struct SymbolIndex index;
+  symbol_index_initialize(&index, NULL);
+  char (*ids)[SNAPSHOT_ID_SIZE] = NULL;
+  uint32_t num_ids = 0;
+  uint32_t* zones = malloc((scenario->num_zones + 1) * sizeof(uint32_t));
+  uint32_t* links = malloc((3 * scenario->num_links + 1) * sizeof(uint32_t));
+  uint32_t* plants = malloc((2 * scenario->num_plants + 1) * sizeof(uint32_t));
+  stored_mw** series = malloc((2 * scenario->num_plants +
+                               scenario->num_zones + 1) * sizeof(stored_mw*));
+  for (unsigned int z = 0; z < scenario->num_zones; ++z) {
+    const struct Zone* zone = scenario->zones + z;
+    zones[z] = snapshot_intern_id(&index, &ids, &num_ids, zone->symbol,
+                                  zone->id);
+    series[z] = zone->expected_demands;
+  }
+  for (unsigned int l = 0; l < scenario->num_links; ++l) {
+    const struct Link* link = scenario->links + l;
+    links[3 * l] = snapshot_intern_id(&index, &ids, &num_ids, link->symbol,
+                                      link->id);
+    links[3 * l + 1] = link->source;
+    links[3 * l + 2] = link->target;
+  }
+  stored_mw** min_powers = series + scenario->num_zones;
+  stored_mw** max_powers = min_powers + scenario->num_plants;
+  for (unsigned int p = 0; p < scenario->num_plants; ++p) {
+    const struct Plant* plant = scenario->plants + p;
+    plants[2 * p] = snapshot_intern_id(&index, &ids, &num_ids, plant->symbol,
+                                       plant->id);
+    plants[2 * p + 1] = plant->zone;
+    min_powers[p] = plant->min_powers;
+    max_powers[p] = plant->max_powers;
+  }
+
+  struct SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  header.version = SNAPSHOT_VERSION;
+  header.byte_order = SNAPSHOT_BYTE_ORDER;
+  header.mw_storage = MW_STORAGE;
+  header.series_alignment = SERIES_ALIGNMENT;
+  header.num_timesteps = num_timesteps;
+  header.series_stride = stride;
+  header.num_ids = num_ids;
+  header.num_zones = scenario->num_zones;
+  header.num_links = scenario->num_links;
+  header.num_plants = scenario->num_plants;
+  header.durations_offset = snapshot_align(sizeof(header));
+  header.ids_offset = snapshot_align(header.durations_offset +
+                                     num_timesteps * sizeof(int32_t));
+  header.zones_offset = snapshot_align(header.ids_offset +
+                                       (uint64_t)num_ids * SNAPSHOT_ID_SIZE);
+  header.links_offset = snapshot_align(header.zones_offset +
+                                       header.num_zones * sizeof(uint32_t));
+  header.plants_offset =
+    snapshot_align(header.links_offset +
+                   (uint64_t)header.num_links * 3 * sizeof(uint32_t));
+  header.expected_demands_offset =
+    snapshot_align(header.plants_offset +
+                   (uint64_t)header.num_plants * 2 * sizeof(uint32_t));
+  header.min_powers_offset = header.expected_demands_offset +
+                             header.num_zones * row_size;
+  header.max_powers_offset = header.min_powers_offset +
+                             header.num_plants * row_size;
+  header.size = header.max_powers_offset + header.num_plants * row_size;
+
+  uint64_t position = 0;
+  snapshot_write(file, &position, &header, sizeof(header));
+  snapshot_write_padding(file, &position, header.durations_offset);
+  for (unsigned int t = 0; t < num_timesteps; ++t) {
+    int32_t duration = timeline->future_durations[t];
+    snapshot_write(file, &position, &duration, sizeof(duration));
+  }
+  snapshot_write_padding(file, &position, header.ids_offset);
+  snapshot_write(file, &position, ids, (size_t)num_ids * SNAPSHOT_ID_SIZE);
+  snapshot_write_padding(file, &position, header.zones_offset);
+  snapshot_write(file, &position, zones, header.num_zones * sizeof(uint32_t));
+  snapshot_write_padding(file, &position, header.links_offset);
+  snapshot_write(file,
+                 &position,
+                 links,
+                 (size_t)header.num_links * 3 * sizeof(uint32_t));
+  snapshot_write_padding(file, &position, header.plants_offset);
+  snapshot_write(file,
+                 &position,
+                 plants,
+                 (size_t)header.num_plants * 2 * sizeof(uint32_t));
+  snapshot_write_padding(file, &position, header.expected_demands_offset);
+  snapshot_write_matrix(file, &position, series, header.num_zones,
+                        num_timesteps, stride);
+  snapshot_write_matrix(file, &position, min_powers, header.num_plants,
+                        num_timesteps, stride);
+  snapshot_write_matrix(file, &position, max_powers, header.num_plants,
+                        num_timesteps, stride);
+
+  free(series);
+  free(plants);
+  free(links);
+  free(zones);
+  free(ids);
+  symbol_index_delete(&index);
+}
+
+// Reading
+// -------
+
+bool snapshot_file_is_snapshot(FILE* file) {
+  // Only regular files can be mapped, and probed without losing bytes
+  struct stat status;
+  if (fstat(fileno(file), &status) != 0 || !S_ISREG(status.st_mode))
+    return false;
+  char magic[sizeof(SNAPSHOT_MAGIC)];
+  long position = ftell(file);
+  bool is_snapshot = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                     memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+  fseek(file, position, SEEK_SET);
+  return is_snapshot;
+}
+
+void snapshot_open(struct Snapshot* snapshot, const char* filename) {
+  int fd = open(filename, O_RDONLY);
+  ensure_snapshot_is_valid(fd >= 0, strerror(errno));
+  struct stat status;
+  ensure_snapshot_is_valid(fstat(fd, &status) == 0, strerror(errno));
+  ensure_snapshot_is_valid(status.st_size >= sizeof(struct SnapshotHeader),
+                           "truncated header");
+  snapshot->size = status.st_size;
+  snapshot->data = mmap(NULL,
+                        snapshot->size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE,
+                        fd,
+                        0);
+  ensure_snapshot_is_valid(snapshot->data != MAP_FAILED, strerror(errno));
+  close(fd);
+  snapshot_validate_header(snapshot);
+}
+
+void snapshot_close(struct Snapshot* snapshot) {
+  munmap(snapshot->data, snapshot->size);
+}
+
+void scenario_from_snapshot(struct Scenario* scenario,
+                            const struct Snapshot* snapshot) {
+  const struct SnapshotHeader* header = snapshot->data;
+  const char* data = snapshot->data;
+  const int32_t* durations = (const int32_t*)(data + header->durations_offset);
+  int* future_durations = malloc((header->num_timesteps + 1) * sizeof(int));
+  for (unsigned int t = 0; t < header->num_timesteps; ++t)
+    future_durations[t] = durations[t];
+  const struct Timeline* timeline = timeline_create(header->num_timesteps,
+                                                    future_durations);
+  free(future_durations);
+  scenario_initialize_with_series(
+    scenario,
+    timeline,
+    header->num_plants,
+    header->num_zones,
+    (const stored_mw*)(data + header->min_powers_offset),
+    (const stored_mw*)(data + header->max_powers_offset),
+    (const stored_mw*)(data + header->expected_demands_offset));
+  timeline_release(timeline);
+  ensure_snapshot_is_valid(header->series_stride == scenario->series_stride,
+                           "written with another storage of time series");
+  scenario_reserve(scenario,
+                   header->num_links,
+                   header->num_plants,
+                   header->num_zones);
+  const uint32_t* zones = (const uint32_t*)(data + header->zones_offset);
+  for (unsigned int z = 0; z < header->num_zones; ++z)
+    scenario_emplace_zone(scenario, snapshot_id(snapshot, zones[z]));
+  const uint32_t* links = (const uint32_t*)(data + header->links_offset);
+  for (unsigned int l = 0; l < header->num_links; ++l)
+    scenario_emplace_link(scenario,
+                          snapshot_id(snapshot, links[3 * l]),
+                          snapshot_zone(snapshot, links[3 * l + 1]),
+                          snapshot_zone(snapshot, links[3 * l + 2]));
+  const uint32_t* plants = (const uint32_t*)(data + header->plants_offset);
+  for (unsigned int p = 0; p < header->num_plants; ++p)
+    scenario_emplace_plant(scenario,
+                           snapshot_id(snapshot, plants[2 * p]),
+                           snapshot_zone(snapshot, plants[2 * p + 1]));
+}
@@ -0,0 +1,156 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "scenario.h"
+
+// The extension of snapshot files
+#define SNAPSHOT_EXTENSION ".simprod"
+// The first bytes of a snapshot file
+#define SNAPSHOT_MAGIC "SIMPROD"
+// The version of the snapshot format
+#define SNAPSHOT_VERSION 1
+// A word whose bytes reveal the byte order of the machine writing a snapshot
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+// The size of an entry of the identifier table
+#define SNAPSHOT_ID_SIZE (ID_MAX_LENGTH + 1)
+
+// Types
+// -----
+
+// The header of a binary snapshot of a scenario (`.simprod` file)
+//
+// The header is followed by sections whose offsets, from the start of the
+// file, are multiples of SERIES_ALIGNMENT:
+//
+// - the duration of each future timestep, as int32_t;
+// - the identifier table, with one zero-padded entry of SNAPSHOT_ID_SIZE
+//   bytes per distinct identifier;
+// - the zones, as the index of their identifier in the table;
+// - the links, as triples (identifier, source zone, target zone);
+// - the plants, as pairs (identifier, zone);
+// - the expected demand, minimum power and maximum power matrices, laid out
+//   as the matrices of a scenario, with `series_stride` values per row.
+//
+// Integers are uint32_t unless stated otherwise, and all values use the byte
+// order and the storage of the time series of the writing machine, so that a
+// snapshot is mapped in memory and used in place, without any conversion.
+struct SnapshotHeader {
+  // SNAPSHOT_MAGIC, zero-padded
+  char magic[8];
+  // SNAPSHOT_VERSION
+  uint32_t version;
+  // SNAPSHOT_BYTE_ORDER
+  uint32_t byte_order;
+  // The storage of the time series (MW_STORAGE)
+  uint32_t mw_storage;
+  // The alignment of the series matrices (SERIES_ALIGNMENT)
+  uint32_t series_alignment;
+  // The number of future timesteps
+  uint32_t num_timesteps;
+  // The number of values between the starts of two rows of a matrix
+  uint32_t series_stride;
+  // The number of entries of the identifier table
+  uint32_t num_ids;
+  // The number of zones
+  uint32_t num_zones;
+  // The number of links
+  uint32_t num_links;
+  // The number of plants
+  uint32_t num_plants;
+  // The offset of the durations
+  uint64_t durations_offset;
+  // The offset of the identifier table
+  uint64_t ids_offset;
+  // The offset of the zones
+  uint64_t zones_offset;
+  // The offset of the links
+  uint64_t links_offset;
+  // The offset of the plants
+  uint64_t plants_offset;
+  // The offset of the expected demand matrix
+  uint64_t expected_demands_offset;
+  // The offset of the minimum power matrix
+  uint64_t min_powers_offset;
+  // The offset of the maximum power matrix
+  uint64_t max_powers_offset;
+  // The size of the file
+  uint64_t size;
+};
+
+// A snapshot file mapped in memory
+//
+// The mapping is private: writing to it never modifies the file.
+struct Snapshot {
+  // The content of the file
+  void* data;
+  // The size of the file
+  size_t size;
+};
+
+// Writing
+// -------
+
+/**
+ * Writes a binary snapshot of a scenario
+ *
+ * Write errors are left in the error indicator of the file.
+ *
+ * @param scenario  The scenario
+ * @param file      The file to which the snapshot is written
+ */
+void scenario_write_snapshot(const struct Scenario* scenario, FILE* file);
+
+// Reading
+// -------
+
+/**
+ * Indicates if a file starts as a snapshot
+ *
+ * Only regular files are probed, and their position is restored. Nothing is
+ * read from other files, such as pipes, which are never snapshots.
+ *
+ * @param file  The file
+ * @return      true if and only if the file starts with SNAPSHOT_MAGIC
+ */
+bool snapshot_file_is_snapshot(FILE* file);
+
+/**
+ * Maps a snapshot file in memory
+ *
+ * If the file cannot be mapped or its header is invalid, prints an error
+ * message and exits the program.
+ *
+ * @param snapshot  The snapshot to open
+ * @param filename  The path of the file
+ */
+void snapshot_open(struct Snapshot* snapshot, const char* filename);
+
+/**
+ * Closes a snapshot
+ *
+ * The scenarios initialized from the snapshot must be freed before.
+ *
+ * @param snapshot  The snapshot to close
+ */
+void snapshot_close(struct Snapshot* snapshot);
+
+/**
+ * Initializes a scenario from a snapshot
+ *
+ * The series of the scenario are views into the snapshot, which must outlive
+ * the scenario. They are only copied when first modified through
+ * scenario_modify_*.
+ *
+ * @param scenario  The scenario to initialize
+ * @param snapshot  The snapshot
+ */
+void scenario_from_snapshot(struct Scenario* scenario,
+                            const struct Snapshot* snapshot);
+
+#endif
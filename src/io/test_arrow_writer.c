@@ -0,0 +1,193 @@
+#include "arrow_writer.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tap.h>
+
+#include "examples.h"
+
+// Help functions
+// --------------
+
+/**
+ * Reads a little-endian unsigned integer
+ *
+ * @param bytes  The bytes of the integer
+ * @param size   The number of bytes
+ * @return       The integer
+ */
+uint64_t read_integer(const unsigned char* bytes, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = size; i > 0; --i)
+    value = value << 8 | bytes[i - 1];
+  return value;
+}
+
+/**
+ * Returns the length of the body of a message
+ *
+ * @param metadata  The metadata of the message
+ * @return          The length of the body
+ */
+uint64_t read_body_length(const unsigned char* metadata) {
+  const unsigned char* table = metadata + read_integer(metadata, 4);
+  const unsigned char* vtable = table - (int32_t)read_integer(table, 4);
+  return read_integer(table + read_integer(vtable + 4 + 2 * 3, 2), 8);
+}
+
+/**
+ * Writes a plan as an Arrow stream in memory
+ *
+ * @param plan  The plan
+ * @param size  The size of the stream, set by the function
+ * @return      The stream, to be freed
+ */
+unsigned char* write_stream(const struct Plan* plan, size_t* size) {
+  char* stream;
+  FILE* file = open_memstream(&stream, size);
+  plan_write_arrow(plan, file);
+  fclose(file);
+  return (unsigned char*)stream;
+}
+
+/**
+ * Returns the number of messages of a stream, checking their framing
+ *
+ * @param stream        The stream
+ * @param size          The size of the stream
+ * @param bodies        The start of the body of each message, set by the
+ *                      function for the first messages
+ * @param max_messages  The number of bodies that can be set
+ * @return              The number of messages, or -1 if the framing is
+ *                      invalid
+ */
+int count_messages(const unsigned char* stream,
+                   size_t size,
+                   size_t* bodies,
+                   int max_messages) {
+  int num_messages = 0;
+  size_t position = 0;
+  while (position + 8 <= size) {
+    if (read_integer(stream + position, 4) != 0xFFFFFFFFu)
+      return -1;
+    uint64_t metadata_length = read_integer(stream + position + 4, 4);
+    if (metadata_length == 0)
+      return position + 8 == size ? num_messages : -1;
+    if (metadata_length % ARROW_ALIGNMENT != 0)
+      return -1;
+    const unsigned char* metadata = stream + position + 8;
+    position += 8 + metadata_length;
+    if (num_messages < max_messages)
+      bodies[num_messages] = position;
+    position += read_body_length(metadata);
+    ++num_messages;
+  }
+  return -1;
+}
+
+// Tests
+// -----
+
+/**
+ * Tests writing a plan as an Arrow stream
+ */
+void test_plan_write_arrow(void) {
+  diag("Writing a plan as an Arrow stream");
+
+  // Setup
+  struct TwoPlantsPlanExample example;
+  two_plants_plan_example_initialize(&example);
+  size_t size;
+  unsigned char* stream = write_stream(&example.plan, &size);
+  size_t bodies[3];
+  int num_messages = count_messages(stream, size, bodies, 3);
+
+  // Checks
+  cmp_ok(num_messages, "==", 3,
+         "stream has a schema, a dictionary and a record batch");
+  ok(memcmp(stream + bodies[1] + 16, "P1P2", 4) == 0,
+     "dictionary holds the plant identifiers sorted");
+  // The columns have 6 rows, hence 24 bytes, or 48 for productions
+  const unsigned char* batch = stream + bodies[2];
+  cmp_ok(read_integer(batch + 24, 4), "==", 10,
+         "durations follow the timesteps");
+  cmp_ok(read_integer(batch + 48 + 3 * 4, 4), "==", 1,
+         "plant indices follow the plants");
+  double productions[6];
+  memcpy(productions, batch + 72, sizeof(productions));
+  ok(productions[0] == 10.0 && productions[2] == 8.0,
+     "productions of the first plant come first");
+  ok(productions[3] == 0.0 && productions[5] == 3.0,
+     "productions of the second plant come last");
+
+  // Teardown
+  free(stream);
+  two_plants_plan_example_free(&example);
+}
+
+/**
+ * Tests writing an empty plan as an Arrow stream
+ */
+void test_plan_write_arrow_empty(void) {
+  diag("Writing an empty plan as an Arrow stream");
+
+  // Setup
+  struct Plan plan;
+  const struct Timeline* timeline = timeline_create(0, NULL);
+  plan_initialize(&plan, timeline);
+  timeline_release(timeline);
+  size_t size;
+  unsigned char* stream = write_stream(&plan, &size);
+
+  // Checks
+  cmp_ok(count_messages(stream, size, NULL, 0), "==", 2,
+         "stream has only a schema and a dictionary");
+
+  // Teardown
+  free(stream);
+  plan_free(&plan);
+}
+
+/**
+ * Tests that record batches are bounded
+ */
+void test_plan_write_arrow_batches(void) {
+  diag("Bounding the record batches of an Arrow stream");
+
+  // Setup
+  unsigned int num_timesteps = ARROW_BATCH_MAX_ROWS / 2 + 1;
+  int* durations = malloc(num_timesteps * sizeof(int));
+  for (unsigned int t = 0; t < num_timesteps; ++t)
+    durations[t] = 60;
+  const struct Timeline* timeline = timeline_create(num_timesteps, durations);
+  free(durations);
+  struct Plan plan;
+  plan_initialize(&plan, timeline);
+  timeline_release(timeline);
+  plan_set_production(&plan, 0, "P1", 1.0);
+  plan_set_production(&plan, 0, "P2", 2.0);
+  plan_set_production(&plan, 0, "P3", 3.0);
+  size_t size;
+  unsigned char* stream = write_stream(&plan, &size);
+
+  // Checks
+  cmp_ok(count_messages(stream, size, NULL, 0), "==", 5,
+         "each plant has its own record batch");
+
+  // Teardown
+  free(stream);
+  plan_free(&plan);
+}
+
+// Main
+// ----
+
+int main(void) {
+  test_plan_write_arrow();
+  test_plan_write_arrow_empty();
+  test_plan_write_arrow_batches();
+  done_testing();
+}
@@ -0,0 +1,120 @@
+#include "binary_plan.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <tap.h>
+
+#include "examples.h"
+
+// Help functions
+// --------------
+
+/**
+ * Opens a temporary file with a name
+ *
+ * @param filename  The template of the name, replaced by the name
+ * @return          The file, opened for writing
+ */
+FILE* open_temporary_file(char* filename) {
+  return fdopen(mkstemp(filename), "w+b");
+}
+
+// Tests
+// -----
+
+/**
+ * Tests writing a binary plan and reading it back
+ */
+void test_binary_plan(void) {
+  diag("Writing a binary plan and reading it back");
+
+  // Setup
+  struct TwoPlantsPlanExample example;
+  two_plants_plan_example_initialize(&example);
+  struct Plan* plan = &example.plan;
+  struct Plan binary_plan;
+  char filename[] = "test_binary_plan_XXXXXX";
+  FILE* file = open_temporary_file(filename);
+  plan_write_binary(plan, file);
+  fflush(file);
+  rewind(file);
+  plan_read_binary(&binary_plan, filename);
+
+  // Checks
+  ok(plan_file_is_binary(file), "written file is a binary plan");
+  ok(plan_are_equal(plan, &binary_plan),
+     "binary plan is equal to the original one");
+  cmp_ok(binary_plan.plant_symbols[0], "==", plan->plant_symbols[0],
+         "plants keep their order");
+  unsigned char bytes[BINARY_PLAN_HEADER_SIZE];
+  fread(bytes, 1, sizeof(bytes), file);
+  cmp_ok(bytes[12], "==", 3, "number of timesteps is little-endian");
+  fseek(file, 0, SEEK_END);
+  cmp_ok(ftell(file), "==", 128 + 2 * 3 * 8,
+         "production matrix is aligned and ends the file");
+
+  // Teardown
+  fclose(file);
+  remove(filename);
+  two_plants_plan_example_free(&example);
+  plan_free(&binary_plan);
+}
+
+/**
+ * Tests converting JSON plans to binary plans as streams
+ */
+void test_plan_convert_json_to_binary(void) {
+  diag("Converting JSON plans to binary plans");
+
+  // Setup
+  struct TwoPlantsPlanExample example;
+  two_plants_plan_example_initialize(&example);
+  struct Plan* plan = &example.plan;
+  struct Plan binary_plan1, binary_plan2;
+  FILE* input1 = tmpfile();
+  json_t* j = plan_to_json(plan);
+  json_dumpf(j, input1, JSON_INDENT(2));
+  json_decref(j);
+  rewind(input1);
+  FILE* input2 = tmpfile();
+  fputs("{\"timeline\": {\"future-durations\": [10, 30, 60]},\n"
+        " \"productions\": {\"P2\": [9, 9, 9], \"P1\": [10, 9, 8],\n"
+        "                   \"P2\": [0, 1.5, 3]}}", input2);
+  rewind(input2);
+  char filename1[] = "test_binary_plan_XXXXXX";
+  char filename2[] = "test_binary_plan_XXXXXX";
+  FILE* output1 = open_temporary_file(filename1);
+  FILE* output2 = open_temporary_file(filename2);
+  plan_convert_json_to_binary(input1, output1);
+  plan_convert_json_to_binary(input2, output2);
+  fclose(output1);
+  fclose(output2);
+  plan_read_binary(&binary_plan1, filename1);
+  plan_read_binary(&binary_plan2, filename2);
+
+  // Checks
+  ok(plan_are_equal(plan, &binary_plan1),
+     "converted plan with the timeline last is equal to the original one");
+  ok(plan_are_equal(plan, &binary_plan2),
+     "converted plan with a repeated plant keeps its last productions");
+
+  // Teardown
+  fclose(input1);
+  fclose(input2);
+  remove(filename1);
+  remove(filename2);
+  two_plants_plan_example_free(&example);
+  plan_free(&binary_plan1);
+  plan_free(&binary_plan2);
+}
+
+// Main
+// ----
+
+int main(void) {
+  test_binary_plan();
+  test_plan_convert_json_to_binary();
+  done_testing();
+}
@@ -0,0 +1,116 @@
+#include "csv_input.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <tap.h>
+
+#include "examples.h"
+
+// Help functions
+// --------------
+
+/**
+ * Writes a text to a file of a directory
+ *
+ * @param directory  The directory
+ * @param name       The name of the file
+ * @param text       The text
+ */
+void write_file(const char* directory, const char* name, const char* text) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s", directory, name);
+  FILE* file = fopen(path, "w");
+  fputs(text, file);
+  fclose(file);
+}
+
+/**
+ * Removes a file of a directory
+ *
+ * @param directory  The directory
+ * @param name       The name of the file
+ */
+void remove_file(const char* directory, const char* name) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s", directory, name);
+  remove(path);
+}
+
+// Tests
+// -----
+
+/**
+ * Tests the scenario_read_csv function
+ */
+void test_scenario_read_csv(void) {
+  diag("Testing scenario_read_csv");
+  char directory[] = "/tmp/test_csv_input_XXXXXX";
+  ok(mkdtemp(directory) != NULL, "temporary directory is created");
+  write_file(directory, "topology.json",
+             "{\"timeline\": {\"future-durations\": [10, 30, 60]},"
+             " \"zones\": [{\"id\": \"Z1\"}, {\"id\": \"Z2\"}],"
+             " \"links\": [{\"id\": \"L1\", \"source\": \"Z1\","
+             " \"target\": \"Z2\"}],"
+             " \"plants\": [{\"id\": \"P1\", \"zone\": \"Z1\"},"
+             " {\"id\": \"P2\", \"zone\": \"Z2\"}],"
+             " \"series\": {\"expected-demands\": \"demands.csv\","
+             " \"min-powers\": \"min.csv\", \"max-powers\": \"max.csv\"}}");
+  // Columns in any order, with blanks, quotes and Windows line breaks
+  write_file(directory, "demands.csv",
+             "timestep,\"Z2\", Z1\r\n"
+             "0,1e5,5\r\n1, 6.5 ,6.50\r\n2,5.0,100000\r\n");
+  write_file(directory, "min.csv", "P1,P2\n0,1\n1.5,2.5\n3,4");
+  write_file(directory, "max.csv", "P2,P1\n8,7\n9,8.0\n901.5,900.5\n\n");
+  char topology[256];
+  snprintf(topology, sizeof(topology), "%s/topology.json", directory);
+
+  struct Scenario scenario;
+  scenario_read_csv(&scenario, topology);
+  struct NetworkScenarioExample expected;
+  network_scenario_example_initialize(&expected);
+  ok(scenario_are_equal(&scenario, &expected.scenario),
+     "scenario read from CSV files is as expected");
+
+  // Teardown
+  scenario_free(&scenario);
+  network_scenario_example_free(&expected);
+  remove_file(directory, "topology.json");
+  remove_file(directory, "demands.csv");
+  remove_file(directory, "min.csv");
+  remove_file(directory, "max.csv");
+  rmdir(directory);
+}
+
+/**
+ * Tests the scenario_read_csv function on a topology without components
+ */
+void test_scenario_read_csv_empty(void) {
+  diag("Testing scenario_read_csv without components");
+  char directory[] = "/tmp/test_csv_input_XXXXXX";
+  ok(mkdtemp(directory) != NULL, "temporary directory is created");
+  write_file(directory, "topology.json",
+             "{\"timeline\": {\"future-durations\": [10]}, \"series\": {}}");
+  char topology[256];
+  snprintf(topology, sizeof(topology), "%s/topology.json", directory);
+
+  struct Scenario scenario;
+  scenario_read_csv(&scenario, topology);
+  cmp_ok(scenario.num_zones + scenario.num_plants + scenario.num_links, "==",
+         0, "scenario has no component");
+  cmp_ok(scenario.timeline->num_future_timesteps, "==", 1,
+         "scenario has 1 timestep");
+
+  // Teardown
+  scenario_free(&scenario);
+  remove_file(directory, "topology.json");
+  rmdir(directory);
+}
+
+int main(void) {
+  test_scenario_read_csv();
+  test_scenario_read_csv_empty();
+  done_testing();
+}
@@ -0,0 +1,150 @@
+#include "json_input.h"
+
+#include <stdio.h>
+
+#include <tap.h>
+
+#include "examples.h"
+
+// Help functions
+// --------------
+
+/**
+ * Opens a temporary file containing a given text
+ *
+ * @param text  The text
+ * @return      The file, positioned at its start
+ */
+FILE* open_text(const char* text) {
+  FILE* file = tmpfile();
+  fputs(text, file);
+  rewind(file);
+  return file;
+}
+
+/**
+ * Opens a temporary file containing a JSON value
+ *
+ * @param j  The JSON value
+ * @return   The file, positioned at its start
+ */
+FILE* open_json(const json_t* j) {
+  FILE* file = tmpfile();
+  json_dumpf(j, file, JSON_INDENT(2));
+  rewind(file);
+  return file;
+}
+
+// Tests
+// -----
+
+/**
+ * Tests the timeline_read_json function
+ */
+void test_timeline_read_json(void) {
+  diag("Testing timeline_read_json");
+  int durations[] = {10, 30, 60};
+  const struct Timeline* timeline = timeline_create(3, durations);
+  FILE* file = open_text("{\"future-durations\": [10, 30, 60]}");
+  struct JsonReader reader;
+  json_reader_initialize(&reader, file);
+  const struct Timeline* json_timeline = timeline_read_json(&reader);
+  ok(timeline_are_equal(timeline, json_timeline),
+     "streamed timeline is equal to the manually built one");
+  timeline_release(timeline);
+  timeline_release(json_timeline);
+  fclose(file);
+}
+
+/**
+ * Tests reading a scenario written by scenario_to_json
+ */
+void test_scenario_read_json(void) {
+  diag("Testing scenario_read_json on a dumped scenario");
+  struct NetworkScenarioExample example;
+  network_scenario_example_initialize(&example);
+  struct Scenario json_scenario;
+  json_t* j = scenario_to_json(&example.scenario);
+  FILE* file = open_json(j);
+  scenario_read_json(&json_scenario, file);
+  ok(scenario_are_equal(&example.scenario, &json_scenario),
+     "streamed scenario is equal to the original one");
+  cmp_ok(json_scenario.num_plants, "==", 2, "streamed scenario has 2 plants");
+  fclose(file);
+  json_decref(j);
+  network_scenario_example_free(&example);
+  scenario_free(&json_scenario);
+}
+
+/**
+ * Tests reading a scenario whose components come before the timeline
+ */
+void test_scenario_read_json_staged(void) {
+  diag("Testing scenario_read_json with the timeline at the end");
+  struct NetworkScenarioExample example;
+  network_scenario_example_initialize(&example);
+  struct Scenario json_scenario;
+  FILE* file = open_text(
+    "{\"plants\": [\n"
+    "  {\"id\": \"P1\", \"zone\": \"Z1\", \"min-powers\": [\n"
+    "    {\"value\": 0, \"from\": 0}, {\"value\": 1.5, \"from\": 1},\n"
+    "    {\"value\": 3, \"from\": 2}],\n"
+    "   \"max-powers\": [7, 8, 900.5]},\n"
+    "  {\"id\": \"P2\", \"zone\": \"Z2\", \"min-powers\": [1, 2.5, 4],\n"
+    "   \"max-powers\": [8.0, 9.0, 901.5]}],\n"
+    " \"links\": [{\"id\": \"L1\", \"source\": \"Z1\", \"target\": \"Z2\"}],\n"
+    " \"zones\": [\n"
+    "  {\"expected-demands\": [5, 6.5, 1e5], \"id\": \"Z1\"},\n"
+    "  {\"id\": \"Z2\", \"expected-demands\": [1e5, 6.5, 5]}],\n"
+    " \"timeline\": {\"future-durations\": [10, 30, 60]}}\n");
+  scenario_read_json(&json_scenario, file);
+  ok(scenario_are_equal(&example.scenario, &json_scenario),
+     "components read before the timeline and zones are added");
+  fclose(file);
+  network_scenario_example_free(&example);
+  scenario_free(&json_scenario);
+}
+
+/**
+ * Tests reading plans, with the timeline first or last
+ */
+void test_plan_read_json(void) {
+  diag("Testing plan_read_json");
+  int durations[] = {10, 30};
+  const struct Timeline* timeline = timeline_create(2, durations);
+  struct Plan plan, json_plan1, json_plan2;
+  plan_initialize(&plan, timeline);
+  timeline_release(timeline);
+  plan_set_production(&plan, 0, "P1", 2.0);
+  plan_set_production(&plan, 1, "P1", 4.5);
+  plan_set_production(&plan, 0, "P2", 1.0);
+  plan_set_production(&plan, 1, "P2", 0.0);
+  json_t* j = plan_to_json(&plan);
+  FILE* file1 = open_json(j);
+  FILE* file2 = open_text(
+    "{\"productions\": {\"P2\": [1, 0], \"P1\": [2.0, 4.5]},\n"
+    " \"timeline\": {\"future-durations\": [10, 30]}}");
+  plan_read_json(&json_plan1, file1);
+  plan_read_json(&json_plan2, file2);
+  ok(plan_are_equal(&plan, &json_plan1),
+     "streamed plan is equal to the original one");
+  ok(plan_are_equal(&plan, &json_plan2),
+     "productions read before the timeline are added");
+  fclose(file1);
+  fclose(file2);
+  json_decref(j);
+  plan_free(&plan);
+  plan_free(&json_plan1);
+  plan_free(&json_plan2);
+}
+
+// Main
+// ----
+
+int main(void) {
+  test_timeline_read_json();
+  test_scenario_read_json();
+  test_scenario_read_json_staged();
+  test_plan_read_json();
+  done_testing();
+}
@@ -0,0 +1,119 @@
+#include "json_output.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <jansson.h>
+#include <tap.h>
+
+#include "examples.h"
+
+// Help functions
+// --------------
+
+/**
+ * Checks that a streamed document is the dump of a JSON value
+ *
+ * @param file  The file in which the document was written
+ * @param j     The JSON value, released by the function
+ * @param name  The name of the document
+ */
+void check_dump(FILE* file, json_t* j, const char* name) {
+  long size = ftell(file);
+  char* content = malloc(size + 1);
+  rewind(file);
+  content[fread(content, 1, size, file)] = '\0';
+  char* expected = json_dumps(j, JSON_INDENT(2));
+  is(content, expected, "%s is the same as json_dumps", name);
+  free(content);
+  free(expected);
+  json_decref(j);
+  fclose(file);
+}
+
+/**
+ * Writes a scenario to a temporary file
+ *
+ * @param scenario  The scenario
+ * @return          The file, positioned at its end
+ */
+FILE* write_scenario(const struct Scenario* scenario) {
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize(writer, file);
+  scenario_write_json(writer, scenario);
+  json_writer_flush(writer);
+  free(writer);
+  return file;
+}
+
+/**
+ * Writes a plan to a temporary file
+ *
+ * @param plan  The plan
+ * @return      The file, positioned at its end
+ */
+FILE* write_plan(const struct Plan* plan) {
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize(writer, file);
+  plan_write_json(writer, plan);
+  json_writer_flush(writer);
+  free(writer);
+  return file;
+}
+
+// Tests
+// -----
+
+/**
+ * Tests the scenario_write_json function
+ */
+void test_scenario_write_json(void) {
+  diag("Testing scenario_write_json");
+  struct NetworkScenarioExample example;
+  network_scenario_example_initialize(&example);
+  check_dump(write_scenario(&example.scenario),
+             scenario_to_json(&example.scenario),
+             "scenario");
+  network_scenario_example_free(&example);
+
+  struct Scenario scenario;
+  const struct Timeline* timeline = timeline_create(0, NULL);
+  scenario_initialize(&scenario, timeline);
+  timeline_release(timeline);
+  check_dump(write_scenario(&scenario), scenario_to_json(&scenario),
+             "empty scenario");
+  scenario_free(&scenario);
+}
+
+/**
+ * Tests the plan_write_json function
+ */
+void test_plan_write_json(void) {
+  diag("Testing plan_write_json");
+  int durations[] = {10, 30};
+  const struct Timeline* timeline = timeline_create(2, durations);
+  struct Plan plan;
+  plan_initialize(&plan, timeline);
+  const char* ids[] = {"P3", "P1", "P2"};
+  for (int p = 0; p < 3; ++p)
+    for (int t = 0; t < 2; ++t)
+      plan_set_production(&plan, t, ids[p], p * 10.5 + t * 0.5);
+  check_dump(write_plan(&plan), plan_to_json(&plan),
+             "plan with unsorted plants");
+  plan_free(&plan);
+  timeline_release(timeline);
+
+  timeline = timeline_create(0, NULL);
+  plan_initialize(&plan, timeline);
+  check_dump(write_plan(&plan), plan_to_json(&plan), "empty plan");
+  plan_free(&plan);
+  timeline_release(timeline);
+}
+
+int main(void) {
+  test_scenario_write_json();
+  test_plan_write_json();
+  done_testing();
+}
@@ -0,0 +1,182 @@
+#include "json_reader.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <tap.h>
+
+// Help functions
+// --------------
+
+/**
+ * Opens a temporary file containing a given text
+ *
+ * @param text  The text
+ * @return      The file, positioned at its start
+ */
+FILE* open_text(const char* text) {
+  FILE* file = tmpfile();
+  fputs(text, file);
+  rewind(file);
+  return file;
+}
+
+/**
+ * Reads an array holding a number in a child process
+ *
+ * @param number  The text of the number
+ * @return        The exit status of the child, 0 if the number is read, or -1
+ *                if the child is killed
+ */
+int read_number_in_child(const char* number) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    freopen("/dev/null", "w", stderr);
+    char text[3 * JSON_READER_MAX_NUMBER_LENGTH];
+    snprintf(text, sizeof(text), "[%s]", number);
+    FILE* file = open_text(text);
+    struct JsonReader reader;
+    json_reader_initialize(&reader, file);
+    json_reader_next(&reader);
+    json_reader_next(&reader);
+    fclose(file);
+    _exit(0);
+  }
+  int status;
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Tests
+// -----
+
+/**
+ * Tests the events of a small document
+ */
+void test_json_reader_events(void) {
+  diag("Reading the events of a small document");
+  FILE* file = open_text(" {\"a\": [1, -2.5e1, \"x\", true, false, null],\n"
+                         "  \"b\": {}, \"c\": []} ");
+  struct JsonReader reader;
+  json_reader_initialize(&reader, file);
+  enum JsonEvent expected[] = {
+    JSON_EVENT_OBJECT_START, JSON_EVENT_KEY, JSON_EVENT_ARRAY_START,
+    JSON_EVENT_INTEGER, JSON_EVENT_REAL, JSON_EVENT_STRING, JSON_EVENT_TRUE,
+    JSON_EVENT_FALSE, JSON_EVENT_NULL, JSON_EVENT_ARRAY_END, JSON_EVENT_KEY,
+    JSON_EVENT_OBJECT_START, JSON_EVENT_OBJECT_END, JSON_EVENT_KEY,
+    JSON_EVENT_ARRAY_START, JSON_EVENT_ARRAY_END, JSON_EVENT_OBJECT_END,
+    JSON_EVENT_END
+  };
+  int num_events = sizeof(expected) / sizeof(expected[0]);
+  bool same_events = true;
+  for (int e = 0; e < num_events; ++e) {
+    enum JsonEvent event = json_reader_next(&reader);
+    same_events = same_events && event == expected[e];
+    if (e == 1)
+      is(reader.string, "a", "first key is \"a\"");
+    else if (e == 3)
+      cmp_ok(reader.integer, "==", 1, "first number is the integer 1");
+    else if (e == 4)
+      cmp_ok(reader.real, "==", -25.0, "second number is -25.0");
+  }
+  ok(same_events, "events are reported in document order");
+  cmp_ok(reader.line, "==", 2, "reader ends on line 2");
+  fclose(file);
+}
+
+/**
+ * Tests reading escaped strings
+ */
+void test_json_reader_strings(void) {
+  diag("Reading escaped strings");
+  FILE* file = open_text("[\"a\\\"b\\\\c\\/d\\n\", \"\\u00e9\\ud83d\\ude00\"]");
+  struct JsonReader reader;
+  json_reader_initialize(&reader, file);
+  json_reader_next(&reader);
+  json_reader_next(&reader);
+  is(reader.string, "a\"b\\c/d\n", "simple escapes are decoded");
+  json_reader_next(&reader);
+  is(reader.string, "\xc3\xa9\xf0\x9f\x98\x80",
+     "unicode escapes and surrogate pairs are decoded as UTF-8");
+  fclose(file);
+}
+
+/**
+ * Tests skipping values
+ */
+void test_json_reader_skip(void) {
+  diag("Skipping nested values");
+  FILE* file = open_text("[{\"a\": [1, {\"b\": [2]}]}, 3]");
+  struct JsonReader reader;
+  json_reader_initialize(&reader, file);
+  json_reader_next(&reader);
+  json_reader_skip(&reader, json_reader_next(&reader));
+  cmp_ok(json_reader_next(&reader), "==", JSON_EVENT_INTEGER,
+         "the value after a skipped object is read");
+  cmp_ok(reader.integer, "==", 3, "the value after a skipped object is 3");
+  ok(json_event_is_number(JSON_EVENT_REAL) &&
+     !json_event_is_number(JSON_EVENT_STRING),
+     "only integers and reals are numbers");
+  fclose(file);
+}
+
+/**
+ * Tests reading a document larger than the buffer
+ */
+void test_json_reader_large_document(void) {
+  diag("Reading a document larger than the buffer");
+  FILE* file = tmpfile();
+  int num_values = 3 * JSON_READER_BUFFER_SIZE / 8;
+  fputc('[', file);
+  for (int i = 0; i < num_values; ++i)
+    fprintf(file, "%s%d.5", i == 0 ? "" : ", ", i);
+  fputc(']', file);
+  rewind(file);
+  struct JsonReader reader;
+  json_reader_initialize(&reader, file);
+  json_reader_next(&reader);
+  bool all_read = true;
+  for (int i = 0; i < num_values; ++i)
+    all_read = all_read && json_reader_next(&reader) == JSON_EVENT_REAL &&
+               reader.real == i + 0.5;
+  ok(all_read, "every number is read across buffer refills");
+  ok(json_reader_next(&reader) == JSON_EVENT_ARRAY_END &&
+     json_reader_next(&reader) == JSON_EVENT_END,
+     "the document ends after the array");
+  fclose(file);
+}
+
+/**
+ * Tests reading numbers around the length limit
+ */
+void test_json_reader_long_numbers(void) {
+  diag("Reading numbers around the length limit");
+  char number[2 * JSON_READER_MAX_NUMBER_LENGTH];
+  memset(number, '1', JSON_READER_MAX_NUMBER_LENGTH);
+  number[JSON_READER_MAX_NUMBER_LENGTH - 2] = '.';
+  number[JSON_READER_MAX_NUMBER_LENGTH] = '\0';
+  cmp_ok(read_number_in_child(number), "==", 0,
+         "a number with a fraction at the limit is read");
+  memset(number, '1', JSON_READER_MAX_NUMBER_LENGTH);
+  strcpy(number + JSON_READER_MAX_NUMBER_LENGTH, ".25");
+  cmp_ok(read_number_in_child(number), "==", 1,
+         "a number with a fraction beyond the limit is rejected");
+  memset(number, '1', JSON_READER_MAX_NUMBER_LENGTH - 1);
+  strcpy(number + JSON_READER_MAX_NUMBER_LENGTH - 1, "e-5");
+  cmp_ok(read_number_in_child(number), "==", 1,
+         "a number with an exponent beyond the limit is rejected");
+}
+
+// Main
+// ----
+
+int main(void) {
+  test_json_reader_events();
+  test_json_reader_strings();
+  test_json_reader_skip();
+  test_json_reader_large_document();
+  test_json_reader_long_numbers();
+  done_testing();
+}
@@ -0,0 +1,243 @@
+#include "json_writer.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <jansson.h>
+#include <tap.h>
+
+// Help functions
+// --------------
+
+/**
+ * Returns the content of a file
+ *
+ * @param file  The file
+ * @return      The content, to be freed by the caller
+ */
+char* read_content(FILE* file) {
+  long size = ftell(file);
+  char* content = malloc(size + 1);
+  rewind(file);
+  content[fread(content, 1, size, file)] = '\0';
+  return content;
+}
+
+/**
+ * Checks that a streamed document is the dump of a JSON value
+ *
+ * @param file   The file in which the document was written
+ * @param j      The JSON value, released by the function
+ * @param flags  The flags of the dump
+ * @param name   The name of the document
+ */
+void check_dump(FILE* file, json_t* j, size_t flags, const char* name) {
+  char* content = read_content(file);
+  char* expected = json_dumps(j, flags);
+  is(content, expected, "%s is the same as json_dumps", name);
+  free(content);
+  free(expected);
+  json_decref(j);
+  fclose(file);
+}
+
+// Tests
+// -----
+
+/**
+ * Tests writing nested values
+ */
+void test_json_writer_values(void) {
+  diag("Testing json_writer with nested values");
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize(writer, file);
+  json_writer_start_object(writer);
+  json_writer_key(writer, "empty-array");
+  json_writer_start_array(writer);
+  json_writer_end_array(writer);
+  json_writer_key(writer, "empty-object");
+  json_writer_start_object(writer);
+  json_writer_end_object(writer);
+  json_writer_key(writer, "nested");
+  json_writer_start_array(writer);
+  json_writer_start_array(writer);
+  json_writer_integer(writer, -42);
+  json_writer_end_array(writer);
+  json_writer_start_object(writer);
+  json_writer_key(writer, "x");
+  json_writer_string(writer, "y");
+  json_writer_end_object(writer);
+  json_writer_end_array(writer);
+  json_writer_key(writer, "string \"quoted\"");
+  json_writer_string(writer, "a\\b/c\n\t\x01\xc3\xa9");
+  json_writer_end_object(writer);
+  json_writer_flush(writer);
+  json_t* j = json_pack("{s:[],s:{},s:[[i],{s:s}],s:s}",
+                        "empty-array",
+                        "empty-object",
+                        "nested", -42, "x", "y",
+                        "string \"quoted\"", "a\\b/c\n\t\x01\xc3\xa9");
+  check_dump(file, j, JSON_INDENT(2), "nested document");
+  free(writer);
+}
+
+/**
+ * Tests writing real numbers with a given precision
+ */
+void test_json_writer_precision(void) {
+  diag("Testing json_writer_real with a given precision");
+  double reals[] = {0.0, -0.0, 1.0, -3.0, 0.1, 2.5, 1.0 / 3.0, 1e20, 1e21,
+                    1e-5, -1.5e-300, 123456789012345678.0,
+                    1.7976931348623157e308, 5e-324};
+  unsigned int num_reals = sizeof(reals) / sizeof(reals[0]);
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize(writer, file);
+  json_writer_set_layout(writer, false, 17);
+  json_t* j = json_array();
+  json_writer_start_array(writer);
+  for (unsigned int i = 0; i < num_reals; ++i) {
+    json_writer_real(writer, reals[i]);
+    json_array_append_new(j, json_real(reals[i]));
+  }
+  json_writer_end_array(writer);
+  json_writer_flush(writer);
+  check_dump(file, j, JSON_INDENT(2) | JSON_REAL_PRECISION(17),
+             "array of reals with 17 digits");
+  free(writer);
+}
+
+/**
+ * Tests writing real numbers with the shortest digits
+ */
+void test_json_writer_shortest(void) {
+  diag("Testing json_writer_real with the shortest digits");
+  double reals[] = {0.0, -0.0, 3.0, 100000.0, 0.1, -2.5, 1.0 / 3.0, 1e-4,
+                    1e-5, 1e16, 1e17, 123.456, 5e-324,
+                    1.7976931348623157e308};
+  const char* expected = "[0.0,-0.0,3.0,100000.0,0.1,-2.5,0.3333333333333333,"
+                         "0.0001,1e-5,10000000000000000.0,1e17,123.456,"
+                         "5e-324,1.7976931348623157e308]";
+  unsigned int num_reals = sizeof(reals) / sizeof(reals[0]);
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize(writer, file);
+  json_writer_set_layout(writer, true, 0);
+  json_writer_start_array(writer);
+  for (unsigned int i = 0; i < num_reals; ++i)
+    json_writer_real(writer, reals[i]);
+  json_writer_end_array(writer);
+  json_writer_flush(writer);
+  char* content = read_content(file);
+  is(content, expected, "reals are written with the shortest digits");
+  free(content);
+  fclose(file);
+  free(writer);
+}
+
+/**
+ * Tests writing a compact document
+ */
+void test_json_writer_compact(void) {
+  diag("Testing json_writer with a compact layout");
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize(writer, file);
+  json_writer_set_layout(writer, true, 0);
+  json_writer_start_object(writer);
+  json_writer_key(writer, "empty");
+  json_writer_start_array(writer);
+  json_writer_end_array(writer);
+  json_writer_key(writer, "values");
+  json_writer_start_array(writer);
+  json_writer_integer(writer, 1);
+  json_writer_real(writer, 2.5);
+  json_writer_start_object(writer);
+  json_writer_key(writer, "x");
+  json_writer_string(writer, "y");
+  json_writer_end_object(writer);
+  json_writer_end_array(writer);
+  json_writer_end_object(writer);
+  json_writer_flush(writer);
+  json_t* j = json_pack("{s:[],s:[i,f,{s:s}]}",
+                        "empty", "values", 1, 2.5, "x", "y");
+  check_dump(file, j, JSON_COMPACT, "compact document");
+  free(writer);
+}
+
+/**
+ * Tests writing a document larger than the buffer
+ */
+void test_json_writer_large(void) {
+  diag("Testing json_writer with a document larger than its buffer");
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize(writer, file);
+  json_t* j = json_array();
+  json_writer_start_array(writer);
+  for (int i = 0; i < 20000; ++i) {
+    json_writer_real(writer, i / 8.0);
+    json_array_append_new(j, json_real(i / 8.0));
+  }
+  json_writer_end_array(writer);
+  json_writer_flush(writer);
+  ok(ftell(file) > JSON_WRITER_BUFFER_SIZE,
+     "document is larger than the buffer");
+  check_dump(file, j, JSON_INDENT(2), "large array");
+  free(writer);
+}
+
+/**
+ * Tests writing to a file descriptor
+ */
+void test_json_writer_fd(void) {
+  diag("Testing json_writer_initialize_fd");
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  FILE* file = tmpfile();
+  json_writer_initialize_fd(writer, fileno(file));
+  json_writer_start_object(writer);
+  json_writer_key(writer, "values");
+  json_writer_start_array(writer);
+  json_writer_integer(writer, 1);
+  json_writer_real(writer, 2.0);
+  json_writer_end_array(writer);
+  json_writer_end_object(writer);
+  json_writer_flush(writer);
+  fseek(file, 0, SEEK_END);
+  check_dump(file, json_pack("{s:[i,f]}", "values", 1, 2.0), JSON_INDENT(2),
+             "document written to a descriptor");
+  free(writer);
+}
+
+/**
+ * Tests writing to a full device
+ */
+void test_json_writer_failure(void) {
+  diag("Testing write failures");
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  int fd = open("/dev/full", O_WRONLY);
+  json_writer_initialize_fd(writer, fd);
+  json_writer_start_array(writer);
+  json_writer_integer(writer, 1);
+  json_writer_end_array(writer);
+  ok(!writer->failed, "writer has not failed before flushing");
+  json_writer_flush(writer);
+  ok(writer->failed, "writer has failed after flushing to a full device");
+  close(fd);
+  free(writer);
+}
+
+int main(void) {
+  test_json_writer_values();
+  test_json_writer_precision();
+  test_json_writer_shortest();
+  test_json_writer_compact();
+  test_json_writer_large();
+  test_json_writer_fd();
+  test_json_writer_failure();
+  done_testing();
+}
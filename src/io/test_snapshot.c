@@ -0,0 +1,122 @@
+#include "snapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <tap.h>
+
+#include "examples.h"
+#include "unit.h"
+
+// Help functions
+// --------------
+
+/**
+ * Indicates if a series lies in a snapshot
+ *
+ * @param snapshot  The snapshot
+ * @param series    The series
+ * @return          true if and only if the series is a view into the snapshot
+ */
+bool series_is_in_snapshot(const struct Snapshot* snapshot,
+                           const stored_mw* series) {
+  const char* data = snapshot->data;
+  return (const char*)series >= data &&
+         (const char*)series < data + snapshot->size;
+}
+
+// Tests
+// -----
+
+/**
+ * Tests writing a snapshot and loading it back
+ */
+void test_snapshot(void) {
+  diag("Writing a scenario snapshot and mapping it back");
+
+  // Setup
+  struct NetworkScenarioExample example;
+  network_scenario_example_initialize(&example);
+  struct Scenario snapshot_scenario;
+  char filename[] = "test_snapshot_XXXXXX";
+  FILE* file = fdopen(mkstemp(filename), "wb");
+  scenario_write_snapshot(&example.scenario, file);
+  fclose(file);
+  file = fopen(filename, "rb");
+  ok(snapshot_file_is_snapshot(file), "written file is a snapshot");
+  fclose(file);
+  struct Snapshot snapshot;
+  snapshot_open(&snapshot, filename);
+  scenario_from_snapshot(&snapshot_scenario, &snapshot);
+
+  // Checks
+  ok(scenario_are_equal(&example.scenario, &snapshot_scenario),
+     "mapped scenario is equal to the original one");
+  const struct SnapshotHeader* header = snapshot.data;
+  cmp_ok(header->num_ids, "==", 5, "identifier table has 5 entries");
+  ok(series_is_in_snapshot(&snapshot, snapshot_scenario.plants[1].max_powers),
+     "plant series are views into the snapshot");
+  ok((uintptr_t)snapshot_scenario.zones[1].expected_demands %
+     SERIES_ALIGNMENT == 0,
+     "zone series are aligned");
+  stored_mw* min_powers = scenario_modify_plant_min_powers(&snapshot_scenario,
+                                                           0);
+  min_powers[0] = mw_store(42.0);
+  ok(!series_is_in_snapshot(&snapshot, min_powers),
+     "modified series is copied out of the snapshot");
+  struct Plant* plant = scenario_emplace_plant(&snapshot_scenario, "P3", 1);
+  for (int t = 0; t < 3; ++t)
+    plant->min_powers[t] = plant->max_powers[t] = mw_store(1.0);
+  ok(series_is_in_snapshot(&snapshot, snapshot_scenario.plants[1].min_powers),
+     "unmodified series stay in the snapshot when plants are added");
+  cmp_ok(mw_load(snapshot_scenario.plants[0].min_powers[0]), "==", 42.0,
+         "modified series survives the growth of the scenario");
+  cmp_ok(mw_load(snapshot_scenario.plants[1].max_powers[2]), "==", 901.5,
+         "shared series keeps its values");
+
+  // Teardown
+  network_scenario_example_free(&example);
+  scenario_free(&snapshot_scenario);
+  snapshot_close(&snapshot);
+  remove(filename);
+}
+
+/**
+ * Tests the snapshot of an empty scenario
+ */
+void test_empty_snapshot(void) {
+  diag("Writing the snapshot of an empty scenario");
+
+  // Setup
+  struct Scenario scenario, snapshot_scenario;
+  const struct Timeline* timeline = timeline_create(0, NULL);
+  scenario_initialize(&scenario, timeline);
+  timeline_release(timeline);
+  char filename[] = "test_snapshot_XXXXXX";
+  FILE* file = fdopen(mkstemp(filename), "wb");
+  scenario_write_snapshot(&scenario, file);
+  fclose(file);
+  struct Snapshot snapshot;
+  snapshot_open(&snapshot, filename);
+  scenario_from_snapshot(&snapshot_scenario, &snapshot);
+
+  // Checks
+  ok(scenario_are_equal(&scenario, &snapshot_scenario),
+     "mapped empty scenario is equal to the original one");
+
+  // Teardown
+  scenario_free(&scenario);
+  scenario_free(&snapshot_scenario);
+  snapshot_close(&snapshot);
+  remove(filename);
+}
+
+// Main
+// ----
+
+int main(void) {
+  test_snapshot();
+  test_empty_snapshot();
+  done_testing();
+}
@@ -1,36 +1,112 @@
 #include "plan.h"
 
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/symbol_table.h"
 #include "validation.h"
 
+// Helpers
+// -------
+
+// A plant of a plan, used to list the plants by identifier
+struct PlanPlant {
+  const char* id;     // The identifier of the plant
+  unsigned int index; // The index of the plant in the plan
+};
+
+/**
+ * Compares two plants of a plan by identifier
+ *
+ * @param a  The first plant
+ * @param b  The second plant
+ * @return   A negative, zero or positive value, as strcmp
+ */
+int plan_plant_compare(const void* a, const void* b) {
+  return strcmp(((const struct PlanPlant*)a)->id,
+                ((const struct PlanPlant*)b)->id);
+}
+
+/**
+ * Grows the production matrix of a plan so that it can hold given plants
+ *
+ * The capacity is at least doubled at each growth, so that adding n plants
+ * one at a time costs O(log n) reallocations. New rows are filled with 0.0.
+ *
+ * @param plan        The plan
+ * @param num_plants  The number of plants the matrix must hold
+ */
+void plan_reserve_plants(struct Plan* plan, unsigned int num_plants) {
+  if (num_plants <= plan->plants_capacity)
+    return;
+  unsigned int capacity = 2 * plan->plants_capacity;
+  if (capacity < num_plants)
+    capacity = num_plants;
+  size_t num_values = plan->timeline->num_future_timesteps;
+  plan->productions =
+    realloc(plan->productions, capacity * num_values * sizeof(stored_mw));
+  memset(plan->productions + plan->plants_capacity * num_values,
+         0,
+         (capacity - plan->plants_capacity) * num_values *
+           sizeof(stored_mw));
+  plan->plant_symbols =
+    realloc(plan->plant_symbols, capacity * sizeof(unsigned int));
+  plan->plants_capacity = capacity;
+}
+
+/**
+ * Grows the symbol index of a plan so that it covers a given symbol
+ *
+ * @param plan    The plan
+ * @param symbol  The symbol to cover
+ */
+void plan_reserve_symbol(struct Plan* plan, unsigned int symbol) {
+  if (symbol < plan->num_plant_indices)
+    return;
+  unsigned int size = 2 * plan->num_plant_indices;
+  if (size <= symbol)
+    size = symbol + 1;
+  plan->plant_indices = realloc(plan->plant_indices, size * sizeof(int));
+  for (unsigned int s = plan->num_plant_indices; s < size; ++s)
+    plan->plant_indices[s] = -1;
+  plan->num_plant_indices = size;
+}
+
 // Initialization
 // --------------
 
 void plan_initialize(struct Plan* plan,
                      const struct Timeline* timeline) {
-  timeline_copy(&plan->timeline, timeline);
-  plan->productions =
-    malloc(timeline->num_future_timesteps * sizeof(struct Treemap));
-  for (int t = 0; t < timeline->num_future_timesteps; ++t)
-    treemap_initialize(plan->productions + t);
+  plan->timeline = timeline_retain(timeline);
+  plan->num_plants = 0;
+  plan->plants_capacity = 0;
+  plan->plant_symbols = NULL;
+  plan->num_plant_indices = 0;
+  plan->plant_indices = NULL;
+  plan->productions = NULL;
 }
 
 void plan_from_json(struct Plan* plan, json_t* j) {
   ensure_json_is_object(j);
   ensure_json_object_contains_key(j, JSON_PLAN_TIMELINE);
   json_t* j_timeline = json_object_get(j, JSON_PLAN_TIMELINE);
-  struct Timeline timeline;
-  timeline_from_json(&timeline, j_timeline);
-  plan_initialize(plan, &timeline);
-  timeline_free(&timeline);
+  const struct Timeline* timeline = timeline_from_json(j_timeline);
+  plan_initialize(plan, timeline);
+  timeline_release(timeline);
   json_t* j_productions = json_object_get(j, JSON_PLAN_PRODUCTIONS);
   ensure_json_is_object(j_productions);
+  plan_reserve_plants(plan, json_object_size(j_productions));
   const char* plant_id;
   json_t* j_plant_productions;
   json_object_foreach(j_productions, plant_id, j_plant_productions) {
     ensure_json_is_array(j_plant_productions);
-    for (int t = 0; t < json_array_size(j_plant_productions); ++t)
-      plan_set_production(plan, t, plant_id,
-                          json_real_value(json_array_get(j_plant_productions, t)));
+    ensure_json_array_has_size(j_plant_productions,
+                               plan->timeline->num_future_timesteps);
+    unsigned int p = plan_add_plant(plan, plant_id);
+    for (int t = 0; t < json_array_size(j_plant_productions); ++t) {
+      json_t* j_production = json_array_get(j_plant_productions, t);
+      plan_set_production_by_index(plan, t, p, json_number_value(j_production));
+    }
   }
 }
 
@@ -38,20 +114,40 @@ void plan_from_json(struct Plan* plan, json_t* j) {
 // -----------
 
 void plan_free(struct Plan* plan) {
-  for (int t = 0; t < plan->timeline.num_future_timesteps; ++t)
-    treemap_delete(plan->productions + t);
+  free(plan->plant_symbols);
+  free(plan->plant_indices);
   free(plan->productions);
-  timeline_free(&plan->timeline);
+  timeline_release(plan->timeline);
 }
 
 // Modifiers
 // ---------
 
+unsigned int plan_add_plant(struct Plan* plan, const char* id) {
+  unsigned int symbol = symbol_table_intern(symbol_table_shared(), id);
+  int p = plan_plant_index_by_symbol(plan, symbol);
+  if (p >= 0)
+    return p;
+  plan_reserve_plants(plan, plan->num_plants + 1);
+  plan_reserve_symbol(plan, symbol);
+  plan->plant_symbols[plan->num_plants] = symbol;
+  plan->plant_indices[symbol] = plan->num_plants;
+  return plan->num_plants++;
+}
+
 void plan_set_production(struct Plan* plan,
                          int t,
                          const char* id,
                          mw production) {
-  treemap_set(plan->productions + t, id, production);
+  plan_set_production_by_index(plan, t, plan_add_plant(plan, id), production);
+}
+
+void plan_set_production_by_index(struct Plan* plan,
+                                  int t,
+                                  unsigned int p,
+                                  mw production) {
+  size_t row = (size_t)p * plan->timeline->num_future_timesteps;
+  plan->productions[row + t] = mw_store(production);
 }
 
 // Accessors
@@ -60,15 +156,60 @@ void plan_set_production(struct Plan* plan,
 mw plan_get_production(struct Plan* plan,
                        int t,
                        const char* id) {
-  return treemap_get(plan->productions + t, id);
+  int p = plan_plant_index(plan, id);
+  return p < 0 ? 0.0 : plan_get_production_by_index(plan, t, p);
+}
+
+mw plan_get_production_by_index(const struct Plan* plan,
+                                int t,
+                                unsigned int p) {
+  size_t row = (size_t)p * plan->timeline->num_future_timesteps;
+  return mw_load(plan->productions[row + t]);
+}
+
+int plan_plant_index(const struct Plan* plan, const char* id) {
+  int symbol = symbol_table_find(symbol_table_shared(), id);
+  return symbol < 0 ? -1 : plan_plant_index_by_symbol(plan, symbol);
+}
+
+int plan_plant_index_by_symbol(const struct Plan* plan, unsigned int symbol) {
+  if (symbol >= plan->num_plant_indices)
+    return -1;
+  return plan->plant_indices[symbol];
+}
+
+unsigned int* plan_plants_by_id(const struct Plan* plan) {
+  const struct SymbolTable* symbols = symbol_table_shared();
+  struct PlanPlant* plants =
+    malloc(plan->num_plants * sizeof(struct PlanPlant));
+  for (unsigned int p = 0; p < plan->num_plants; ++p) {
+    plants[p].id = symbol_table_name(symbols, plan->plant_symbols[p]);
+    plants[p].index = p;
+  }
+  qsort(plants, plan->num_plants, sizeof(struct PlanPlant),
+        plan_plant_compare);
+  unsigned int* indices = malloc((plan->num_plants + 1) *
+                                 sizeof(unsigned int));
+  for (unsigned int i = 0; i < plan->num_plants; ++i)
+    indices[i] = plants[i].index;
+  free(plants);
+  return indices;
 }
 
 bool plan_are_equal(const struct Plan* plan1, const struct Plan* plan2) {
-  if (!timeline_are_equal(&plan1->timeline, &plan2->timeline))
+  if (!timeline_are_equal(plan1->timeline, plan2->timeline))
+    return false;
+  if (plan1->num_plants != plan2->num_plants)
     return false;
-  for (int t = 0; t < plan1->timeline.num_future_timesteps; ++t)
-    if (!treemap_are_equal(plan1->productions + t, plan2->productions + t))
+  for (unsigned int p1 = 0; p1 < plan1->num_plants; ++p1) {
+    int p2 = plan_plant_index_by_symbol(plan2, plan1->plant_symbols[p1]);
+    if (p2 < 0)
       return false;
+    for (int t = 0; t < plan1->timeline->num_future_timesteps; ++t)
+      if (plan_get_production_by_index(plan1, t, p1) !=
+          plan_get_production_by_index(plan2, t, p2))
+        return false;
+  }
   return true;
 }
 
@@ -77,25 +218,25 @@ bool plan_are_equal(const struct Plan* plan1, const struct Plan* plan2) {
 
 json_t* plan_to_json(const struct Plan* plan) {
   json_t* j_productions = json_object();
-  if (plan->timeline.num_future_timesteps > 0) {
-    struct StringArray sa;
-    treemap_compute_keys(plan->productions, &sa);
-    for (int p = 0; p < sa.size; ++p) {
+  if (plan->timeline->num_future_timesteps > 0) {
+    const struct SymbolTable* symbols = symbol_table_shared();
+    unsigned int* plants = plan_plants_by_id(plan);
+    for (unsigned int i = 0; i < plan->num_plants; ++i) {
       json_t* j_plant_productions = json_array();
-      for (int t = 0; t < plan->timeline.num_future_timesteps; ++t) {
-        double production = 0.0;
-        if (treemap_has_key(plan->productions + t, sa.strings[p]))
-          production = treemap_get(plan->productions + t, sa.strings[p]);
-        json_array_append(j_plant_productions, json_real(production));
+      for (int t = 0; t < plan->timeline->num_future_timesteps; ++t) {
+        mw production = plan_get_production_by_index(plan, t, plants[i]);
+        json_array_append_new(j_plant_productions, json_real(production));
       }
-      json_object_set(j_productions, sa.strings[p], j_plant_productions);
-      json_decref(j_plant_productions);
+      json_object_set_new(j_productions,
+                          symbol_table_name(symbols,
+                                            plan->plant_symbols[plants[i]]),
+                          j_plant_productions);
     }
-    string_array_delete(&sa);
+    free(plants);
   }
   return json_pack("{s:o,s:o}",
                    "productions",
                    j_productions,
                    "timeline",
-                   timeline_to_json(&plan->timeline));
+                   timeline_to_json(plan->timeline));
 }
@@ -7,7 +7,6 @@
 #include "scenario.h"
 #include "timeline.h"
 #include "unit.h"
-#include "utils/treemap.h"
 
 // JSON keys
 // ---------
@@ -18,11 +17,25 @@
 // Type
 // ----
 
+// Productions are stored in a dense matrix with one row per plant and one
+// column per timestep. Plants are identified by their index in the matrix,
+// which is given by the order in which they were added to the plan, and are
+// found from the symbol of their identifier in the shared symbol table.
 struct Plan {
   // The reference timeline of the plan
-  struct Timeline timeline;
-  // The treemaps associating plants with their production, for each time step
-  struct Treemap* productions;
+  const struct Timeline* timeline;
+  // The number of plants in the plan
+  unsigned int num_plants;
+  // The number of plant rows allocated in the production matrix
+  unsigned int plants_capacity;
+  // The symbols of the plants, one per row of the production matrix
+  unsigned int* plant_symbols;
+  // The number of symbols covered by plant_indices
+  unsigned int num_plant_indices;
+  // The index of the plant of each symbol, or -1 if it is not in the plan
+  int* plant_indices;
+  // The productions of the plants, one row per plant
+  stored_mw* productions;
 };
 
 // Initialization
@@ -58,6 +71,18 @@ void plan_free(struct Plan* plan);
 // Modifiers
 // ---------
 
+/**
+ * Adds a plant to a plan
+ *
+ * The productions of a new plant are 0.0 at each timestep. If the plant is
+ * already in the plan, it is left unchanged.
+ *
+ * @param plan  The plan to modify
+ * @param id    The identifier of the plant
+ * @return      The index of the plant in the plan
+ */
+unsigned int plan_add_plant(struct Plan* plan, const char* id);
+
 /**
  * Sets the production of a plant at a given timestep
  *
@@ -71,6 +96,19 @@ void plan_set_production(struct Plan* plan,
                          const char* id,
                          mw production);
 
+/**
+ * Sets the production of a plant, given by its index, at a given timestep
+ *
+ * @param plan        The plan to modify
+ * @param t           The index of the time step
+ * @param p           The index of the plant whose production is updated
+ * @param production  The production to use
+ */
+void plan_set_production_by_index(struct Plan* plan,
+                                  int t,
+                                  unsigned int p,
+                                  mw production);
+
 // Accessors
 // ---------
 
@@ -86,6 +124,48 @@ mw plan_get_production(struct Plan* plan,
                        int t,
                        const char* id);
 
+/**
+ * Returns the production of a plant, given by its index, at a given timestep
+ *
+ * @param plan  The accessed plan
+ * @param t     The index of the time step
+ * @param p     The index of the plant
+ * @return      The production of the plant at the given time step
+ */
+mw plan_get_production_by_index(const struct Plan* plan,
+                                int t,
+                                unsigned int p);
+
+/**
+ * Returns the index of a plant in a plan
+ *
+ * If the plan has no production for the plant, returns -1.
+ *
+ * @param plan  The accessed plan
+ * @param id    The identifier of the plant
+ * @return      The index of the plant or -1
+ */
+int plan_plant_index(const struct Plan* plan, const char* id);
+
+/**
+ * Returns the index of a plant in a plan, given its symbol
+ *
+ * If the plan has no production for the plant, returns -1.
+ *
+ * @param plan    The accessed plan
+ * @param symbol  The symbol of the identifier of the plant
+ * @return        The index of the plant or -1
+ */
+int plan_plant_index_by_symbol(const struct Plan* plan, unsigned int symbol);
+
+/**
+ * Returns the indices of the plants of a plan, sorted by identifier
+ *
+ * @param plan  The accessed plan
+ * @return      The indices of the plants, to be freed by the caller
+ */
+unsigned int* plan_plants_by_id(const struct Plan* plan);
+
 /**
  * Indicates if two plans are equal
  *
@@ -1,15 +1,246 @@
 #include "scenario.h"
 
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "timeline.h"
+#include "utils/symbol_table.h"
 #include "validation.h"
 
+// The bits of the series of a plant in the shared series of a fork
+#define SCENARIO_SHARED_MIN_POWERS 1
+#define SCENARIO_SHARED_MAX_POWERS 2
+// The bit of the series of a zone in the shared series of a fork
+#define SCENARIO_SHARED_EXPECTED_DEMANDS 1
+
 // Helpers
 // -------
 
+/**
+ * Grows a component table so that it can hold a given number of components
+ *
+ * The capacity is at least doubled at each growth, so that adding n
+ * components one at a time costs O(log n) reallocations.
+ *
+ * @param arena         The arena from which the table is allocated
+ * @param table         The component table
+ * @param capacity      The capacity of the table, updated if it grows
+ * @param min_capacity  The number of components the table must hold
+ * @param item_size     The size of a component
+ * @return              The (possibly moved) component table
+ */
+void* scenario_grow_table(struct Arena* arena,
+                          void* table,
+                          unsigned int* capacity,
+                          unsigned int min_capacity,
+                          size_t item_size) {
+  if (min_capacity <= *capacity)
+    return table;
+  unsigned int new_capacity = *capacity == 0 ?
+                              COMPONENT_TABLE_INITIAL_CAPACITY :
+                              2 * *capacity;
+  if (new_capacity < min_capacity)
+    new_capacity = min_capacity;
+  table = arena_reallocate(arena,
+                           table,
+                           *capacity * item_size,
+                           new_capacity * item_size,
+                           _Alignof(max_align_t));
+  *capacity = new_capacity;
+  return table;
+}
+
+/**
+ * Allocates a series matrix with a given number of rows
+ *
+ * @param arena     The arena from which the matrix is allocated
+ * @param num_rows  The number of rows of the matrix
+ * @param stride    The number of values between the starts of two rows
+ * @return          The matrix, aligned on SERIES_ALIGNMENT bytes
+ */
+stored_mw* scenario_allocate_series(struct Arena* arena,
+                                    unsigned int num_rows,
+                                    unsigned int stride) {
+  return arena_allocate(arena,
+                        (size_t)num_rows * stride * sizeof(stored_mw),
+                        SERIES_ALIGNMENT);
+}
+
+/**
+ * Copies a series to a given row and points the series to it
+ *
+ * @param series      The series
+ * @param row         The row to which the series is moved
+ * @param num_values  The number of values of the series
+ */
+void scenario_move_series(stored_mw** series,
+                          stored_mw* row,
+                          unsigned int num_values) {
+  memcpy(row, *series, num_values * sizeof(stored_mw));
+  *series = row;
+}
+
+/**
+ * Indicates if a series of a component is shared with the parent scenario
+ *
+ * @param shared_series  The shared series of the inherited components
+ * @param num_inherited  The number of inherited components
+ * @param c              The index of the component
+ * @param series_bit     The bit of the series
+ * @return               true if and only if the series is shared
+ */
+bool scenario_series_is_shared(const unsigned char* shared_series,
+                               unsigned int num_inherited,
+                               unsigned int c,
+                               unsigned char series_bit) {
+  return c < num_inherited && (shared_series[c] & series_bit) != 0;
+}
+
+/**
+ * Moves the series of the plants of a scenario to new matrices
+ *
+ * Series shared with the parent scenario are left in place.
+ *
+ * @param scenario    The scenario
+ * @param min_powers  The new minimum power matrix
+ * @param max_powers  The new maximum power matrix
+ */
+void scenario_move_plant_series(struct Scenario* scenario,
+                                stored_mw* min_powers,
+                                stored_mw* max_powers) {
+  unsigned int num_values = scenario->timeline->num_future_timesteps;
+  for (unsigned int p = 0; p < scenario->num_plants; ++p) {
+    size_t row = (size_t)p * scenario->series_stride;
+    struct Plant* plant = scenario->plants + p;
+    if (!scenario_series_is_shared(scenario->shared_plant_series,
+                                   scenario->num_inherited_plants,
+                                   p,
+                                   SCENARIO_SHARED_MIN_POWERS))
+      scenario_move_series(&plant->min_powers, min_powers + row, num_values);
+    if (!scenario_series_is_shared(scenario->shared_plant_series,
+                                   scenario->num_inherited_plants,
+                                   p,
+                                   SCENARIO_SHARED_MAX_POWERS))
+      scenario_move_series(&plant->max_powers, max_powers + row, num_values);
+  }
+  scenario->min_powers = min_powers;
+  scenario->max_powers = max_powers;
+}
+
+/**
+ * Moves the series of the zones of a scenario to a new matrix
+ *
+ * Series shared with the parent scenario are left in place.
+ *
+ * @param scenario          The scenario
+ * @param expected_demands  The new demand matrix
+ */
+void scenario_move_zone_series(struct Scenario* scenario,
+                               stored_mw* expected_demands) {
+  unsigned int num_values = scenario->timeline->num_future_timesteps;
+  for (unsigned int z = 0; z < scenario->num_zones; ++z) {
+    size_t row = (size_t)z * scenario->series_stride;
+    struct Zone* zone = scenario->zones + z;
+    if (!scenario_series_is_shared(scenario->shared_zone_series,
+                                   scenario->num_inherited_zones,
+                                   z,
+                                   SCENARIO_SHARED_EXPECTED_DEMANDS))
+      scenario_move_series(&zone->expected_demands,
+                           expected_demands + row,
+                           num_values);
+  }
+  scenario->expected_demands = expected_demands;
+}
+
+/**
+ * Gives a scenario its own copy of a series shared with its parent
+ *
+ * @param scenario       The scenario
+ * @param series         The series
+ * @param shared_series  The shared series of the component, or NULL if the
+ *                       component is not inherited
+ * @param series_bit     The bit of the series
+ * @return               The series, owned by the scenario
+ */
+stored_mw* scenario_unshare_series(struct Scenario* scenario,
+                                   stored_mw** series,
+                                   unsigned char* shared_series,
+                                   unsigned char series_bit) {
+  if (shared_series != NULL && (*shared_series & series_bit) != 0) {
+    scenario_move_series(series,
+                         scenario_allocate_series(&scenario->arena,
+                                                  1,
+                                                  scenario->series_stride),
+                         scenario->timeline->num_future_timesteps);
+    *shared_series &= ~series_bit;
+  }
+  return *series;
+}
+
+/**
+ * Copies a component table of a scenario to a scenario being forked
+ *
+ * @param arena          The arena of the fork
+ * @param table          The component table of the parent
+ * @param num_components The number of components of the parent
+ * @param item_size      The size of a component
+ * @return               The copy of the table, with no spare capacity
+ */
+void* scenario_fork_table(struct Arena* arena,
+                          const void* table,
+                          unsigned int num_components,
+                          size_t item_size) {
+  if (num_components == 0)
+    return NULL;
+  void* fork_table = arena_allocate(arena,
+                                    num_components * item_size,
+                                    _Alignof(max_align_t));
+  memcpy(fork_table, table, num_components * item_size);
+  return fork_table;
+}
+
+/**
+ * Marks all series of the inherited components of a fork as shared
+ *
+ * @param arena          The arena of the fork
+ * @param num_inherited  The number of inherited components
+ * @param series_bits    The bits of all series of a component
+ * @return               The shared series of each inherited component
+ */
+unsigned char* scenario_fork_shared_series(struct Arena* arena,
+                                           unsigned int num_inherited,
+                                           unsigned char series_bits) {
+  if (num_inherited == 0)
+    return NULL;
+  unsigned char* shared_series = arena_allocate(arena, num_inherited, 1);
+  memset(shared_series, series_bits, num_inherited);
+  return shared_series;
+}
+
+/**
+ * Returns the index of the zone referenced by a key of a JSON component
+ *
+ * If the zone does not exist, prints an error message and exits the program.
+ *
+ * @param scenario  The scenario containing the zone
+ * @param j         The JSON component
+ * @param key       The key containing the identifier of the zone
+ * @return          The index of the zone
+ */
+unsigned int scenario_zone_index_from_json(const struct Scenario* scenario,
+                                           const json_t* j,
+                                           const char* key) {
+  ensure_json_object_contains_key(j, key);
+  const json_t* j_zone_id = json_object_get(j, key);
+  ensure_json_is_string(j_zone_id);
+  const char* zone_id = json_string_value(j_zone_id);
+  int zone = scenario_zone_index_by_id(scenario, zone_id);
+  ensure_zone_exists(zone, zone_id);
+  return zone;
+}
+
 /**
  * Adds links from a JSON value to a scenario
  *
@@ -20,18 +251,19 @@ void scenario_add_links_from_json(struct Scenario* scenario,
                                   const json_t* j_links) {
   ensure_json_is_array(j_links);
   int num_links = json_array_size(j_links);
+  scenario_reserve(scenario,
+                   scenario->num_links + num_links,
+                   scenario->num_plants,
+                   scenario->num_zones);
   for (int l = 0; l < num_links; ++l) {
     json_t* j_link = json_array_get(j_links, l);
-    const char* source_z_id = json_string_value(
-      json_object_get(j_link, JSON_LINK_SOURCE));
-    const char* target_z_id = json_string_value(
-      json_object_get(j_link, JSON_LINK_TARGET));
-    const struct Zone* source_zone = scenario_zone_by_id(scenario, source_z_id);
-    const struct Zone* target_zone = scenario_zone_by_id(scenario, target_z_id);
-    struct Link link;
-    link_from_json(&link, source_zone, target_zone, j_link);
-    scenario_add_link(scenario, &link);
-    link_free(&link);
+    unsigned int source =
+      scenario_zone_index_from_json(scenario, j_link, JSON_LINK_SOURCE);
+    unsigned int target =
+      scenario_zone_index_from_json(scenario, j_link, JSON_LINK_TARGET);
+    link_validate_json(scenario->zones, source, target, j_link);
+    const char* id = json_string_value(json_object_get(j_link, JSON_LINK_ID));
+    scenario_emplace_link(scenario, id, source, target);
   }
 }
 
@@ -45,15 +277,19 @@ void scenario_add_plants_from_json(struct Scenario* scenario,
                                    const json_t* j_plants) {
   ensure_json_is_array(j_plants);
   int num_plants = json_array_size(j_plants);
+  scenario_reserve(scenario,
+                   scenario->num_links,
+                   scenario->num_plants + num_plants,
+                   scenario->num_zones);
   for (int p = 0; p < num_plants; ++p) {
     json_t* j_plant = json_array_get(j_plants, p);
-    const char* z_id = json_string_value(json_object_get(j_plant,
-                                                         JSON_PLANT_ZONE));
-    const struct Zone* zone = scenario_zone_by_id(scenario, z_id);
-    struct Plant plant;
-    plant_from_json(&plant, &scenario->timeline, zone, j_plant);
-    scenario_add_plant(scenario, &plant);
-    plant_free(&plant);
+    unsigned int zone =
+      scenario_zone_index_from_json(scenario, j_plant, JSON_PLANT_ZONE);
+    plant_validate_json(scenario->timeline, scenario->zones, zone, j_plant);
+    const char* id =
+      json_string_value(json_object_get(j_plant, JSON_PLANT_ID));
+    struct Plant* plant = scenario_emplace_plant(scenario, id, zone);
+    plant_series_from_json(plant, j_plant);
   }
 }
 
@@ -67,34 +303,148 @@ void scenario_add_zones_from_json(struct Scenario* scenario,
                                   const json_t* j_zones) {
   ensure_json_is_array(j_zones);
   int num_zones = json_array_size(j_zones);
+  scenario_reserve(scenario,
+                   scenario->num_links,
+                   scenario->num_plants,
+                   scenario->num_zones + num_zones);
   for (int z = 0; z < num_zones; ++z) {
     json_t* j_zone = json_array_get(j_zones, z);
-    struct Zone zone;
-    zone_from_json(&zone, &scenario->timeline, j_zone);
-    scenario_add_zone(scenario, &zone);
-    zone_free(&zone);
+    zone_validate_json(scenario->timeline, j_zone);
+    const char* id = json_string_value(json_object_get(j_zone, JSON_ZONE_ID));
+    struct Zone* zone = scenario_emplace_zone(scenario, id);
+    zone_series_from_json(zone, j_zone);
   }
 }
 
+/**
+ * Returns the index of the component of a scenario with given identifier
+ *
+ * @param index  The symbol index of the components
+ * @param id     The identifier of the component
+ * @return       The index of the component or -1
+ */
+int scenario_component_index_by_id(const struct SymbolIndex* index,
+                                   const char* id) {
+  int symbol = symbol_table_find(symbol_table_shared(), id);
+  return symbol < 0 ? -1 : symbol_index_find(index, symbol);
+}
+
 // Initialization
 // --------------
 
 void scenario_initialize(struct Scenario* scenario,
                          const struct Timeline* timeline) {
-  timeline_copy(&scenario->timeline, timeline);
+  scenario->timeline = timeline_retain(timeline);
+  arena_initialize(&scenario->arena, SCENARIO_ARENA_BLOCK_SIZE);
+  const unsigned int values_per_line = SERIES_ALIGNMENT / sizeof(stored_mw);
+  scenario->series_stride =
+    (timeline->num_future_timesteps + values_per_line - 1) /
+    values_per_line * values_per_line;
   scenario->num_links = 0;
+  scenario->links_capacity = 0;
+  scenario->links = NULL;
+  symbol_index_initialize(&scenario->link_index, &scenario->arena);
   scenario->num_plants = 0;
+  scenario->plants_capacity = 0;
+  scenario->plants = NULL;
+  symbol_index_initialize(&scenario->plant_index, &scenario->arena);
   scenario->num_zones = 0;
+  scenario->zones_capacity = 0;
+  scenario->zones = NULL;
+  symbol_index_initialize(&scenario->zone_index, &scenario->arena);
+  scenario->min_powers = NULL;
+  scenario->max_powers = NULL;
+  scenario->expected_demands = NULL;
+  scenario->parent = NULL;
+  scenario->num_inherited_plants = 0;
+  scenario->shared_plant_series = NULL;
+  scenario->num_inherited_zones = 0;
+  scenario->shared_zone_series = NULL;
+}
+
+void scenario_fork(struct Scenario* fork, const struct Scenario* parent) {
+  scenario_initialize(fork, parent->timeline);
+  fork->parent = parent;
+  fork->links = scenario_fork_table(&fork->arena,
+                                    parent->links,
+                                    parent->num_links,
+                                    sizeof(struct Link));
+  fork->num_links = fork->links_capacity = parent->num_links;
+  symbol_index_reserve(&fork->link_index, fork->num_links);
+  for (unsigned int l = 0; l < fork->num_links; ++l)
+    symbol_index_insert(&fork->link_index, fork->links[l].symbol, l);
+  fork->plants = scenario_fork_table(&fork->arena,
+                                     parent->plants,
+                                     parent->num_plants,
+                                     sizeof(struct Plant));
+  fork->num_plants = fork->plants_capacity = parent->num_plants;
+  symbol_index_reserve(&fork->plant_index, fork->num_plants);
+  for (unsigned int p = 0; p < fork->num_plants; ++p)
+    symbol_index_insert(&fork->plant_index, fork->plants[p].symbol, p);
+  fork->num_inherited_plants = fork->num_plants;
+  fork->shared_plant_series =
+    scenario_fork_shared_series(&fork->arena,
+                                fork->num_plants,
+                                SCENARIO_SHARED_MIN_POWERS |
+                                SCENARIO_SHARED_MAX_POWERS);
+  fork->zones = scenario_fork_table(&fork->arena,
+                                    parent->zones,
+                                    parent->num_zones,
+                                    sizeof(struct Zone));
+  fork->num_zones = fork->zones_capacity = parent->num_zones;
+  symbol_index_reserve(&fork->zone_index, fork->num_zones);
+  for (unsigned int z = 0; z < fork->num_zones; ++z)
+    symbol_index_insert(&fork->zone_index, fork->zones[z].symbol, z);
+  fork->num_inherited_zones = fork->num_zones;
+  fork->shared_zone_series =
+    scenario_fork_shared_series(&fork->arena,
+                                fork->num_zones,
+                                SCENARIO_SHARED_EXPECTED_DEMANDS);
+}
+
+void scenario_initialize_with_series(struct Scenario* scenario,
+                                     const struct Timeline* timeline,
+                                     unsigned int num_plants,
+                                     unsigned int num_zones,
+                                     const stored_mw* min_powers,
+                                     const stored_mw* max_powers,
+                                     const stored_mw* expected_demands) {
+  scenario_initialize(scenario, timeline);
+  if (num_plants > 0) {
+    scenario->plants = arena_allocate(&scenario->arena,
+                                      num_plants * sizeof(struct Plant),
+                                      _Alignof(max_align_t));
+    scenario->plants_capacity = num_plants;
+    scenario->min_powers = (stored_mw*)min_powers;
+    scenario->max_powers = (stored_mw*)max_powers;
+  }
+  scenario->num_inherited_plants = num_plants;
+  scenario->shared_plant_series =
+    scenario_fork_shared_series(&scenario->arena,
+                                num_plants,
+                                SCENARIO_SHARED_MIN_POWERS |
+                                SCENARIO_SHARED_MAX_POWERS);
+  if (num_zones > 0) {
+    scenario->zones = arena_allocate(&scenario->arena,
+                                     num_zones * sizeof(struct Zone),
+                                     _Alignof(max_align_t));
+    scenario->zones_capacity = num_zones;
+    scenario->expected_demands = (stored_mw*)expected_demands;
+  }
+  scenario->num_inherited_zones = num_zones;
+  scenario->shared_zone_series =
+    scenario_fork_shared_series(&scenario->arena,
+                                num_zones,
+                                SCENARIO_SHARED_EXPECTED_DEMANDS);
 }
 
 void scenario_from_json(struct Scenario* scenario, json_t* j) {
   ensure_json_is_object(j);
   ensure_json_object_contains_key(j, JSON_SCENARIO_TIMELINE);
   json_t* j_timeline = json_object_get(j, JSON_SCENARIO_TIMELINE);
-  struct Timeline timeline;
-  timeline_from_json(&timeline, j_timeline);
-  scenario_initialize(scenario, &timeline);
-  timeline_free(&timeline);
+  const struct Timeline* timeline = timeline_from_json(j_timeline);
+  scenario_initialize(scenario, timeline);
+  timeline_release(timeline);
   const json_t* j_zones = json_object_get(j, JSON_SCENARIO_ZONES);
   if (j_zones != NULL)
     scenario_add_zones_from_json(scenario, j_zones);
@@ -110,47 +460,215 @@ void scenario_from_json(struct Scenario* scenario, json_t* j) {
 // -----------
 
 void scenario_free(struct Scenario* scenario) {
-  for (int p = 0; p < scenario->num_plants; ++p)
-    plant_free(scenario->plants + p);
-  for (int z = 0; z < scenario->num_zones; ++z)
-    zone_free(scenario->zones + z);
-  timeline_free(&scenario->timeline);
+  arena_delete(&scenario->arena);
+  timeline_release(scenario->timeline);
 }
 
 // Modifiers
 // ---------
 
+void scenario_reserve(struct Scenario* scenario,
+                      unsigned int num_links,
+                      unsigned int num_plants,
+                      unsigned int num_zones) {
+  scenario->links = scenario_grow_table(&scenario->arena,
+                                        scenario->links,
+                                        &scenario->links_capacity,
+                                        num_links,
+                                        sizeof(struct Link));
+  symbol_index_reserve(&scenario->link_index, num_links);
+  unsigned int plants_capacity = scenario->plants_capacity;
+  scenario->plants = scenario_grow_table(&scenario->arena,
+                                         scenario->plants,
+                                         &scenario->plants_capacity,
+                                         num_plants,
+                                         sizeof(struct Plant));
+  symbol_index_reserve(&scenario->plant_index, num_plants);
+  if (scenario->plants_capacity != plants_capacity)
+    scenario_move_plant_series(
+      scenario,
+      scenario_allocate_series(&scenario->arena,
+                               scenario->plants_capacity,
+                               scenario->series_stride),
+      scenario_allocate_series(&scenario->arena,
+                               scenario->plants_capacity,
+                               scenario->series_stride));
+  unsigned int zones_capacity = scenario->zones_capacity;
+  scenario->zones = scenario_grow_table(&scenario->arena,
+                                        scenario->zones,
+                                        &scenario->zones_capacity,
+                                        num_zones,
+                                        sizeof(struct Zone));
+  symbol_index_reserve(&scenario->zone_index, num_zones);
+  if (scenario->zones_capacity != zones_capacity)
+    scenario_move_zone_series(
+      scenario,
+      scenario_allocate_series(&scenario->arena,
+                               scenario->zones_capacity,
+                               scenario->series_stride));
+}
+
 void scenario_add_link(struct Scenario* scenario, const struct Link* link) {
-  link_copy(scenario->links + scenario->num_links, link);
-  ++scenario->num_links;
+  scenario_emplace_link(scenario, link->id, link->source, link->target);
 }
 
 void scenario_add_plant(struct Scenario* scenario,
                         const struct Plant* plant) {
-  plant_copy(scenario->plants + scenario->num_plants, plant);
-  ++scenario->num_plants;
+  size_t num_values = scenario->timeline->num_future_timesteps;
+  struct Plant* dest = scenario_emplace_plant(scenario, plant->id, plant->zone);
+  memcpy(dest->min_powers, plant->min_powers, num_values * sizeof(stored_mw));
+  memcpy(dest->max_powers, plant->max_powers, num_values * sizeof(stored_mw));
 }
 
 void scenario_add_zone(struct Scenario* scenario,
                        const struct Zone* zone) {
-  zone_copy(scenario->zones + scenario->num_zones, zone);
+  size_t num_values = scenario->timeline->num_future_timesteps;
+  struct Zone* dest = scenario_emplace_zone(scenario, zone->id);
+  memcpy(dest->expected_demands,
+         zone->expected_demands,
+         num_values * sizeof(stored_mw));
+}
+
+struct Link* scenario_emplace_link(struct Scenario* scenario,
+                                   const char* id,
+                                   unsigned int source,
+                                   unsigned int target) {
+  scenario_reserve(scenario,
+                   scenario->num_links + 1,
+                   scenario->num_plants,
+                   scenario->num_zones);
+  struct Link* link = scenario->links + scenario->num_links;
+  link_initialize(link, id, source, target);
+  symbol_index_insert(&scenario->link_index, link->symbol, scenario->num_links);
+  ++scenario->num_links;
+  return link;
+}
+
+struct Plant* scenario_emplace_plant(struct Scenario* scenario,
+                                     const char* id,
+                                     unsigned int zone) {
+  scenario_reserve(scenario,
+                   scenario->num_links,
+                   scenario->num_plants + 1,
+                   scenario->num_zones);
+  size_t row = (size_t)scenario->num_plants * scenario->series_stride;
+  struct Plant* plant = scenario->plants + scenario->num_plants;
+  strncpy(plant->id, id, ID_MAX_LENGTH);
+  plant->id[ID_MAX_LENGTH] = '\0';
+  plant->symbol = symbol_table_intern(symbol_table_shared(), id);
+  plant->timeline = scenario->timeline;
+  plant->zone = zone;
+  plant->min_powers = scenario->min_powers + row;
+  plant->max_powers = scenario->max_powers + row;
+  symbol_index_insert(&scenario->plant_index,
+                      plant->symbol,
+                      scenario->num_plants);
+  ++scenario->num_plants;
+  return plant;
+}
+
+struct Zone* scenario_emplace_zone(struct Scenario* scenario, const char* id) {
+  scenario_reserve(scenario,
+                   scenario->num_links,
+                   scenario->num_plants,
+                   scenario->num_zones + 1);
+  size_t row = (size_t)scenario->num_zones * scenario->series_stride;
+  struct Zone* zone = scenario->zones + scenario->num_zones;
+  strncpy(zone->id, id, ID_MAX_LENGTH);
+  zone->id[ID_MAX_LENGTH] = '\0';
+  zone->symbol = symbol_table_intern(symbol_table_shared(), id);
+  zone->timeline = scenario->timeline;
+  zone->expected_demands = scenario->expected_demands + row;
+  symbol_index_insert(&scenario->zone_index, zone->symbol, scenario->num_zones);
   ++scenario->num_zones;
+  return zone;
+}
+
+stored_mw* scenario_modify_plant_min_powers(struct Scenario* scenario,
+                                           unsigned int p) {
+  return scenario_unshare_series(scenario,
+                                 &scenario->plants[p].min_powers,
+                                 p < scenario->num_inherited_plants ?
+                                 scenario->shared_plant_series + p :
+                                 NULL,
+                                 SCENARIO_SHARED_MIN_POWERS);
+}
+
+stored_mw* scenario_modify_plant_max_powers(struct Scenario* scenario,
+                                           unsigned int p) {
+  return scenario_unshare_series(scenario,
+                                 &scenario->plants[p].max_powers,
+                                 p < scenario->num_inherited_plants ?
+                                 scenario->shared_plant_series + p :
+                                 NULL,
+                                 SCENARIO_SHARED_MAX_POWERS);
+}
+
+stored_mw* scenario_modify_zone_expected_demands(struct Scenario* scenario,
+                                                unsigned int z) {
+  return scenario_unshare_series(scenario,
+                                 &scenario->zones[z].expected_demands,
+                                 z < scenario->num_inherited_zones ?
+                                 scenario->shared_zone_series + z :
+                                 NULL,
+                                 SCENARIO_SHARED_EXPECTED_DEMANDS);
 }
 
 // Accessors
 // ---------
 
+int scenario_link_index_by_id(const struct Scenario* scenario,
+                              const char* id) {
+  return scenario_component_index_by_id(&scenario->link_index, id);
+}
+
+const struct Link* scenario_link_by_id(const struct Scenario* scenario,
+                                       const char* id) {
+  int l = scenario_link_index_by_id(scenario, id);
+  return l < 0 ? NULL : scenario->links + l;
+}
+
+int scenario_plant_index_by_id(const struct Scenario* scenario,
+                               const char* id) {
+  return scenario_component_index_by_id(&scenario->plant_index, id);
+}
+
+const struct Plant* scenario_plant_by_id(const struct Scenario* scenario,
+                                         const char* id) {
+  int p = scenario_plant_index_by_id(scenario, id);
+  return p < 0 ? NULL : scenario->plants + p;
+}
+
+int scenario_zone_index_by_id(const struct Scenario* scenario,
+                              const char* id) {
+  return scenario_component_index_by_id(&scenario->zone_index, id);
+}
+
 const struct Zone* scenario_zone_by_id(const struct Scenario* scenario,
                                        const char* id) {
-  for (int z = 0; z < scenario->num_zones; ++z)
-    if (strcmp(scenario->zones[z].id, id) == 0)
-      return scenario->zones + z;
-  return NULL;
+  int z = scenario_zone_index_by_id(scenario, id);
+  return z < 0 ? NULL : scenario->zones + z;
+}
+
+const stored_mw* scenario_plant_min_powers(const struct Scenario* scenario,
+                                           unsigned int p) {
+  return scenario->plants[p].min_powers;
+}
+
+const stored_mw* scenario_plant_max_powers(const struct Scenario* scenario,
+                                           unsigned int p) {
+  return scenario->plants[p].max_powers;
+}
+
+const stored_mw* scenario_zone_expected_demands(
+  const struct Scenario* scenario,
+  unsigned int z) {
+  return scenario->zones[z].expected_demands;
 }
 
 bool scenario_are_equal(const struct Scenario* scenario1,
                         const struct Scenario* scenario2) {
-  if (!timeline_are_equal(&scenario1->timeline, &scenario2->timeline))
+  if (!timeline_are_equal(scenario1->timeline, scenario2->timeline))
     return false;
   if (scenario1->num_links != scenario2->num_links)
     return false;
@@ -172,9 +690,9 @@ bool scenario_are_equal(const struct Scenario* scenario1,
 
 void scenario_print(const struct Scenario* scenario) {
   printf("A scenario with the following components:\n  ");
-  timeline_print(&scenario->timeline);
+  timeline_print(scenario->timeline);
   for (unsigned int p = 0; p < scenario->num_plants; ++p)
-    plant_print(scenario->plants + p);
+    plant_print(scenario->plants + p, scenario->zones);
   for (unsigned int z = 0; z < scenario->num_zones; ++z)
     zone_print(scenario->zones + z);
 }
@@ -185,10 +703,12 @@ void scenario_print(const struct Scenario* scenario) {
 json_t* scenario_to_json(const struct Scenario* scenario) {
   json_t* jlinks = json_array();
   for (int l = 0; l < scenario->num_links; ++l)
-    json_array_append_new(jlinks, link_to_json(scenario->links + l));
+    json_array_append_new(jlinks,
+                          link_to_json(scenario->links + l, scenario->zones));
   json_t* jplants = json_array();
   for (int p = 0; p < scenario->num_plants; ++p)
-    json_array_append_new(jplants, plant_to_json(scenario->plants + p));
+    json_array_append_new(jplants,
+                          plant_to_json(scenario->plants + p, scenario->zones));
   json_t* jzones = json_array();
   for (int z = 0; z < scenario->num_zones; ++z)
     json_array_append_new(jzones, zone_to_json(scenario->zones + z));
@@ -198,7 +718,7 @@ json_t* scenario_to_json(const struct Scenario* scenario) {
                    JSON_SCENARIO_PLANTS,
                    jplants,
                    JSON_SCENARIO_TIMELINE,
-                   timeline_to_json(&scenario->timeline),
+                   timeline_to_json(scenario->timeline),
                    JSON_SCENARIO_ZONES,
                    jzones);
 }
@@ -8,6 +8,9 @@
 #include "component/zone.h"
 #include "constants.h"
 #include "timeline.h"
+#include "unit.h"
+#include "utils/arena.h"
+#include "utils/symbol_index.h"
 
 // JSON keys
 // ---------
@@ -20,21 +23,78 @@
 // Type
 // ----
 
+// Components are stored in growable tables. Plants and links refer to zones by
+// their index in the zone table, so that growing a table never invalidates
+// these references.
+//
+// The time series of the components are stored in matrices owned by the
+// scenario, with one row per component and one column per timestep. Rows are
+// padded to `series_stride` values so that each of them starts on a
+// SERIES_ALIGNMENT boundary. The series of the plants and zones of a scenario
+// are views into these matrices: they are released with the scenario and must
+// not be freed with plant_free or zone_free. Likewise, the plants and zones of
+// a scenario share the reference of the scenario to its timeline.
+//
+// Each component table is indexed by the symbols of the identifiers of its
+// components, so that components are found by identifier in constant time.
+//
+// The tables, matrices and indices are allocated from an arena owned by the
+// scenario, and are all released at once by scenario_free. A scenario must
+// therefore not be copied by value.
+//
+// A scenario forked from a parent scenario copies the component tables of its
+// parent, but shares all its series. A series is only copied to the arena of
+// the fork when it is first modified through scenario_modify_*, so that
+// variants differing by a few series cost little memory.
+// scenario_initialize_with_series shares external matrices, such as those of a
+// mapped snapshot file, in the same way.
 struct Scenario {
   // The reference timeline
-  struct Timeline timeline;
+  const struct Timeline* timeline;
+  // The arena from which the tables, matrices and indices are allocated
+  struct Arena arena;
   // The number of links considered in the scenario
   unsigned int num_links;
+  // The capacity of the link table
+  unsigned int links_capacity;
   // The links considered in the scenario
-  struct Link links[MAX_NUM_LINKS];
+  struct Link* links;
+  // The index of the links by symbol
+  struct SymbolIndex link_index;
   // The number of plants considered in the scenario
   unsigned int num_plants;
+  // The capacity of the plant table
+  unsigned int plants_capacity;
   // The plants considered in the scenario
-  struct Plant plants[MAX_NUM_PLANTS];
+  struct Plant* plants;
+  // The index of the plants by symbol
+  struct SymbolIndex plant_index;
   // The number of zones considered in the scenario
   unsigned int num_zones;
+  // The capacity of the zone table
+  unsigned int zones_capacity;
   // The zones considered in the scenario
-  struct Zone zones[MAX_NUM_ZONES];
+  struct Zone* zones;
+  // The index of the zones by symbol
+  struct SymbolIndex zone_index;
+  // The number of values between the starts of two rows of a series matrix
+  unsigned int series_stride;
+  // The minimum powers of the plants, one row per plant
+  stored_mw* min_powers;
+  // The maximum powers of the plants, one row per plant
+  stored_mw* max_powers;
+  // The expected demands of the zones, one row per zone
+  stored_mw* expected_demands;
+  // The scenario from which the scenario was forked, or NULL
+  const struct Scenario* parent;
+  // The number of plants inherited from the parent
+  unsigned int num_inherited_plants;
+  // The series still shared with the parent, for each inherited plant
+  unsigned char* shared_plant_series;
+  // The number of zones inherited from the parent
+  unsigned int num_inherited_zones;
+  // The series still shared with the parent, for each inherited zone
+  unsigned char* shared_zone_series;
 };
 
 // Initialization
@@ -49,6 +109,43 @@ struct Scenario {
 void scenario_initialize(struct Scenario* scenario,
                          const struct Timeline* timeline);
 
+/**
+ * Initializes a scenario as a fork of another scenario
+ *
+ * The fork has the same components as its parent and shares their series.
+ * The parent must outlive the fork, and its series must not be modified while
+ * the fork exists.
+ *
+ * @param fork    The scenario to initialize
+ * @param parent  The scenario to fork
+ */
+void scenario_fork(struct Scenario* fork, const struct Scenario* parent);
+
+/**
+ * Initializes a scenario whose series are views into external matrices
+ *
+ * The matrices have the layout of the matrices of the scenario. The first
+ * plants and zones added to the scenario take their rows in order, and share
+ * them as a fork shares the series of its parent: a series is only copied to
+ * the scenario when first modified through scenario_modify_*. The matrices
+ * must outlive the scenario.
+ *
+ * @param scenario          The scenario to initialize
+ * @param timeline          The reference timeline
+ * @param num_plants        The number of rows of the plant matrices
+ * @param num_zones         The number of rows of the zone matrix
+ * @param min_powers        The minimum powers of the plants
+ * @param max_powers        The maximum powers of the plants
+ * @param expected_demands  The expected demands of the zones
+ */
+void scenario_initialize_with_series(struct Scenario* scenario,
+                                     const struct Timeline* timeline,
+                                     unsigned int num_plants,
+                                     unsigned int num_zones,
+                                     const stored_mw* min_powers,
+                                     const stored_mw* max_powers,
+                                     const stored_mw* expected_demands);
+
 /**
  * Initializes a scenario from a JSON value
  *
@@ -70,9 +167,28 @@ void scenario_free(struct Scenario* scenario);
 // Modifiers
 // ---------
 
+/**
+ * Ensures that a scenario can hold a given number of components
+ *
+ * Reserving the final sizes before adding components avoids any reallocation
+ * of the component tables while they are filled.
+ *
+ * @param scenario    The scenario
+ * @param num_links   The number of links to hold
+ * @param num_plants  The number of plants to hold
+ * @param num_zones   The number of zones to hold
+ */
+void scenario_reserve(struct Scenario* scenario,
+                      unsigned int num_links,
+                      unsigned int num_plants,
+                      unsigned int num_zones);
+
 /**
  * Adds a link to a scenario
  *
+ * The zones of the link must be given by their index in the scenario. If
+ * several links share an identifier, lookups by identifier return the first.
+ *
  * @param scenario  The scenario to which the link is added
  * @param link      The link to add
  */
@@ -81,6 +197,9 @@ void scenario_add_link(struct Scenario* scenario, const struct Link* link);
 /**
  * Adds a plant to a scenario
  *
+ * The zone of the plant must be given by its index in the scenario. If
+ * several plants share an identifier, lookups by identifier return the first.
+ *
  * @param scenario  The scenario to which the plant is added
  * @param plant     The plant to add
  */
@@ -90,15 +209,164 @@ void scenario_add_plant(struct Scenario* scenario,
 /**
  * Adds a zone to a scenario
  *
+ * If several zones share an identifier, lookups by identifier return the
+ * first.
+ *
  * @param scenario  The scenario to which the zone is added
  * @param zone      The zone to add
  */
 void scenario_add_zone(struct Scenario* scenario,
                        const struct Zone* zone);
 
+/**
+ * Adds a link to a scenario, in place
+ *
+ * The link is initialized directly in the link table of the scenario, without
+ * building a temporary link.
+ *
+ * @param scenario  The scenario to which the link is added
+ * @param id        The identifier of the link
+ * @param source    The index of the source zone of the link
+ * @param target    The index of the target zone of the link
+ * @return          The added link
+ */
+struct Link* scenario_emplace_link(struct Scenario* scenario,
+                                   const char* id,
+                                   unsigned int source,
+                                   unsigned int target);
+
+/**
+ * Adds a plant with unset series to a scenario, in place
+ *
+ * The series of the returned plant are rows of the series matrices of the
+ * scenario, to be filled by the caller before any other plant is added.
+ *
+ * @param scenario  The scenario to which the plant is added
+ * @param id        The identifier of the plant
+ * @param zone      The index of the zone in which the plant is located
+ * @return          The added plant
+ */
+struct Plant* scenario_emplace_plant(struct Scenario* scenario,
+                                     const char* id,
+                                     unsigned int zone);
+
+/**
+ * Adds a zone with an unset series to a scenario, in place
+ *
+ * The series of the returned zone is a row of the demand matrix of the
+ * scenario, to be filled by the caller before any other zone is added.
+ *
+ * @param scenario  The scenario to which the zone is added
+ * @param id        The identifier of the zone
+ * @return          The added zone
+ */
+struct Zone* scenario_emplace_zone(struct Scenario* scenario, const char* id);
+
+/**
+ * Returns the minimum powers of a plant of a scenario, for modification
+ *
+ * If the series is shared with the parent of a forked scenario, it is copied
+ * first, so that the parent is left unchanged. The result remains valid until
+ * a plant is added to the scenario.
+ *
+ * @param scenario  The scenario
+ * @param p         The index of the plant
+ * @return          The minimum powers of the plant for each timestep
+ */
+stored_mw* scenario_modify_plant_min_powers(struct Scenario* scenario,
+                                           unsigned int p);
+
+/**
+ * Returns the maximum powers of a plant of a scenario, for modification
+ *
+ * If the series is shared with the parent of a forked scenario, it is copied
+ * first, so that the parent is left unchanged. The result remains valid until
+ * a plant is added to the scenario.
+ *
+ * @param scenario  The scenario
+ * @param p         The index of the plant
+ * @return          The maximum powers of the plant for each timestep
+ */
+stored_mw* scenario_modify_plant_max_powers(struct Scenario* scenario,
+                                           unsigned int p);
+
+/**
+ * Returns the expected demands of a zone of a scenario, for modification
+ *
+ * If the series is shared with the parent of a forked scenario, it is copied
+ * first, so that the parent is left unchanged. The result remains valid until
+ * a zone is added to the scenario.
+ *
+ * @param scenario  The scenario
+ * @param z         The index of the zone
+ * @return          The expected demands of the zone for each timestep
+ */
+stored_mw* scenario_modify_zone_expected_demands(struct Scenario* scenario,
+                                                unsigned int z);
+
 // Accessors
 // ---------
 
+/**
+ * Returns the index of the link of a scenario with given identifier
+ *
+ * If no link has the given identifier, returns -1.
+ *
+ * @param scenario  The scenario
+ * @param id        The identifier of the link
+ * @return          The index of the link with given identifier or -1
+ */
+int scenario_link_index_by_id(const struct Scenario* scenario,
+                              const char* id);
+
+/**
+ * Returns the link of a scenario with given identifier
+ *
+ * If no link has the given identifier, returns NULL.
+ *
+ * @param scenario  The scenario
+ * @param id        The identifier of the link
+ * @return          The link with given identifier or NULL
+ */
+const struct Link* scenario_link_by_id(const struct Scenario* scenario,
+                                       const char* id);
+
+/**
+ * Returns the index of the plant of a scenario with given identifier
+ *
+ * If no plant has the given identifier, returns -1.
+ *
+ * @param scenario  The scenario
+ * @param id        The identifier of the plant
+ * @return          The index of the plant with given identifier or -1
+ */
+int scenario_plant_index_by_id(const struct Scenario* scenario,
+                               const char* id);
+
+/**
+ * Returns the plant of a scenario with given identifier
+ *
+ * If no plant has the given identifier, returns NULL.
+ *
+ * @param scenario  The scenario
+ * @param id        The identifier of the plant
+ * @return          The plant with given identifier or NULL
+ */
+const struct Plant* scenario_plant_by_id(const struct Scenario* scenario,
+                                         const char* id);
+
+/**
+ * Returns the index of the zone of a scenario with given identifier
+ *
+ * If no zone has the given identifier, returns -1.
+ *
+ * @param scenario  The scenario
+ * @param id        The identifier of the zone
+ * @return          The index of the zone with given identifier or -1
+ */
+int scenario_zone_index_by_id(const struct Scenario* scenario,
+                              const char* id);
+
 /**
  * Returns the zone of a scenario with given identifier
  *
@@ -111,6 +379,49 @@ void scenario_add_zone(struct Scenario* scenario,
 const struct Zone* scenario_zone_by_id(const struct Scenario* scenario,
                                        const char* id);
 
+/**
+ * Returns the minimum powers of a plant of a scenario
+ *
+ * The result is a view into the minimum power matrix of the scenario, or into
+ * the series of its parent, which remains valid until a plant is added to the
+ * scenario.
+ *
+ * @param scenario  The scenario
+ * @param p         The index of the plant
+ * @return          The minimum powers of the plant for each timestep
+ */
+const stored_mw* scenario_plant_min_powers(const struct Scenario* scenario,
+                                           unsigned int p);
+
+/**
+ * Returns the maximum powers of a plant of a scenario
+ *
+ * The result is a view into the maximum power matrix of the scenario, or into
+ * the series of its parent, which remains valid until a plant is added to the
+ * scenario.
+ *
+ * @param scenario  The scenario
+ * @param p         The index of the plant
+ * @return          The maximum powers of the plant for each timestep
+ */
+const stored_mw* scenario_plant_max_powers(const struct Scenario* scenario,
+                                           unsigned int p);
+
+/**
+ * Returns the expected demands of a zone of a scenario
+ *
+ * The result is a view into the demand matrix of the scenario, or into the
+ * series of its parent, which remains valid until a zone is added to the
+ * scenario.
+ *
+ * @param scenario  The scenario
+ * @param z         The index of the zone
+ * @return          The expected demands of the zone for each timestep
+ */
+const stored_mw* scenario_zone_expected_demands(
+  const struct Scenario* scenario,
+  unsigned int z);
+
 /**
  * Indicates if two scenarios are equal
  *
@@ -0,0 +1,126 @@
+#include "scenario_graph.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Help functions
+// --------------
+
+/**
+ * Groups components by zone with a counting sort
+ *
+ * The zone of each component is read as an unsigned int at a given offset in
+ * the component. Components of a same zone keep their relative order.
+ *
+ * @param num_zones       The number of zones
+ * @param components      The component table
+ * @param num_components  The number of components
+ * @param component_size  The size of a component
+ * @param zone_offset     The offset of the zone index in a component
+ * @param offsets         The start of each group, filled by the function, of
+ *                        size num_zones + 1
+ * @param grouped         The indices of the components grouped by zone,
+ *                        filled by the function, of size num_components
+ */
+void scenario_graph_group(unsigned int num_zones,
+                          const void* components,
+                          unsigned int num_components,
+                          size_t component_size,
+                          size_t zone_offset,
+                          unsigned int* offsets,
+                          unsigned int* grouped) {
+  const char* bytes = components;
+  memset(offsets, 0, (num_zones + 1) * sizeof(unsigned int));
+  for (unsigned int c = 0; c < num_components; ++c) {
+    unsigned int zone;
+    memcpy(&zone, bytes + c * component_size + zone_offset, sizeof(zone));
+    ++offsets[zone + 1];
+  }
+  for (unsigned int z = 0; z < num_zones; ++z)
+    offsets[z + 1] += offsets[z];
+  // Each offset is moved to the end of its group while placing components,
+  // then shifted back to the start
+  for (unsigned int c = 0; c < num_components; ++c) {
+    unsigned int zone;
+    memcpy(&zone, bytes + c * component_size + zone_offset, sizeof(zone));
+    grouped[offsets[zone]++] = c;
+  }
+  for (unsigned int z = num_zones; z > 0; --z)
+    offsets[z] = offsets[z - 1];
+  offsets[0] = 0;
+}
+
+// Initialization
+// --------------
+
+void scenario_graph_initialize(struct ScenarioGraph* graph,
+                               const struct Scenario* scenario) {
+  unsigned int num_zones = scenario->num_zones;
+  unsigned int num_plants = scenario->num_plants;
+  unsigned int num_links = scenario->num_links;
+  size_t size = 3 * ((size_t)num_zones + 1) + num_plants + 2 * num_links;
+  unsigned int* buffer = malloc(size * sizeof(unsigned int));
+  graph->num_zones = num_zones;
+  graph->plant_offsets = buffer;
+  graph->outgoing_offsets = graph->plant_offsets + num_zones + 1;
+  graph->incoming_offsets = graph->outgoing_offsets + num_zones + 1;
+  graph->plants = graph->incoming_offsets + num_zones + 1;
+  graph->outgoing_links = graph->plants + num_plants;
+  graph->incoming_links = graph->outgoing_links + num_links;
+  scenario_graph_group(num_zones,
+                       scenario->plants,
+                       num_plants,
+                       sizeof(struct Plant),
+                       offsetof(struct Plant, zone),
+                       graph->plant_offsets,
+                       graph->plants);
+  scenario_graph_group(num_zones,
+                       scenario->links,
+                       num_links,
+                       sizeof(struct Link),
+                       offsetof(struct Link, source),
+                       graph->outgoing_offsets,
+                       graph->outgoing_links);
+  scenario_graph_group(num_zones,
+                       scenario->links,
+                       num_links,
+                       sizeof(struct Link),
+                       offsetof(struct Link, target),
+                       graph->incoming_offsets,
+                       graph->incoming_links);
+}
+
+// Destruction
+// -----------
+
+void scenario_graph_free(struct ScenarioGraph* graph) {
+  free(graph->plant_offsets);
+}
+
+// Accessors
+// ---------
+
+const unsigned int* scenario_graph_zone_plants(
+  const struct ScenarioGraph* graph,
+  unsigned int z,
+  unsigned int* num_plants) {
+  *num_plants = graph->plant_offsets[z + 1] - graph->plant_offsets[z];
+  return graph->plants + graph->plant_offsets[z];
+}
+
+const unsigned int* scenario_graph_outgoing_links(
+  const struct ScenarioGraph* graph,
+  unsigned int z,
+  unsigned int* num_links) {
+  *num_links = graph->outgoing_offsets[z + 1] - graph->outgoing_offsets[z];
+  return graph->outgoing_links + graph->outgoing_offsets[z];
+}
+
+const unsigned int* scenario_graph_incoming_links(
+  const struct ScenarioGraph* graph,
+  unsigned int z,
+  unsigned int* num_links) {
+  *num_links = graph->incoming_offsets[z + 1] - graph->incoming_offsets[z];
+  return graph->incoming_links + graph->incoming_offsets[z];
+}
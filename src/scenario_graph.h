@@ -0,0 +1,102 @@
+#ifndef SCENARIO_GRAPH_H
+#define SCENARIO_GRAPH_H
+
+#include "scenario.h"
+
+// Type
+// ----
+
+// The network of a scenario, as adjacency lists indexed by zone
+//
+// The adjacency lists are stored in compressed sparse row form: the plants
+// located in zone z are the indices plants[plant_offsets[z]] up to
+// plants[plant_offsets[z + 1]] excluded, and likewise for the links leaving
+// and entering each zone. Within a list, components appear in the order of
+// their index in the scenario.
+//
+// The graph is a snapshot of the scenario when it was initialized: it must be
+// initialized again after components are added to the scenario.
+struct ScenarioGraph {
+  // The number of zones of the scenario
+  unsigned int num_zones;
+  // The start of the plants of each zone, plus the total number of plants
+  unsigned int* plant_offsets;
+  // The indices of the plants, grouped by zone
+  unsigned int* plants;
+  // The start of the links leaving each zone, plus the total number of links
+  unsigned int* outgoing_offsets;
+  // The indices of the links, grouped by source zone
+  unsigned int* outgoing_links;
+  // The start of the links entering each zone, plus the total number of links
+  unsigned int* incoming_offsets;
+  // The indices of the links, grouped by target zone
+  unsigned int* incoming_links;
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes the graph of a scenario
+ *
+ * The graph is built in time linear in the number of components.
+ *
+ * @param graph     The graph to initialize
+ * @param scenario  The scenario
+ */
+void scenario_graph_initialize(struct ScenarioGraph* graph,
+                               const struct Scenario* scenario);
+
+// Destruction
+// -----------
+
+/**
+ * Frees the graph of a scenario
+ *
+ * @param graph  The graph to free
+ */
+void scenario_graph_free(struct ScenarioGraph* graph);
+
+// Accessors
+// ---------
+
+/**
+ * Returns the plants located in a zone
+ *
+ * @param graph       The graph
+ * @param z           The index of the zone
+ * @param num_plants  The number of plants in the zone, set by the function
+ * @return            The indices of the plants in the zone
+ */
+const unsigned int* scenario_graph_zone_plants(
+  const struct ScenarioGraph* graph,
+  unsigned int z,
+  unsigned int* num_plants);
+
+/**
+ * Returns the links leaving a zone
+ *
+ * @param graph      The graph
+ * @param z          The index of the zone
+ * @param num_links  The number of links leaving the zone, set by the function
+ * @return           The indices of the links whose source is the zone
+ */
+const unsigned int* scenario_graph_outgoing_links(
+  const struct ScenarioGraph* graph,
+  unsigned int z,
+  unsigned int* num_links);
+
+/**
+ * Returns the links entering a zone
+ *
+ * @param graph      The graph
+ * @param z          The index of the zone
+ * @param num_links  The number of links entering the zone, set by the function
+ * @return           The indices of the links whose target is the zone
+ */
+const unsigned int* scenario_graph_incoming_links(
+  const struct ScenarioGraph* graph,
+  unsigned int z,
+  unsigned int* num_links);
+
+#endif
@@ -0,0 +1,216 @@
+#include "series.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "validation.h"
+
+// Help functions
+// --------------
+
+/**
+ * Indicates if a JSON time series is given by breakpoints
+ *
+ * @param j  The JSON array
+ * @return   true if and only if the series is compact
+ */
+bool series_json_is_compact(const json_t* j) {
+  return json_array_size(j) > 0 && json_is_object(json_array_get(j, 0));
+}
+
+/**
+ * Extends a piecewise constant time series with a value from a timestep
+ *
+ * A new run is only started if the value differs from the last one.
+ *
+ * @param series  The series
+ * @param t       The timestep, after the start of the last run
+ * @param value   The value from the timestep
+ */
+void series_extend(struct Series* series, unsigned int t, stored_mw value) {
+  if (series->num_runs == 0 || series->values[series->num_runs - 1] != value)
+    series_append(series, t, value);
+}
+
+/**
+ * Extends an empty piecewise constant time series with a JSON time series
+ *
+ * The JSON value must have been validated with series_validate_json.
+ *
+ * @param series  The series
+ * @param j       The JSON value
+ */
+void series_extend_from_json(struct Series* series, const json_t* j) {
+  bool compact = series_json_is_compact(j);
+  for (unsigned int i = 0; i < json_array_size(j); ++i) {
+    const json_t* j_value = json_array_get(j, i);
+    if (!compact) {
+      series_extend(series, i, mw_store(json_number_value(j_value)));
+      continue;
+    }
+    unsigned int from =
+      json_integer_value(json_object_get(j_value, JSON_SERIES_FROM));
+    mw value = json_number_value(json_object_get(j_value, JSON_SERIES_VALUE));
+    series_append(series, from, mw_store(value));
+  }
+}
+
+// Initialization
+// --------------
+
+void series_initialize(struct Series* series) {
+  series->num_runs = 0;
+  series->capacity = 0;
+  series->starts = NULL;
+  series->values = NULL;
+}
+
+void series_from_values(struct Series* series,
+                        unsigned int num_timesteps,
+                        const stored_mw* values) {
+  series_initialize(series);
+  for (unsigned int t = 0; t < num_timesteps; ++t)
+    series_extend(series, t, values[t]);
+}
+
+void series_from_json(struct Series* series,
+                      unsigned int num_timesteps,
+                      const json_t* j) {
+  series_validate_json(j, num_timesteps);
+  series_initialize(series);
+  series_extend_from_json(series, j);
+}
+
+// Destruction
+// -----------
+
+void series_free(struct Series* series) {
+  free(series->starts);
+  free(series->values);
+}
+
+// Modifiers
+// ---------
+
+void series_append(struct Series* series, unsigned int start, stored_mw value) {
+  if (series->num_runs == series->capacity) {
+    series->capacity = series->capacity == 0 ? 16 : 2 * series->capacity;
+    series->starts =
+      realloc(series->starts, series->capacity * sizeof(unsigned int));
+    series->values =
+      realloc(series->values, series->capacity * sizeof(stored_mw));
+  }
+  series->starts[series->num_runs] = start;
+  series->values[series->num_runs] = value;
+  ++series->num_runs;
+}
+
+// Accessors
+// ---------
+
+mw series_value_at(const struct Series* series, unsigned int t) {
+  unsigned int low = 0, high = series->num_runs - 1;
+  while (low < high) {
+    unsigned int middle = low + (high - low + 1) / 2;
+    if (series->starts[middle] <= t)
+      low = middle;
+    else
+      high = middle - 1;
+  }
+  return mw_load(series->values[low]);
+}
+
+void series_decode(const struct Series* series,
+                   unsigned int num_timesteps,
+                   stored_mw* values) {
+  for (unsigned int r = 0; r < series->num_runs; ++r) {
+    unsigned int end = r + 1 < series->num_runs ?
+                       series->starts[r + 1] :
+                       num_timesteps;
+    for (unsigned int t = series->starts[r]; t < end; ++t)
+      values[t] = series->values[r];
+  }
+}
+
+bool series_are_equal(const struct Series* series1,
+                      const struct Series* series2) {
+  if (series1->num_runs != series2->num_runs)
+    return false;
+  for (unsigned int r = 0; r < series1->num_runs; ++r) {
+    if (series1->starts[r] != series2->starts[r])
+      return false;
+    if (series1->values[r] != series2->values[r])
+      return false;
+  }
+  return true;
+}
+
+// Sequential decoding
+// -------------------
+
+void series_decoder_initialize(struct SeriesDecoder* decoder,
+                               const struct Series* series) {
+  decoder->series = series;
+  decoder->t = 0;
+  decoder->run = 0;
+}
+
+mw series_decoder_next(struct SeriesDecoder* decoder) {
+  const struct Series* series = decoder->series;
+  if (decoder->run + 1 < series->num_runs &&
+      series->starts[decoder->run + 1] == decoder->t)
+    ++decoder->run;
+  ++decoder->t;
+  return mw_load(series->values[decoder->run]);
+}
+
+// JSON serialization
+// ------------------
+
+void series_validate_json(const json_t* j, unsigned int num_timesteps) {
+  ensure_json_is_array(j);
+  if (!series_json_is_compact(j)) {
+    ensure_json_array_has_size(j, num_timesteps);
+    ensure_json_is_array_of_numbers(j);
+    return;
+  }
+  long previous_from = 0;
+  for (int i = 0; i < json_array_size(j); ++i) {
+    const json_t* j_breakpoint = json_array_get(j, i);
+    ensure_json_object_has_size(j_breakpoint, 2);
+    ensure_json_object_contains_key(j_breakpoint, JSON_SERIES_VALUE);
+    ensure_json_object_contains_key(j_breakpoint, JSON_SERIES_FROM);
+    ensure_json_is_number(json_object_get(j_breakpoint, JSON_SERIES_VALUE));
+    const json_t* j_from = json_object_get(j_breakpoint, JSON_SERIES_FROM);
+    ensure_json_is_integer(j_from);
+    long from = json_integer_value(j_from);
+    ensure_series_breakpoint_is_valid(i, from, previous_from, num_timesteps);
+    previous_from = from;
+  }
+}
+
+void series_values_from_json(const json_t* j,
+                             unsigned int num_timesteps,
+                             stored_mw* values) {
+  if (!series_json_is_compact(j)) {
+    for (unsigned int t = 0; t < num_timesteps; ++t)
+      values[t] = mw_store(json_number_value(json_array_get(j, t)));
+    return;
+  }
+  struct Series series;
+  series_initialize(&series);
+  series_extend_from_json(&series, j);
+  series_decode(&series, num_timesteps, values);
+  series_free(&series);
+}
+
+json_t* series_to_json(const struct Series* series) {
+  json_t* j = json_array();
+  for (unsigned int r = 0; r < series->num_runs; ++r)
+    json_array_append_new(j, json_pack("{s:f,s:i}",
+                                       JSON_SERIES_VALUE,
+                                       mw_load(series->values[r]),
+                                       JSON_SERIES_FROM,
+                                       (int)series->starts[r]));
+  return j;
+}
@@ -0,0 +1,212 @@
+#ifndef SERIES_H
+#define SERIES_H
+
+#include <stdbool.h>
+
+#include <jansson.h>
+
+#include "unit.h"
+
+// JSON keys
+// ---------
+
+#define JSON_SERIES_VALUE "value"
+#define JSON_SERIES_FROM "from"
+
+// Types
+// -----
+
+// A piecewise constant time series
+//
+// The series is stored as runs: run r has value values[r] from timestep
+// starts[r] up to the start of the next run, or up to the end of the timeline
+// for the last run. The starts are increasing, the first one being 0. A
+// series built from dense values has no two consecutive runs with the same
+// value, so that a constant series holds a single run whatever the length of
+// the timeline.
+//
+// In JSON, a series is either a dense array with one number per timestep, or
+// a compact array of breakpoints {"value": x, "from": t}, the first of which
+// starts at timestep 0.
+//
+// The plants and zones of a scenario do not hold series: their rows live in
+// the series matrices of the scenario, which forks share and snapshots map in
+// place, so compact JSON series are decoded into these rows when loaded. A
+// series is the compressed form for code working on a row outside a
+// scenario, such as the staged input of a JSON stream.
+struct Series {
+  // The number of runs
+  unsigned int num_runs;
+  // The number of runs the buffers can hold
+  unsigned int capacity;
+  // The first timestep of each run, in increasing order
+  unsigned int* starts;
+  // The value of each run
+  stored_mw* values;
+};
+
+// A sequential decoder of a piecewise constant time series
+struct SeriesDecoder {
+  // The decoded series
+  const struct Series* series;
+  // The next timestep to decode
+  unsigned int t;
+  // The run containing the next timestep
+  unsigned int run;
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes an empty piecewise constant time series
+ *
+ * @param series  The series to initialize
+ */
+void series_initialize(struct Series* series);
+
+/**
+ * Initializes a piecewise constant time series from dense values
+ *
+ * @param series         The series to initialize
+ * @param num_timesteps  The number of timesteps
+ * @param values         The value at each timestep
+ */
+void series_from_values(struct Series* series,
+                        unsigned int num_timesteps,
+                        const stored_mw* values);
+
+/**
+ * Initializes a piecewise constant time series from a JSON value
+ *
+ * The JSON value is either dense or compact. If it is not valid, prints an
+ * error message and exits the program.
+ *
+ * @param series         The series to initialize
+ * @param num_timesteps  The number of timesteps
+ * @param j              The JSON value
+ */
+void series_from_json(struct Series* series,
+                      unsigned int num_timesteps,
+                      const json_t* j);
+
+// Destruction
+// -----------
+
+/**
+ * Frees a piecewise constant time series
+ *
+ * @param series  The series to free
+ */
+void series_free(struct Series* series);
+
+// Modifiers
+// ---------
+
+/**
+ * Appends a run to a piecewise constant time series
+ *
+ * @param series  The series
+ * @param start   The first timestep of the run, after the start of the last
+ *                run
+ * @param value   The value of the run
+ */
+void series_append(struct Series* series, unsigned int start, stored_mw value);
+
+// Accessors
+// ---------
+
+/**
+ * Returns the value of a piecewise constant time series at a timestep
+ *
+ * The run containing the timestep is found by binary search, in O(log k) time
+ * for k runs.
+ *
+ * @param series  The series, with at least one run
+ * @param t       The timestep
+ * @return        The value of the series at the timestep
+ */
+mw series_value_at(const struct Series* series, unsigned int t);
+
+/**
+ * Writes the values of a piecewise constant time series at every timestep
+ *
+ * @param series         The series, whose runs start within the timeline
+ * @param num_timesteps  The number of timesteps
+ * @param values         The values, filled by the function, with room for a
+ *                       value per timestep
+ */
+void series_decode(const struct Series* series,
+                   unsigned int num_timesteps,
+                   stored_mw* values);
+
+/**
+ * Indicates if two piecewise constant time series have the same runs
+ *
+ * @param series1  The first series
+ * @param series2  The second series
+ * @return         true if and only if the series have the same runs
+ */
+bool series_are_equal(const struct Series* series1,
+                      const struct Series* series2);
+
+// Sequential decoding
+// -------------------
+
+/**
+ * Initializes a sequential decoder at the first timestep of a series
+ *
+ * @param decoder  The decoder to initialize
+ * @param series   The series to decode, with at least one run
+ */
+void series_decoder_initialize(struct SeriesDecoder* decoder,
+                               const struct Series* series);
+
+/**
+ * Returns the value of a series at the next timestep of a decoder
+ *
+ * Each call takes constant time. The decoder must not be past the last
+ * timestep.
+ *
+ * @param decoder  The decoder
+ * @return         The value at the next timestep
+ */
+mw series_decoder_next(struct SeriesDecoder* decoder);
+
+// JSON serialization
+// ------------------
+
+/**
+ * Ensures that a JSON value is a valid time series
+ *
+ * If not, prints an error message and exits the program. A dense series is
+ * checked exactly as an array of numbers with one value per timestep.
+ *
+ * @param j              The JSON value
+ * @param num_timesteps  The number of timesteps
+ */
+void series_validate_json(const json_t* j, unsigned int num_timesteps);
+
+/**
+ * Writes the values of a JSON time series at every timestep
+ *
+ * The JSON value must have been validated with series_validate_json.
+ *
+ * @param j              The JSON value
+ * @param num_timesteps  The number of timesteps
+ * @param values         The values, filled by the function, with room for a
+ *                       value per timestep
+ */
+void series_values_from_json(const json_t* j,
+                             unsigned int num_timesteps,
+                             stored_mw* values);
+
+/**
+ * Converts a piecewise constant time series to a compact JSON value
+ *
+ * @param series  The series to convert
+ * @return        The JSON array of breakpoints
+ */
+json_t* series_to_json(const struct Series* series);
+
+#endif
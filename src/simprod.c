@@ -1,11 +1,16 @@
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include <jansson.h>
-
 #include "component/link.h"
 #include "component/zone.h"
+#include "io/arrow_writer.h"
+#include "io/binary_plan.h"
+#include "io/csv_input.h"
+#include "io/json_input.h"
+#include "io/json_output.h"
+#include "io/snapshot.h"
 #include "plan.h"
 #include "scenario.h"
 #include "timeline.h"
@@ -18,7 +23,7 @@
     simprod - simulate the energy production and transport through a network\n\
 \n\
 SYNOPSIS\n\
-    simprod [target] [arguments] \n\
+    simprod [target] [options] [arguments] \n\
 \n\
 DESCRIPTION\n\
     Without argument, shows this help.\n\
@@ -26,14 +31,72 @@ DESCRIPTION\n\
     If the target is 'plan', the program displays information about a plan on\n\
     stdout. If no argument is provided, a plan on an empty scenario is used.\n\
     Otherwise, a valid JSON filepath can be provided, containing the plan to\n\
-    be loaded.\n\
+    be loaded. A binary plan can be provided instead of a JSON file.\n\
 \n\
     If the target is 'scenario', the program displays information about a\n\
     scenario on stdout. If no argument is provided, an empty scenario is\n\
     used. Otherwise, a valid JSON filepath can be provided, containing the\n\
-    scenario to be loaded.\n\
+    scenario to be loaded. A binary snapshot of a scenario can be provided\n\
+    instead of a JSON file.\n\
+\n\
+    If the target is 'convert', two arguments are expected: an input file and\n\
+    an output file. A JSON plan or scenario is converted to the binary format\n\
+    given by the extension of the output file ('.simplan' for a plan,\n\
+    '.simprod' for a scenario), and a binary file is converted to JSON. This\n\
+    target takes no option.\n\
+\n\
+OPTIONS\n\
+    -o FILE, --output FILE\n\
+        Writes the output to FILE instead of stdout.\n\
+\n\
+    --format FORMAT\n\
+        Writes the output in FORMAT: 'json' (default), or 'bin' for a binary\n\
+        plan ('.simplan' file) or a binary snapshot of a scenario ('.simprod'\n\
+        file), which are mapped in memory when loaded. For the 'plan' target,\n\
+        FORMAT can also be 'arrow' for an Arrow IPC stream with one row per\n\
+        plant and timestep.\n\
+\n\
+    --topology FILE\n\
+        For the 'scenario' target, loads the scenario from the topology FILE,\n\
+        whose time series are given by CSV files, one column per component\n\
+        and one row per timestep.\n\
+\n\
+    --compact\n\
+        Writes JSON output without any whitespace. Only valid with the 'json'\n\
+        format.\n\
+\n\
+    --precision N\n\
+        Writes the reals of JSON output with N significant digits, between 1\n\
+        and 17. By default, reals are written with the fewest digits that\n\
+        read back to the same values. Only valid with the 'json' format.\n\
 \n"
 
+// Options
+// -------
+
+// The output formats
+enum OutputFormat {
+  OUTPUT_FORMAT_JSON,  // Indented JSON
+  OUTPUT_FORMAT_BIN,   // Binary plan or scenario snapshot
+  OUTPUT_FORMAT_ARROW  // Arrow IPC stream of a plan
+};
+
+// The options of a target
+struct Options {
+  // The input file, or NULL if not provided
+  const char* input_filename;
+  // Whether the input file is a topology with CSV time series
+  bool is_topology;
+  // The output file, or NULL for stdout
+  const char* output_filename;
+  // The output format
+  enum OutputFormat format;
+  // Whether JSON output is written without whitespace
+  bool compact;
+  // The number of significant digits of reals, or 0 for the shortest digits
+  int precision;
+};
+
 // Errors
 // ------
 
@@ -56,12 +119,105 @@ void report_error_too_many_arguments(const char* target) {
 }
 
 /**
- * Reports an error about loading a JSON value from a file
+ * Reports an error about an invalid option
+ *
+ * @param target  The invoked target
+ * @param option  The invalid option
+ */
+void report_error_invalid_option(const char* target, const char* option) {
+  fprintf(stderr, "Invalid option for target '%s': %s\n", target, option);
+  fprintf(stderr, USAGE);
+}
+
+/**
+ * Reports an error about missing arguments
+ *
+ * @param target  The invoked target
+ */
+void report_error_missing_arguments(const char* target) {
+  fprintf(stderr, "Missing arguments for target '%s'\n", target);
+  fprintf(stderr, USAGE);
+}
+
+/**
+ * Reports an error about an unsupported conversion
+ *
+ * @param input_filename   The path of the input file
+ * @param output_filename  The path of the output file
+ */
+void report_error_unsupported_conversion(const char* input_filename,
+                                         const char* output_filename) {
+  fprintf(stderr,
+          "Unsupported conversion from %s to %s: one file must be binary "
+          "('%s' or '%s') and the other JSON\n",
+          input_filename, output_filename,
+          BINARY_PLAN_EXTENSION, SNAPSHOT_EXTENSION);
+}
+
+/**
+ * Reports an error about an unsupported output format
+ *
+ * @param target  The invoked target
+ * @param format  The requested format
+ */
+void report_error_unsupported_format(const char* target, const char* format) {
+  fprintf(stderr, "Unsupported format for target '%s': %s\n", target, format);
+}
+
+/**
+ * Reports an error about an option that only applies to JSON output
+ *
+ * @param target  The invoked target
+ * @param option  The option
+ */
+void report_error_json_only_option(const char* target, const char* option) {
+  fprintf(stderr,
+          "Option %s for target '%s' only applies to the 'json' format\n",
+          option, target);
+}
+
+/**
+ * Reports an error about an invalid precision
  *
- * @param error  The error found by Jansson
+ * @param target     The invoked target
+ * @param precision  The requested precision
  */
-void report_error_loading_json_from_file(json_error_t error) {
-  fprintf(stderr, "Problem while loading JSON file: %s\n", error.text);
+void report_error_invalid_precision(const char* target,
+                                    const char* precision) {
+  fprintf(stderr,
+          "Invalid precision for target '%s': %s (expected an integer "
+          "between 1 and %d)\n",
+          target, precision, JSON_WRITER_MAX_PRECISION);
+}
+
+/**
+ * Reports an error about opening an output file
+ *
+ * @param filename  The path of the file
+ */
+void report_error_opening_output_file(const char* filename) {
+  fprintf(stderr, "Problem while writing file: unable to open %s: %s\n",
+          filename, strerror(errno));
+}
+
+/**
+ * Reports an error about writing an output file
+ *
+ * @param filename  The path of the file, or NULL for stdout
+ */
+void report_error_writing_output_file(const char* filename) {
+  fprintf(stderr, "Problem while writing file: unable to write %s: %s\n",
+          filename == NULL ? "standard output" : filename, strerror(errno));
+}
+
+/**
+ * Reports an error about opening an input file
+ *
+ * @param filename  The path of the file
+ */
+void report_error_opening_input_file(const char* filename) {
+  fprintf(stderr, "Problem while loading file: unable to open %s: %s\n",
+          filename, strerror(errno));
 }
 
 // Targets
@@ -75,7 +231,21 @@ void report_error_loading_json_from_file(json_error_t error) {
  */
 bool is_target_supported(const char* target) {
   return strcmp(target, "scenario") == 0 ||
-         strcmp(target, "plan") == 0;
+         strcmp(target, "plan") == 0 ||
+         strcmp(target, "convert") == 0;
+}
+
+/**
+ * Indicates if a path ends with a given extension
+ *
+ * @param filename   The path
+ * @param extension  The extension, with its dot
+ * @return           true if and only if the path ends with the extension
+ */
+bool has_extension(const char* filename, const char* extension) {
+  size_t length = strlen(filename), extension_length = strlen(extension);
+  return length > extension_length &&
+         strcmp(filename + length - extension_length, extension) == 0;
 }
 
 /**
@@ -85,43 +255,276 @@ bool is_target_supported(const char* target) {
  */
 void initialize_empty_scenario(struct Scenario* scenario) {
   int durations[] = {};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 0, durations);
-  scenario_initialize(scenario, &timeline);
+  const struct Timeline* timeline = timeline_create(0, durations);
+  scenario_initialize(scenario, timeline);
+  timeline_release(timeline);
 }
 
 /**
- * Processes the 'plan' target
+ * Opens an input file
+ *
+ * If the file cannot be opened, reports the error and exits the program.
+ *
+ * @param filename  The path of the file
+ * @return          The opened file, to be closed by the caller
  */
-void process_plan_target(int argc, char* argv[]) {
-  if (argc >= 4) {
-    report_error_too_many_arguments("plan");
+FILE* open_input_file(const char* filename) {
+  FILE* file = fopen(filename, "r");
+  if (file == NULL) {
+    report_error_opening_input_file(filename);
     exit(1);
   }
+  return file;
+}
 
-  json_t* json_output;
-  struct Plan plan;
-  if (argc == 2) {
-    struct Timeline timeline;
-    timeline_initialize(&timeline, 0, NULL);
-    plan_initialize(&plan, &timeline);
-    timeline_free(&timeline);
-    json_output = plan_to_json(&plan);
-  } else {
-    const char* input_filename = argv[2];
-    json_error_t error;
-    json_t* json_input = json_load_file(input_filename, 0, &error);
-    if (!json_input) {
-      report_error_loading_json_from_file(error);
+/**
+ * Initializes options to their default values
+ *
+ * @param options  The options to initialize
+ */
+void initialize_default_options(struct Options* options) {
+  options->input_filename = NULL;
+  options->is_topology = false;
+  options->output_filename = NULL;
+  options->format = OUTPUT_FORMAT_JSON;
+  options->compact = false;
+  options->precision = 0;
+}
+
+/**
+ * Parses the value of the --precision option
+ *
+ * If it is invalid, reports the error and exits the program.
+ *
+ * @param target  The invoked target
+ * @param value   The value of the option
+ * @return        The precision
+ */
+int parse_precision(const char* target, const char* value) {
+  char* end;
+  long precision = strtol(value, &end, 10);
+  if (end == value || *end != '\0' || precision < 1 ||
+      precision > JSON_WRITER_MAX_PRECISION) {
+    report_error_invalid_precision(target, value);
+    exit(1);
+  }
+  return (int)precision;
+}
+
+/**
+ * Parses the options and arguments of a target
+ *
+ * If they are invalid, reports the error and exits the program.
+ *
+ * @param target   The invoked target
+ * @param argc     The number of application arguments
+ * @param argv     The application arguments
+ * @param options  The parsed options
+ */
+void parse_options(const char* target,
+                   int argc,
+                   char* argv[],
+                   struct Options* options) {
+  initialize_default_options(options);
+  for (int i = 2; i < argc; ++i) {
+    const char* arg = argv[i];
+    bool is_output = strcmp(arg, "-o") == 0 || strcmp(arg, "--output") == 0;
+    bool is_format = strcmp(arg, "--format") == 0;
+    bool is_precision = strcmp(arg, "--precision") == 0;
+    bool is_topology = strcmp(arg, "--topology") == 0;
+    if ((is_output || is_format || is_precision || is_topology) &&
+        i + 1 == argc) {
+      report_error_invalid_option(target, arg);
+      exit(1);
+    } else if (is_topology && strcmp(target, "scenario") != 0) {
+      report_error_invalid_option(target, arg);
+      exit(1);
+    } else if (is_topology && options->input_filename != NULL) {
+      report_error_too_many_arguments(target);
       exit(1);
+    } else if (is_topology) {
+      options->input_filename = argv[++i];
+      options->is_topology = true;
+    } else if (is_output) {
+      options->output_filename = argv[++i];
+    } else if (is_format && strcmp(argv[i + 1], "json") == 0) {
+      options->format = OUTPUT_FORMAT_JSON;
+      ++i;
+    } else if (is_format && strcmp(argv[i + 1], "bin") == 0) {
+      options->format = OUTPUT_FORMAT_BIN;
+      ++i;
+    } else if (is_format && strcmp(argv[i + 1], "arrow") == 0 &&
+               strcmp(target, "plan") == 0) {
+      options->format = OUTPUT_FORMAT_ARROW;
+      ++i;
+    } else if (is_format) {
+      report_error_unsupported_format(target, argv[i + 1]);
+      exit(1);
+    } else if (is_precision) {
+      options->precision = parse_precision(target, argv[++i]);
+    } else if (strcmp(arg, "--compact") == 0) {
+      options->compact = true;
+    } else if (arg[0] == '-' && arg[1] != '\0') {
+      report_error_invalid_option(target, arg);
+      exit(1);
+    } else if (options->input_filename != NULL) {
+      report_error_too_many_arguments(target);
+      exit(1);
+    } else {
+      options->input_filename = arg;
     }
-    plan_from_json(&plan, json_input);
-    json_decref(json_input);
-    json_output = plan_to_json(&plan);
   }
-  json_dumpf(json_output, stdout, JSON_INDENT(2));
-  printf("\n");
-  json_decref(json_output);
+  if (options->format != OUTPUT_FORMAT_JSON &&
+      (options->compact || options->precision != 0)) {
+    report_error_json_only_option(target,
+                                  options->compact ? "--compact" :
+                                                     "--precision");
+    exit(1);
+  }
+}
+
+/**
+ * Opens the output file of a target
+ *
+ * If the file cannot be opened, reports the error and exits the program.
+ *
+ * @param filename  The path of the file, or NULL for stdout
+ * @return          The opened file, to be closed with close_output_file
+ */
+FILE* open_output_file(const char* filename) {
+  if (filename == NULL)
+    return stdout;
+  FILE* file = fopen(filename, "wb");
+  if (file == NULL) {
+    report_error_opening_output_file(filename);
+    exit(1);
+  }
+  return file;
+}
+
+/**
+ * Closes the output file of a target
+ *
+ * If writing the file failed, reports the error and exits the program.
+ *
+ * @param file      The file returned by open_output_file
+ * @param filename  The path of the file, or NULL for stdout
+ */
+void close_output_file(FILE* file, const char* filename) {
+  bool written = !ferror(file);
+  if (file == stdout)
+    written = fflush(file) == 0 && written;
+  else
+    written = fclose(file) == 0 && written;
+  if (!written) {
+    report_error_writing_output_file(filename);
+    exit(1);
+  }
+}
+
+/**
+ * Writes a scenario as JSON to the output file of a target
+ *
+ * @param scenario  The scenario
+ * @param options   The options of the target
+ * @param file      The output file
+ */
+void write_scenario_output(const struct Scenario* scenario,
+                           const struct Options* options,
+                           FILE* file) {
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  json_writer_initialize(writer, file);
+  json_writer_set_layout(writer, options->compact, options->precision);
+  scenario_write_json(writer, scenario);
+  json_writer_flush(writer);
+  fprintf(file, "\n");
+  free(writer);
+}
+
+/**
+ * Writes a plan as JSON to the output file of a target
+ *
+ * @param plan     The plan
+ * @param options  The options of the target
+ * @param file     The output file
+ */
+void write_plan_output(const struct Plan* plan,
+                       const struct Options* options,
+                       FILE* file) {
+  struct JsonWriter* writer = malloc(sizeof(struct JsonWriter));
+  json_writer_initialize(writer, file);
+  json_writer_set_layout(writer, options->compact, options->precision);
+  plan_write_json(writer, plan);
+  json_writer_flush(writer);
+  fprintf(file, "\n");
+  free(writer);
+}
+
+/**
+ * Loads a plan from a JSON file or a binary plan
+ *
+ * @param plan      The plan to initialize
+ * @param filename  The path of the file
+ */
+void load_plan(struct Plan* plan, const char* filename) {
+  FILE* input_file = open_input_file(filename);
+  if (plan_file_is_binary(input_file))
+    plan_read_binary(plan, filename);
+  else
+    plan_read_json(plan, input_file);
+  fclose(input_file);
+}
+
+/**
+ * Loads a scenario from a JSON file or a binary snapshot
+ *
+ * @param scenario  The scenario to initialize
+ * @param snapshot  The snapshot, opened if the file is a snapshot
+ * @param filename  The path of the file
+ * @return          true if and only if the file is a snapshot, which must be
+ *                  closed after the scenario is freed
+ */
+bool load_scenario(struct Scenario* scenario,
+                   struct Snapshot* snapshot,
+                   const char* filename) {
+  FILE* input_file = open_input_file(filename);
+  bool is_snapshot = snapshot_file_is_snapshot(input_file);
+  if (is_snapshot) {
+    snapshot_open(snapshot, filename);
+    scenario_from_snapshot(scenario, snapshot);
+  } else {
+    scenario_read_json(scenario, input_file);
+  }
+  fclose(input_file);
+  return is_snapshot;
+}
+
+/**
+ * Processes the 'plan' target
+ *
+ * @param argc  The number of application arguments
+ * @param argv  The application arguments
+ */
+void process_plan_target(int argc, char* argv[]) {
+  struct Options options;
+  parse_options("plan", argc, argv, &options);
+
+  struct Plan plan;
+  if (options.input_filename == NULL) {
+    const struct Timeline* timeline = timeline_create(0, NULL);
+    plan_initialize(&plan, timeline);
+    timeline_release(timeline);
+  } else {
+    load_plan(&plan, options.input_filename);
+  }
+  FILE* output_file = open_output_file(options.output_filename);
+  if (options.format == OUTPUT_FORMAT_BIN)
+    plan_write_binary(&plan, output_file);
+  else if (options.format == OUTPUT_FORMAT_ARROW)
+    plan_write_arrow(&plan, output_file);
+  else
+    write_plan_output(&plan, &options, output_file);
+  close_output_file(output_file, options.output_filename);
   plan_free(&plan);
 }
 
@@ -132,32 +535,87 @@ void process_plan_target(int argc, char* argv[]) {
  * @param argv  The application arguments
  */
 void process_scenario_target(int argc, char* argv[]) {
-  if (argc >= 4) {
-    report_error_too_many_arguments("scenario");
-    exit(1);
-  }
+  struct Options options;
+  parse_options("scenario", argc, argv, &options);
 
   struct Scenario scenario;
-  json_t* json_output;
-  if (argc == 2) {
+  struct Snapshot snapshot;
+  bool is_snapshot = false;
+  if (options.input_filename == NULL)
     initialize_empty_scenario(&scenario);
-    json_output = scenario_to_json(&scenario);
-  } else {
-    const char* input_filename = argv[2];
-    json_error_t error;
-    json_t* json_input = json_load_file(input_filename, 0, &error);
-    if (!json_input) {
-      report_error_loading_json_from_file(error);
+  else if (options.is_topology)
+    scenario_read_csv(&scenario, options.input_filename);
+  else
+    is_snapshot = load_scenario(&scenario, &snapshot, options.input_filename);
+  FILE* output_file = open_output_file(options.output_filename);
+  if (options.format == OUTPUT_FORMAT_BIN)
+    scenario_write_snapshot(&scenario, output_file);
+  else
+    write_scenario_output(&scenario, &options, output_file);
+  close_output_file(output_file, options.output_filename);
+  scenario_free(&scenario);
+  if (is_snapshot)
+    snapshot_close(&snapshot);
+}
+
+/**
+ * Processes the 'convert' target
+ *
+ * @param argc  The number of application arguments
+ * @param argv  The application arguments
+ */
+void process_convert_target(int argc, char* argv[]) {
+  for (int i = 2; i < argc; ++i) {
+    if (argv[i][0] == '-' && argv[i][1] != '\0') {
+      report_error_invalid_option("convert", argv[i]);
       exit(1);
     }
-    scenario_from_json(&scenario, json_input);
-    json_decref(json_input);
-    json_output = scenario_to_json(&scenario);
   }
-  json_dumpf(json_output, stdout, JSON_INDENT(2));
-  printf("\n");
-  json_decref(json_output);
-  scenario_free(&scenario);
+  if (argc < 4) {
+    report_error_missing_arguments("convert");
+    exit(1);
+  } else if (argc > 4) {
+    report_error_too_many_arguments("convert");
+    exit(1);
+  }
+
+  const char* input_filename = argv[2];
+  const char* output_filename = argv[3];
+  FILE* input_file = open_input_file(input_filename);
+  bool from_snapshot = snapshot_file_is_snapshot(input_file);
+  bool from_binary_plan = plan_file_is_binary(input_file);
+  bool to_snapshot = has_extension(output_filename, SNAPSHOT_EXTENSION);
+  bool to_binary_plan = has_extension(output_filename, BINARY_PLAN_EXTENSION);
+  if ((from_snapshot || from_binary_plan) == (to_snapshot || to_binary_plan)) {
+    report_error_unsupported_conversion(input_filename, output_filename);
+    exit(1);
+  }
+  struct Options options;
+  initialize_default_options(&options);
+  FILE* output_file = open_output_file(output_filename);
+  if (from_snapshot) {
+    struct Scenario scenario;
+    struct Snapshot snapshot;
+    snapshot_open(&snapshot, input_filename);
+    scenario_from_snapshot(&scenario, &snapshot);
+    write_scenario_output(&scenario, &options, output_file);
+    scenario_free(&scenario);
+    snapshot_close(&snapshot);
+  } else if (from_binary_plan) {
+    struct Plan plan;
+    plan_read_binary(&plan, input_filename);
+    write_plan_output(&plan, &options, output_file);
+    plan_free(&plan);
+  } else if (to_snapshot) {
+    struct Scenario scenario;
+    scenario_read_json(&scenario, input_file);
+    scenario_write_snapshot(&scenario, output_file);
+    scenario_free(&scenario);
+  } else {
+    plan_convert_json_to_binary(input_file, output_file);
+  }
+  close_output_file(output_file, output_filename);
+  fclose(input_file);
 }
 
 // Main
@@ -176,5 +634,7 @@ int main(int argc, char* argv[]) {
     process_plan_target(argc, argv);
   else if (strcmp(argv[1], "scenario") == 0)
     process_scenario_target(argc, argv);
+  else if (strcmp(argv[1], "convert") == 0)
+    process_convert_target(argc, argv);
   return 0;
 }
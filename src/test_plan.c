@@ -31,7 +31,7 @@ void test_plan_json_shape(const json_t* j_plan) {
 // An example of an empty plan
 struct EmptyPlanExample {
   struct Plan plan;         // The scenario
-  struct Timeline timeline; // The timeline
+  const struct Timeline* timeline; // The timeline
 };
 
 /**
@@ -42,8 +42,8 @@ struct EmptyPlanExample {
 void empty_plan_example_initialize(struct EmptyPlanExample* example) {
   diag("Building an empty plan");
   int durations[] = {10, 30, 60};
-  timeline_initialize(&example->timeline, 3, durations);
-  plan_initialize(&example->plan, &example->timeline);
+  example->timeline = timeline_create(3, durations);
+  plan_initialize(&example->plan, example->timeline);
 }
 
 /**
@@ -53,7 +53,7 @@ void empty_plan_example_initialize(struct EmptyPlanExample* example) {
  */
 void empty_plan_example_free(struct EmptyPlanExample* example) {
   plan_free(&example->plan);
-  timeline_free(&example->timeline);
+  timeline_release(example->timeline);
 }
 
 /**
@@ -64,9 +64,9 @@ void test_empty_plan_initialize(void) {
   struct EmptyPlanExample example;
   empty_plan_example_initialize(&example);
   const struct Plan* plan = &example.plan;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
 
-  ok(timeline_are_equal(&plan->timeline, timeline),
+  ok(timeline_are_equal(plan->timeline, timeline),
      "plan timeline is equal to the provided timeline");
 
   empty_plan_example_free(&example);
@@ -80,7 +80,7 @@ void test_empty_plan_to_json(void) {
   struct EmptyPlanExample example;
   empty_plan_example_initialize(&example);
   const struct Plan* plan = &example.plan;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
 
   // Checks
   json_t* j = plan_to_json(plan);
@@ -107,7 +107,7 @@ void test_empty_plan_from_json(void) {
   struct EmptyPlanExample example;
   empty_plan_example_initialize(&example);
   const struct Plan* plan = &example.plan;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   struct Plan json_plan;
   json_t* j = plan_to_json(plan);
   plan_from_json(&json_plan, j);
@@ -141,7 +141,7 @@ struct PlanWithProductionsExample {
   char plant2_id[5];        // The identifier of the second plant
   mw productions_plant1[3]; // The productions of the first plant
   mw productions_plant2[3]; // The productions of the second plant
-  struct Timeline timeline; // The timeline
+  const struct Timeline* timeline; // The timeline
 };
 
 /**
@@ -153,8 +153,8 @@ void plan_with_productions_example_initialize(
   struct PlanWithProductionsExample* example) {
   diag("Building a plan with productions");
   int durations[] = {10, 30, 60};
-  timeline_initialize(&example->timeline, 3, durations);
-  plan_initialize(&example->plan, &example->timeline);
+  example->timeline = timeline_create(3, durations);
+  plan_initialize(&example->plan, example->timeline);
   strcpy(example->plant1_id, "P1");
   strcpy(example->plant2_id, "P2");
   example->productions_plant1[0] = 1.0;
@@ -179,7 +179,7 @@ void plan_with_productions_example_initialize(
 void plan_with_productions_example_free(
   struct PlanWithProductionsExample* example) {
   plan_free(&example->plan);
-  timeline_free(&example->timeline);
+  timeline_release(example->timeline);
 }
 
 /**
@@ -189,7 +189,7 @@ void test_plan_with_productions_initialize(void) {
   struct PlanWithProductionsExample example;
   plan_with_productions_example_initialize(&example);
 
-  ok(timeline_are_equal(&example.plan.timeline, &example.timeline),
+  ok(timeline_are_equal(example.plan.timeline, example.timeline),
      "plan timeline is equal to the provided timeline");
   for (int t = 0; t < 3; ++t) {
     cmp_ok(plan_get_production(&example.plan, t, "P1"),
@@ -209,6 +209,48 @@ void test_plan_with_productions_initialize(void) {
   plan_with_productions_example_free(&example);
 }
 
+/**
+ * Tests the index-based accessors on an example of a plan with productions
+ */
+void test_plan_with_productions_by_index(void) {
+  diag("Testing plan_plant_index and plan_get_production_by_index");
+  struct PlanWithProductionsExample example;
+  plan_with_productions_example_initialize(&example);
+  struct Plan* plan = &example.plan;
+
+  int p1 = plan_plant_index(plan, "P1");
+  int p2 = plan_plant_index(plan, "P2");
+  cmp_ok(plan->num_plants, "==", 2, "number of plants in plan is 2");
+  ok(p1 >= 0 && p2 >= 0 && p1 != p2, "plants P1 and P2 have distinct indices");
+  cmp_ok(plan_plant_index(plan, "P3"), "==", -1, "plant P3 has no index");
+  cmp_ok(plan_add_plant(plan, "P1"), "==", p1,
+         "adding plant P1 again returns its index");
+  for (int t = 0; t < 3; ++t) {
+    cmp_ok(plan_get_production_by_index(plan, t, p1),
+           "==",
+           example.productions_plant1[t],
+           "plan_get_production_by_index(P1) == %f",
+           example.productions_plant1[t]);
+    cmp_ok(plan_get_production_by_index(plan, t, p2),
+           "==",
+           example.productions_plant2[t],
+           "plan_get_production_by_index(P2) == %f",
+           example.productions_plant2[t]);
+  }
+  plan_set_production_by_index(plan, 1, p2, 9.0);
+  cmp_ok(plan_get_production(plan, 1, "P2"), "==", 9.0,
+         "production set by index is read by identifier");
+  int p3 = plan_add_plant(plan, "P3");
+  cmp_ok(plan_get_production_by_index(plan, 2, p3), "==", 0.0,
+         "production of a new plant is 0.0");
+  plan_set_production_by_index(plan, 0, p3, 123.4);
+  mw production = plan_get_production_by_index(plan, 0, p3);
+  ok(production > 123.4 - 1e-4 && production < 123.4 + 1e-4,
+     "production of 123.4 is preserved by the storage mode");
+
+  plan_with_productions_example_free(&example);
+}
+
 /**
  * Tests the plan_to_json function on an example of plan with productions
  */
@@ -217,7 +259,7 @@ void test_plan_with_productions_to_json(void) {
   struct PlanWithProductionsExample example;
   plan_with_productions_example_initialize(&example);
   const struct Plan* plan = &example.plan;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
 
   // Checks
   json_t* j = plan_to_json(plan);
@@ -264,7 +306,7 @@ void test_plan_with_productions_from_json(void) {
   struct PlanWithProductionsExample example;
   plan_with_productions_example_initialize(&example);
   const struct Plan* plan = &example.plan;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   struct Plan json_plan;
   json_t* j = plan_to_json(plan);
   plan_from_json(&json_plan, j);
@@ -284,6 +326,7 @@ void test_plan_with_productions_from_json(void) {
  */
 void test_plan_with_productions(void) {
   test_plan_with_productions_initialize();
+  test_plan_with_productions_by_index();
   test_plan_with_productions_to_json();
   test_plan_with_productions_from_json();
 }
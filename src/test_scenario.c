@@ -1,5 +1,7 @@
 #include "timeline.h"
 
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 
 #include <tap.h>
@@ -46,25 +48,24 @@ void test_scenario_are_equal(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline1, timeline2;
-  timeline_initialize(&timeline1, 3, durations);
-  timeline_initialize(&timeline2, 2, durations);
+  const struct Timeline* timeline1 = timeline_create(3, durations);
+  const struct Timeline* timeline2 = timeline_create(2, durations);
   mw expected_demands[] = {5.0, 6.0, 7.0};
   struct Zone zone1, zone2;
-  zone_initialize(&zone1, "Z1", &timeline1, expected_demands);
-  zone_initialize(&zone2, "Z2", &timeline1, expected_demands);
+  zone_initialize(&zone1, "Z1", timeline1, expected_demands);
+  zone_initialize(&zone2, "Z2", timeline1, expected_demands);
   mw min_powers[] = {1.0, 2.0, 3.0},
      max_powers[] = {7.0, 8.0, 9.0};
   struct Plant plant1, plant2;
-  plant_initialize(&plant1, "P1", &timeline1, &zone1, min_powers, max_powers);
-  plant_initialize(&plant2, "P2", &timeline1, &zone1, min_powers, max_powers);
+  plant_initialize(&plant1, "P1", timeline1, 0, min_powers, max_powers);
+  plant_initialize(&plant2, "P2", timeline1, 0, min_powers, max_powers);
   struct Scenario scenario1, scenario2, scenario3, scenario4, scenario5, scenario6;
-  scenario_initialize(&scenario1, &timeline1);
-  scenario_initialize(&scenario2, &timeline2);
-  scenario_initialize(&scenario3, &timeline1);
-  scenario_initialize(&scenario4, &timeline1);
-  scenario_initialize(&scenario5, &timeline1);
-  scenario_initialize(&scenario6, &timeline1);
+  scenario_initialize(&scenario1, timeline1);
+  scenario_initialize(&scenario2, timeline2);
+  scenario_initialize(&scenario3, timeline1);
+  scenario_initialize(&scenario4, timeline1);
+  scenario_initialize(&scenario5, timeline1);
+  scenario_initialize(&scenario6, timeline1);
   scenario_add_zone(&scenario3, &zone1);
   scenario_add_zone(&scenario4, &zone2);
   scenario_add_plant(&scenario5, &plant1);
@@ -94,8 +95,8 @@ void test_scenario_are_equal(void) {
   plant_free(&plant2);
   zone_free(&zone1);
   zone_free(&zone2);
-  timeline_free(&timeline1);
-  timeline_free(&timeline2);
+  timeline_release(timeline1);
+  timeline_release(timeline2);
 }
 
 // Empty scenario
@@ -103,7 +104,7 @@ void test_scenario_are_equal(void) {
 
 // An example of an empty scenario with its timeline
 struct EmptyScenarioExample {
-  struct Timeline timeline; // The timeline
+  const struct Timeline* timeline; // The timeline
   struct Scenario scenario; // The scenario
 };
 
@@ -116,8 +117,8 @@ void empty_scenario_example_initialize(
   struct EmptyScenarioExample* example) {
   diag("Building an empty scenario");
   int durations[] = {10, 30, 60};
-  timeline_initialize(&example->timeline, 3, durations);
-  scenario_initialize(&example->scenario, &example->timeline);
+  example->timeline = timeline_create(3, durations);
+  scenario_initialize(&example->scenario, example->timeline);
 }
 
 /**
@@ -127,7 +128,7 @@ void empty_scenario_example_initialize(
  */
 void empty_scenario_example_free(struct EmptyScenarioExample* example) {
   scenario_free(&example->scenario);
-  timeline_free(&example->timeline);
+  timeline_release(example->timeline);
 }
 
 /**
@@ -137,10 +138,10 @@ void test_empty_scenario_initialize(void) {
   diag("Testing scenario_initialize");
   struct EmptyScenarioExample example;
   empty_scenario_example_initialize(&example);
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   const struct Scenario* scenario = &example.scenario;
 
-  ok(timeline_are_equal(&scenario->timeline, timeline),
+  ok(timeline_are_equal(scenario->timeline, timeline),
      "scenario timeline is equal to the provided timeline");
   cmp_ok(scenario->num_plants, "==", 0,
          "number of plants in scenario is 0");
@@ -157,7 +158,7 @@ void test_empty_scenario_to_json(void) {
   diag("Testing scenario_to_json");
   struct EmptyScenarioExample example;
   empty_scenario_example_initialize(&example);
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   const struct Scenario* scenario = &example.scenario;
 
   json_t* j_scenario = scenario_to_json(scenario);
@@ -211,7 +212,7 @@ void test_empty_scenario(void) {
 // An example of a scenario with zone
 struct ScenarioWithZoneExample {
   struct Scenario scenario; // The scenario
-  struct Timeline timeline; // The timeline
+  const struct Timeline* timeline; // The timeline
   struct Zone zone;         // The zone
 };
 
@@ -224,10 +225,10 @@ void scenario_with_zone_example_initialize(
   struct ScenarioWithZoneExample* example) {
   diag("Building a scenario with one zone");
   int durations[] = {10, 30, 60};
-  timeline_initialize(&example->timeline, 3, durations);
+  example->timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 6.0, 7.0};
-  zone_initialize(&example->zone, "Z", &example->timeline, expected_demands);
-  scenario_initialize(&example->scenario, &example->timeline);
+  zone_initialize(&example->zone, "Z", example->timeline, expected_demands);
+  scenario_initialize(&example->scenario, example->timeline);
   scenario_add_zone(&example->scenario, &example->zone);
 }
 
@@ -239,7 +240,7 @@ void scenario_with_zone_example_initialize(
 void scenario_with_zone_example_free(struct ScenarioWithZoneExample* example) {
   scenario_free(&example->scenario);
   zone_free(&example->zone);
-  timeline_free(&example->timeline);
+  timeline_release(example->timeline);
 }
 
 /**
@@ -249,7 +250,7 @@ void test_scenario_add_zone(void) {
   diag("Testing scenario_add_zone");
   struct ScenarioWithZoneExample example;
   scenario_with_zone_example_initialize(&example);
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   const struct Zone* zone = &example.zone;
   const struct Scenario* scenario = &example.scenario;
 
@@ -268,7 +269,7 @@ void test_scenario_with_zone_to_json(void) {
   diag("Testing scenario_to_json");
   struct ScenarioWithZoneExample example;
   scenario_with_zone_example_initialize(&example);
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   const struct Scenario* scenario = &example.scenario;
   const struct Zone* zone = &example.zone;
 
@@ -329,7 +330,7 @@ void test_scenario_with_zone(void) {
 struct ScenarioWithLinkAndZonesExample {
   struct Link link;         // The link
   struct Scenario scenario; // The scenario
-  struct Timeline timeline; // The timeline
+  const struct Timeline* timeline; // The timeline
   struct Zone source_zone;  // The source zone of the link
   struct Zone target_zone;  // The target zone of the link
 };
@@ -343,21 +344,18 @@ void scenario_with_link_and_zones_example_initialize(
   struct ScenarioWithLinkAndZonesExample* example) {
   diag("Building a scenario with one link and two zones");
   int durations[] = {10, 30, 60};
-  timeline_initialize(&example->timeline, 3, durations);
+  example->timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 6.0, 7.0};
   zone_initialize(&example->source_zone,
                  "Z1",
-                 &example->timeline,
+                 example->timeline,
                  expected_demands);
   zone_initialize(&example->target_zone,
                  "Z2",
-                 &example->timeline,
+                 example->timeline,
                  expected_demands);
-  link_initialize(&example->link,
-                  "Z1->Z2",
-                  &example->source_zone,
-                  &example->target_zone);
-  scenario_initialize(&example->scenario, &example->timeline);
+  link_initialize(&example->link, "Z1->Z2", 0, 1);
+  scenario_initialize(&example->scenario, example->timeline);
   scenario_add_zone(&example->scenario, &example->source_zone);
   scenario_add_zone(&example->scenario, &example->target_zone);
   scenario_add_link(&example->scenario, &example->link);
@@ -372,7 +370,7 @@ void scenario_with_link_and_zones_example_free(
   struct ScenarioWithLinkAndZonesExample* example) {
   link_free(&example->link);
   scenario_free(&example->scenario);
-  timeline_free(&example->timeline);
+  timeline_release(example->timeline);
   zone_free(&example->source_zone);
   zone_free(&example->target_zone);
 }
@@ -414,7 +412,7 @@ void test_scenario_with_link_and_zones_to_json(void) {
   scenario_with_link_and_zones_example_initialize(&example);
   const struct Link* link = &example.link;
   const struct Scenario* scenario = &example.scenario;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   const struct Zone* source_zone = &example.source_zone;
   const struct Zone* target_zone = &example.target_zone;
 
@@ -426,7 +424,7 @@ void test_scenario_with_link_and_zones_to_json(void) {
   const json_t* j_zones = json_object_get(j_scenario, "zones");
   cmp_ok(json_array_size(j_links), "==", 1, "size of array \"links\" is 1");
   const json_t* j_link = json_array_get(j_links, 0);
-  json_t* j_original_link = link_to_json(link);
+  json_t* j_original_link = link_to_json(link, scenario->zones);
   ok(json_equal(j_link, j_original_link),
      "link and original link are equal as json values");
   cmp_ok(json_array_size(j_plants), "==", 0, "size of array \"plants\" is 0");
@@ -488,7 +486,7 @@ void test_scenario_with_link_and_zones(void) {
 struct ScenarioWithPlantAndZoneExample {
   struct Plant plant;       // The plant
   struct Scenario scenario; // The scenario
-  struct Timeline timeline; // The timeline
+  const struct Timeline* timeline; // The timeline
   struct Zone zone;         // The zone
 };
 
@@ -501,18 +499,18 @@ void scenario_with_plant_and_zone_initialize(
   struct ScenarioWithPlantAndZoneExample* example) {
   diag("Building a scenario with one plant and one zone");
   int durations[] = {10, 30, 60};
-  timeline_initialize(&example->timeline, 3, durations);
+  example->timeline = timeline_create(3, durations);
   mw expected_demands[] = {5.0, 6.0, 7.0};
-  zone_initialize(&example->zone, "Z", &example->timeline, expected_demands);
+  zone_initialize(&example->zone, "Z", example->timeline, expected_demands);
   mw min_powers[] = {1.0, 2.0, 3.0},
      max_powers[] = {7.0, 8.0, 9.0};
   plant_initialize(&example->plant,
                    "P",
-                   &example->timeline,
-                   &example->zone,
+                   example->timeline,
+                   0,
                    min_powers,
                    max_powers);
-  scenario_initialize(&example->scenario, &example->timeline);
+  scenario_initialize(&example->scenario, example->timeline);
   scenario_add_zone(&example->scenario, &example->zone);
   scenario_add_plant(&example->scenario, &example->plant);
 }
@@ -527,7 +525,7 @@ void scenario_with_plant_and_zone_free(
   scenario_free(&example->scenario);
   plant_free(&example->plant);
   zone_free(&example->zone);
-  timeline_free(&example->timeline);
+  timeline_release(example->timeline);
 }
 /**
  * Tests the scenario_add_plant function on a scenario with plant and zone
@@ -538,7 +536,7 @@ void test_scenario_add_plant(void) {
   scenario_with_plant_and_zone_initialize(&example);
   const struct Plant* plant = &example.plant;
   const struct Scenario* scenario = &example.scenario;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   const struct Zone* zone = &example.zone;
 
   cmp_ok(scenario->num_plants, "==", 1,
@@ -562,7 +560,7 @@ void test_scenario_with_plant_and_zone_to_json(void) {
   struct ScenarioWithPlantAndZoneExample example;
   scenario_with_plant_and_zone_initialize(&example);
   const struct Plant* plant = &example.plant;
-  const struct Timeline* timeline = &example.timeline;
+  const struct Timeline* timeline = example.timeline;
   const struct Scenario* scenario = &example.scenario;
   const struct Zone* zone = &example.zone;
 
@@ -573,7 +571,7 @@ void test_scenario_with_plant_and_zone_to_json(void) {
   const json_t* j_zones = json_object_get(j_scenario, "zones");
   cmp_ok(json_array_size(j_plants), "==", 1, "size of array \"plants\" is 0");
   const json_t* j_plant = json_array_get(j_plants, 0);
-  json_t* j_source_plant = plant_to_json(plant);
+  json_t* j_source_plant = plant_to_json(plant, zone);
   ok(json_equal(j_plant, j_source_plant),
      "plant and source plant are equal as json values");
   json_t* j_source_timeline = timeline_to_json(timeline);
@@ -622,6 +620,237 @@ void test_scenario_with_plant_and_zone(void) {
   test_scenario_with_plant_and_zone_from_json();
 }
 
+// Scenario with many components
+// ==============================
+
+/**
+ * Tests that component tables grow beyond their initial capacity
+ */
+void test_scenario_with_many_components(void) {
+  diag("Testing scenario_add_* on a scenario with many components");
+
+  // Setup
+  int durations[] = {10, 30, 60};
+  const struct Timeline* timeline = timeline_create(3, durations);
+  mw expected_demands[] = {5.0, 6.0, 7.0};
+  mw min_powers[] = {1.0, 2.0, 3.0},
+     max_powers[] = {7.0, 8.0, 9.0};
+  struct Scenario scenario;
+  scenario_initialize(&scenario, timeline);
+  const unsigned int num_zones = 100;
+  char id[ID_MAX_LENGTH + 1];
+  for (unsigned int z = 0; z < num_zones; ++z) {
+    struct Zone zone;
+    struct Plant plant;
+    struct Link link;
+    snprintf(id, sizeof(id), "Z%u", z);
+    zone_initialize(&zone, id, timeline, expected_demands);
+    scenario_add_zone(&scenario, &zone);
+    snprintf(id, sizeof(id), "P%u", z);
+    plant_initialize(&plant, id, timeline, z, min_powers, max_powers);
+    scenario_add_plant(&scenario, &plant);
+    snprintf(id, sizeof(id), "L%u", z);
+    link_initialize(&link, id, z, (z + 1) % num_zones);
+    scenario_add_link(&scenario, &link);
+    link_free(&link);
+    plant_free(&plant);
+    zone_free(&zone);
+  }
+
+  // Checks
+  cmp_ok(scenario.num_zones, "==", num_zones,
+         "number of zones in scenario is %u", num_zones);
+  cmp_ok(scenario.num_plants, "==", num_zones,
+         "number of plants in scenario is %u", num_zones);
+  cmp_ok(scenario.num_links, "==", num_zones,
+         "number of links in scenario is %u", num_zones);
+  is(scenario.zones[scenario.plants[42].zone].id, "Z42",
+     "plant P42 is located in zone Z42");
+  is(scenario.zones[scenario.links[99].target].id, "Z0",
+     "link L99 targets zone Z0");
+  cmp_ok(scenario_zone_index_by_id(&scenario, "Z77"), "==", 77,
+         "zone Z77 has index 77");
+  ok(scenario_zone_by_id(&scenario, "Z100") == NULL,
+     "zone Z100 does not exist");
+  cmp_ok(scenario_plant_index_by_id(&scenario, "P13"), "==", 13,
+         "plant P13 has index 13");
+  ok(scenario_plant_by_id(&scenario, "P56") == scenario.plants + 56,
+     "plant P56 is found by identifier");
+  ok(scenario_plant_by_id(&scenario, "Z56") == NULL,
+     "plant Z56 does not exist");
+  cmp_ok(scenario_link_index_by_id(&scenario, "L99"), "==", 99,
+         "link L99 has index 99");
+  ok(scenario_link_by_id(&scenario, "L3") == scenario.links + 3,
+     "link L3 is found by identifier");
+  ok(scenario_link_by_id(&scenario, "P3") == NULL,
+     "link P3 does not exist");
+  const stored_mw* plant_min_powers = scenario_plant_min_powers(&scenario, 42);
+  const stored_mw* plant_max_powers = scenario_plant_max_powers(&scenario, 42);
+  const stored_mw* zone_demands = scenario_zone_expected_demands(&scenario, 42);
+  ok(plant_min_powers == scenario.plants[42].min_powers &&
+     plant_max_powers == scenario.plants[42].max_powers,
+     "powers of plant P42 are views into the scenario matrices");
+  ok(zone_demands == scenario.zones[42].expected_demands,
+     "demands of zone Z42 are a view into the scenario matrix");
+  ok((uintptr_t)plant_min_powers % SERIES_ALIGNMENT == 0 &&
+     (uintptr_t)plant_max_powers % SERIES_ALIGNMENT == 0 &&
+     (uintptr_t)zone_demands % SERIES_ALIGNMENT == 0,
+     "series of plant P42 and zone Z42 are aligned");
+  for (int t = 0; t < 3; ++t) {
+    cmp_ok(mw_load(plant_min_powers[t]), "==", min_powers[t],
+           "minimum power of plant P42 at index %d is preserved", t);
+    cmp_ok(mw_load(plant_max_powers[t]), "==", max_powers[t],
+           "maximum power of plant P42 at index %d is preserved", t);
+    cmp_ok(mw_load(zone_demands[t]), "==", expected_demands[t],
+           "expected demand of zone Z42 at index %d is preserved", t);
+  }
+
+  // Teardown
+  scenario_free(&scenario);
+  timeline_release(timeline);
+}
+
+/**
+ * Tests adding components in place to a scenario
+ */
+void test_scenario_emplace(void) {
+  diag("Testing scenario_emplace_*");
+
+  // Setup
+  int durations[] = {10, 30, 60};
+  const struct Timeline* timeline = timeline_create(3, durations);
+  mw expected_demands[] = {5.0, 6.0, 7.0};
+  mw min_powers[] = {1.0, 2.0, 3.0},
+     max_powers[] = {7.0, 8.0, 9.0};
+  struct Scenario scenario, copied_scenario;
+  scenario_initialize(&scenario, timeline);
+  scenario_initialize(&copied_scenario, timeline);
+  struct Zone zone;
+  struct Plant plant;
+  struct Link link;
+  zone_initialize(&zone, "Z1", timeline, expected_demands);
+  plant_initialize(&plant, "P1", timeline, 0, min_powers, max_powers);
+  link_initialize(&link, "L1", 0, 0);
+  scenario_add_zone(&copied_scenario, &zone);
+  scenario_add_plant(&copied_scenario, &plant);
+  scenario_add_link(&copied_scenario, &link);
+
+  // Checks
+  struct Zone* emplaced_zone = scenario_emplace_zone(&scenario, "Z1");
+  ok(emplaced_zone == scenario.zones &&
+     emplaced_zone->expected_demands == scenario_zone_expected_demands(
+       &scenario, 0),
+     "emplaced zone is stored in the scenario");
+  for (int t = 0; t < 3; ++t)
+    emplaced_zone->expected_demands[t] = mw_store(expected_demands[t]);
+  struct Plant* emplaced_plant = scenario_emplace_plant(&scenario, "P1", 0);
+  ok(emplaced_plant == scenario.plants &&
+     emplaced_plant->min_powers == scenario_plant_min_powers(&scenario, 0) &&
+     emplaced_plant->max_powers == scenario_plant_max_powers(&scenario, 0),
+     "emplaced plant is stored in the scenario");
+  for (int t = 0; t < 3; ++t) {
+    emplaced_plant->min_powers[t] = mw_store(min_powers[t]);
+    emplaced_plant->max_powers[t] = mw_store(max_powers[t]);
+  }
+  struct Link* emplaced_link = scenario_emplace_link(&scenario, "L1", 0, 0);
+  ok(emplaced_link == scenario.links,
+     "emplaced link is stored in the scenario");
+  ok(emplaced_plant->timeline == scenario.timeline &&
+     emplaced_zone->timeline == scenario.timeline,
+     "emplaced components share the timeline of the scenario");
+  ok(scenario_plant_by_id(&scenario, "P1") == emplaced_plant &&
+     scenario_zone_by_id(&scenario, "Z1") == emplaced_zone &&
+     scenario_link_by_id(&scenario, "L1") == emplaced_link,
+     "emplaced components are found by identifier");
+  ok(scenario_are_equal(&scenario, &copied_scenario),
+     "emplaced and copied components are equal");
+
+  // Teardown
+  link_free(&link);
+  plant_free(&plant);
+  zone_free(&zone);
+  scenario_free(&copied_scenario);
+  scenario_free(&scenario);
+  timeline_release(timeline);
+}
+
+/**
+ * Tests forking a scenario and modifying the fork
+ */
+void test_scenario_fork(void) {
+  diag("Testing scenario_fork and scenario_modify_*");
+
+  // Setup
+  int durations[] = {10, 30, 60};
+  const struct Timeline* timeline = timeline_create(3, durations);
+  mw expected_demands[] = {5.0, 6.0, 7.0};
+  mw min_powers[] = {1.0, 2.0, 3.0},
+     max_powers[] = {7.0, 8.0, 9.0};
+  struct Scenario scenario, fork;
+  scenario_initialize(&scenario, timeline);
+  char id[ID_MAX_LENGTH + 1];
+  for (unsigned int i = 0; i < 2; ++i) {
+    struct Zone zone;
+    struct Plant plant;
+    snprintf(id, sizeof(id), "Z%u", i);
+    zone_initialize(&zone, id, timeline, expected_demands);
+    scenario_add_zone(&scenario, &zone);
+    snprintf(id, sizeof(id), "P%u", i);
+    plant_initialize(&plant, id, timeline, i, min_powers, max_powers);
+    scenario_add_plant(&scenario, &plant);
+    plant_free(&plant);
+    zone_free(&zone);
+  }
+  struct Link link;
+  link_initialize(&link, "L", 0, 1);
+  scenario_add_link(&scenario, &link);
+  scenario_fork(&fork, &scenario);
+
+  // Checks
+  ok(scenario_are_equal(&scenario, &fork), "fork is equal to its parent");
+  ok(fork.plants[1].min_powers == scenario.plants[1].min_powers &&
+     fork.zones[1].expected_demands == scenario.zones[1].expected_demands,
+     "fork shares the series of its parent");
+  scenario_modify_plant_min_powers(&fork, 1)[0] = mw_store(0.5);
+  scenario_modify_zone_expected_demands(&fork, 0)[2] = mw_store(8.0);
+  ok(!scenario_are_equal(&scenario, &fork),
+     "modified fork is not equal to its parent");
+  cmp_ok(mw_load(scenario.plants[1].min_powers[0]), "==", 1.0,
+         "minimum power of parent plant P1 is unchanged");
+  cmp_ok(mw_load(scenario.zones[0].expected_demands[2]), "==", 7.0,
+         "expected demand of parent zone Z0 is unchanged");
+  ok(mw_load(fork.plants[1].min_powers[0]) == 0.5 &&
+     mw_load(fork.plants[1].min_powers[1]) == 2.0,
+     "minimum powers of fork plant P1 are copied then modified");
+  ok(fork.plants[1].max_powers == scenario.plants[1].max_powers &&
+     fork.plants[0].min_powers == scenario.plants[0].min_powers,
+     "unmodified series are still shared");
+  stored_mw* demands = scenario_modify_zone_expected_demands(&fork, 0);
+  ok(demands == fork.zones[0].expected_demands,
+     "a series is copied only once");
+  struct Plant plant;
+  plant_initialize(&plant, "P2", timeline, 1, min_powers, max_powers);
+  scenario_add_plant(&fork, &plant);
+  plant_free(&plant);
+  cmp_ok(fork.num_plants, "==", 3, "plant P2 is added to the fork");
+  cmp_ok(scenario.num_plants, "==", 2, "parent still has 2 plants");
+  ok(mw_load(scenario_plant_min_powers(&fork, 1)[0]) == 0.5 &&
+     scenario_plant_max_powers(&fork, 0) == scenario.plants[0].max_powers,
+     "series of the fork are preserved when its tables grow");
+  cmp_ok(scenario_plant_index_by_id(&fork, "P2"), "==", 2,
+         "plant P2 has index 2 in the fork");
+  cmp_ok(scenario_plant_index_by_id(&scenario, "P2"), "==", -1,
+         "plant P2 is not in the parent");
+  ok(scenario_link_by_id(&fork, "L") == fork.links,
+     "link L is found by identifier in the fork");
+
+  // Teardown
+  link_free(&link);
+  scenario_free(&fork);
+  scenario_free(&scenario);
+  timeline_release(timeline);
+}
+
 // Main
 // ====
 
@@ -631,5 +860,8 @@ int main(void) {
   test_scenario_with_zone();
   test_scenario_with_link_and_zones();
   test_scenario_with_plant_and_zone();
+  test_scenario_with_many_components();
+  test_scenario_emplace();
+  test_scenario_fork();
   done_testing();
 }
@@ -0,0 +1,99 @@
+#include "scenario_graph.h"
+
+#include <stdio.h>
+
+#include <tap.h>
+
+#include "scenario.h"
+
+/**
+ * Tests the graph of an empty scenario
+ */
+void test_scenario_graph_empty(void) {
+  diag("Testing scenario_graph_initialize on an empty scenario");
+
+  // Setup
+  int durations[] = {10, 30, 60};
+  const struct Timeline* timeline = timeline_create(3, durations);
+  struct Scenario scenario;
+  scenario_initialize(&scenario, timeline);
+  struct ScenarioGraph graph;
+  scenario_graph_initialize(&graph, &scenario);
+
+  // Checks
+  cmp_ok(graph.num_zones, "==", 0, "graph has no zone");
+  cmp_ok(graph.plant_offsets[0], "==", 0, "graph has no plant");
+  cmp_ok(graph.outgoing_offsets[0], "==", 0, "graph has no link");
+
+  // Teardown
+  scenario_graph_free(&graph);
+  scenario_free(&scenario);
+  timeline_release(timeline);
+}
+
+/**
+ * Tests the neighbours of the zones of a scenario
+ *
+ * The scenario has 3 zones Z0, Z1 and Z2, plants P0 in Z1, P1 in Z0, P2 in
+ * Z1, and links L0 from Z0 to Z1, L1 from Z1 to Z2 and L2 from Z0 to Z2.
+ */
+void test_scenario_graph_neighbours(void) {
+  diag("Testing scenario_graph_* accessors");
+
+  // Setup
+  int durations[] = {10, 30, 60};
+  const struct Timeline* timeline = timeline_create(3, durations);
+  struct Scenario scenario;
+  scenario_initialize(&scenario, timeline);
+  char id[ID_MAX_LENGTH + 1];
+  for (unsigned int z = 0; z < 3; ++z) {
+    snprintf(id, sizeof(id), "Z%u", z);
+    scenario_emplace_zone(&scenario, id);
+  }
+  unsigned int plant_zones[] = {1, 0, 1};
+  for (unsigned int p = 0; p < 3; ++p) {
+    snprintf(id, sizeof(id), "P%u", p);
+    scenario_emplace_plant(&scenario, id, plant_zones[p]);
+  }
+  unsigned int link_sources[] = {0, 1, 0},
+               link_targets[] = {1, 2, 2};
+  for (unsigned int l = 0; l < 3; ++l) {
+    snprintf(id, sizeof(id), "L%u", l);
+    scenario_emplace_link(&scenario, id, link_sources[l], link_targets[l]);
+  }
+  struct ScenarioGraph graph;
+  scenario_graph_initialize(&graph, &scenario);
+
+  // Checks
+  unsigned int n;
+  const unsigned int* plants = scenario_graph_zone_plants(&graph, 0, &n);
+  ok(n == 1 && plants[0] == 1, "zone Z0 contains plant P1");
+  plants = scenario_graph_zone_plants(&graph, 1, &n);
+  ok(n == 2 && plants[0] == 0 && plants[1] == 2,
+     "zone Z1 contains plants P0 and P2, in that order");
+  scenario_graph_zone_plants(&graph, 2, &n);
+  cmp_ok(n, "==", 0, "zone Z2 contains no plant");
+  const unsigned int* links = scenario_graph_outgoing_links(&graph, 0, &n);
+  ok(n == 2 && links[0] == 0 && links[1] == 2, "links L0 and L2 leave Z0");
+  links = scenario_graph_outgoing_links(&graph, 1, &n);
+  ok(n == 1 && links[0] == 1, "link L1 leaves Z1");
+  scenario_graph_outgoing_links(&graph, 2, &n);
+  cmp_ok(n, "==", 0, "no link leaves Z2");
+  scenario_graph_incoming_links(&graph, 0, &n);
+  cmp_ok(n, "==", 0, "no link enters Z0");
+  links = scenario_graph_incoming_links(&graph, 1, &n);
+  ok(n == 1 && links[0] == 0, "link L0 enters Z1");
+  links = scenario_graph_incoming_links(&graph, 2, &n);
+  ok(n == 2 && links[0] == 1 && links[1] == 2, "links L1 and L2 enter Z2");
+
+  // Teardown
+  scenario_graph_free(&graph);
+  scenario_free(&scenario);
+  timeline_release(timeline);
+}
+
+int main(void) {
+  test_scenario_graph_empty();
+  test_scenario_graph_neighbours();
+  done_testing();
+}
@@ -0,0 +1,163 @@
+#include "series.h"
+
+#include <stdbool.h>
+
+#include <tap.h>
+
+/**
+ * Tests the series_from_values function
+ */
+void test_series_from_values(void) {
+  diag("Testing series_from_values and series_value_at");
+
+  // Setup
+  stored_mw values[] = {mw_store(1.0), mw_store(1.0), mw_store(2.0),
+                        mw_store(2.0), mw_store(2.0), mw_store(1.0)};
+  struct Series series;
+  series_from_values(&series, 6, values);
+
+  // Checks
+  cmp_ok(series.num_runs, "==", 3, "series has 3 runs");
+  ok(series.starts[0] == 0 && series.starts[1] == 2 && series.starts[2] == 5,
+     "runs start at timesteps 0, 2 and 5");
+  bool all_equal = true;
+  for (unsigned int t = 0; t < 6; ++t)
+    all_equal = all_equal && mw_store(series_value_at(&series, t)) == values[t];
+  ok(all_equal, "series_value_at returns the value at each timestep");
+
+  // Teardown
+  series_free(&series);
+}
+
+/**
+ * Tests appending runs to a series and decoding it
+ */
+void test_series_decode(void) {
+  diag("Testing series_append and series_decode");
+
+  // Setup
+  struct Series series;
+  series_initialize(&series);
+  for (unsigned int r = 0; r < 40; ++r)
+    series_append(&series, 3 * r, mw_store(r % 4));
+  stored_mw values[120];
+  series_decode(&series, 120, values);
+
+  // Checks
+  cmp_ok(series.num_runs, "==", 40, "series has 40 runs");
+  ok(series.capacity >= 40, "buffers grow with the runs");
+  bool all_equal = true;
+  for (unsigned int t = 0; t < 120; ++t)
+    all_equal = all_equal && values[t] == mw_store(t / 3 % 4);
+  ok(all_equal, "series_decode writes the value at each timestep");
+  ok(values[119] == mw_store(3.0), "last run lasts until the end");
+
+  // Teardown
+  series_free(&series);
+}
+
+/**
+ * Tests decoding a series sequentially
+ */
+void test_series_decoder(void) {
+  diag("Testing series_decoder_next");
+
+  // Setup
+  stored_mw values[100];
+  for (unsigned int t = 0; t < 100; ++t)
+    values[t] = mw_store(t / 30);
+  struct Series series;
+  series_from_values(&series, 100, values);
+  struct SeriesDecoder decoder;
+  series_decoder_initialize(&decoder, &series);
+
+  // Checks
+  cmp_ok(series.num_runs, "==", 4, "series has 4 runs");
+  bool all_equal = true;
+  for (unsigned int t = 0; t < 100; ++t) {
+    mw value = series_decoder_next(&decoder);
+    all_equal = all_equal && mw_store(value) == values[t];
+  }
+  ok(all_equal, "sequential decoder yields the value at each timestep");
+
+  // Teardown
+  series_free(&series);
+}
+
+/**
+ * Tests the conversions of series from and to JSON
+ */
+void test_series_json(void) {
+  diag("Testing series_to_json and series_from_json");
+
+  // Setup
+  stored_mw values[] = {mw_store(4.0), mw_store(4.0), mw_store(4.0),
+                        mw_store(3.5), mw_store(3.5)};
+  struct Series series, compact_series, dense_series;
+  series_from_values(&series, 5, values);
+  json_t* j = series_to_json(&series);
+  json_t* j_dense = json_pack("[f,f,f,f,f]", 4.0, 4.0, 4.0, 3.5, 3.5);
+  series_from_json(&compact_series, 5, j);
+  series_from_json(&dense_series, 5, j_dense);
+
+  // Checks
+  cmp_ok(json_array_size(j), "==", 2, "compact JSON series has 2 breakpoints");
+  const json_t* j_breakpoint = json_array_get(j, 1);
+  cmp_ok(json_integer_value(json_object_get(j_breakpoint, "from")), "==", 3,
+         "second breakpoint is from timestep 3");
+  ok(json_real_value(json_object_get(j_breakpoint, "value")) == 3.5,
+     "second breakpoint has value 3.5");
+  ok(series_are_equal(&series, &compact_series),
+     "series read from compact JSON is equal to the source series");
+  ok(series_are_equal(&series, &dense_series),
+     "series read from dense JSON is equal to the source series");
+
+  // Teardown
+  json_decref(j);
+  json_decref(j_dense);
+  series_free(&series);
+  series_free(&compact_series);
+  series_free(&dense_series);
+}
+
+/**
+ * Tests decoding dense and compact JSON series
+ */
+void test_series_values_from_json(void) {
+  diag("Testing series_values_from_json");
+
+  // Setup
+  stored_mw values[] = {mw_store(4.0), mw_store(4.0), mw_store(4.0),
+                        mw_store(3.5), mw_store(3.5)};
+  json_t* j_compact = json_pack("[{s:f,s:i},{s:f,s:i}]",
+                                "value", 4.0, "from", 0,
+                                "value", 3.5, "from", 3);
+  json_t* j_dense = json_pack("[f,f,f,f,f]", 4.0, 4.0, 4.0, 3.5, 3.5);
+  series_validate_json(j_compact, 5);
+  series_validate_json(j_dense, 5);
+  stored_mw compact_values[5], dense_values[5];
+  series_values_from_json(j_compact, 5, compact_values);
+  series_values_from_json(j_dense, 5, dense_values);
+
+  // Checks
+  bool compact_equal = true, dense_equal = true;
+  for (unsigned int t = 0; t < 5; ++t) {
+    compact_equal = compact_equal && compact_values[t] == values[t];
+    dense_equal = dense_equal && dense_values[t] == values[t];
+  }
+  ok(compact_equal, "compact JSON series is decoded at each timestep");
+  ok(dense_equal, "dense JSON series is decoded at each timestep");
+
+  // Teardown
+  json_decref(j_compact);
+  json_decref(j_dense);
+}
+
+int main(void) {
+  test_series_from_values();
+  test_series_decode();
+  test_series_decoder();
+  test_series_json();
+  test_series_values_from_json();
+  done_testing();
+}
@@ -5,26 +5,29 @@
 #include <tap.h>
 
 /**
- * Tests the timeline_initialize function
+ * Tests the timeline_create function
  */
-void test_timeline_initialize(void) {
-  diag("Testing timeline_initialize");
+void test_timeline_create(void) {
+  diag("Testing timeline_create");
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
 
   // Checks
-  cmp_ok(timeline.future_durations[0], "==", 10,
+  cmp_ok(timeline->future_durations[0], "==", 10,
          "first duration of timeline is as given");
-  cmp_ok(timeline.future_durations[1], "==", 30,
+  cmp_ok(timeline->future_durations[1], "==", 30,
          "second duration of timeline is as given");
-  cmp_ok(timeline.future_durations[2], "==", 60,
+  cmp_ok(timeline->future_durations[2], "==", 60,
          "third duration of timeline is as given");
+  cmp_ok(timeline->start_offsets[2], "==", 40,
+         "third timestep starts after 40 minutes");
+  cmp_ok(timeline_total_duration(timeline), "==", 100,
+         "total duration of timeline is 100 minutes");
 
   // Teardown
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -36,44 +39,88 @@ void test_timeline_are_equal(void) {
   // Setup
   int durations1[] = {10, 20, 30},
       durations2[] = {10, 30, 60};
-  struct Timeline timeline1, timeline2, timeline3;
-  timeline_initialize(&timeline1, 3, durations1);
-  timeline_initialize(&timeline2, 3, durations1);
-  timeline_initialize(&timeline3, 3, durations2);
+  const struct Timeline* timeline1 = timeline_create(3, durations1);
+  const struct Timeline* timeline2 = timeline_create(3, durations1);
+  const struct Timeline* timeline3 = timeline_create(3, durations2);
+  const struct Timeline* timeline4 = timeline_create(2, durations1);
 
   // Checks
-  ok(timeline_are_equal(&timeline1, &timeline1),
+  ok(timeline_are_equal(timeline1, timeline1),
      "timeline is equal to itself");
-  ok(timeline_are_equal(&timeline1, &timeline2),
+  ok(timeline_are_equal(timeline1, timeline2),
      "timelines with same durations are equal");
-  ok(!timeline_are_equal(&timeline1, &timeline3),
+  ok(!timeline_are_equal(timeline1, timeline3),
      "timelines with different durations are not equal");
+  ok(!timeline_are_equal(timeline1, timeline4),
+     "timelines with different numbers of timesteps are not equal");
 
   // Teardown
-  timeline_free(&timeline1);
-  timeline_free(&timeline2);
-  timeline_free(&timeline3);
+  timeline_release(timeline1);
+  timeline_release(timeline2);
+  timeline_release(timeline3);
+  timeline_release(timeline4);
 }
 
 /**
- * Tests the timeline_copy function
+ * Tests sharing timelines with the same durations
  */
-void test_timeline_copy(void) {
-  diag("Testing timeline_copy");
+void test_timeline_sharing(void) {
+  diag("Testing timeline_retain and timeline_release");
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline1, timeline2;
-  timeline_initialize(&timeline1, 3, durations);
-  timeline_copy(&timeline2, &timeline1);
+  const struct Timeline* timeline1 = timeline_create(3, durations);
+  durations[0] = 15;
+  const struct Timeline* timeline2 = timeline_create(3, durations);
+  durations[0] = 10;
+  const struct Timeline* timeline3 = timeline_create(3, durations);
+  const struct Timeline* timeline4 = timeline_retain(timeline1);
 
   // Checks
-  ok(timeline_are_equal(&timeline1, &timeline2),
-     "copied timeline is equal to original timeline");
+  ok(timeline1 == timeline3 && timeline1 == timeline4,
+     "timelines with same durations are shared");
+  ok(timeline1 != timeline2,
+     "timelines with different durations are not shared");
+  cmp_ok(timeline1->num_references, "==", 3,
+         "shared timeline has 3 references");
+  timeline_release(timeline3);
+  timeline_release(timeline4);
+  cmp_ok(timeline1->num_references, "==", 1,
+         "shared timeline has 1 reference after 2 releases");
 
   // Teardown
-  timeline_free(&timeline1);
-  timeline_free(&timeline2);
+  timeline_release(timeline1);
+  timeline_release(timeline2);
+}
+
+/**
+ * Tests the timeline_timestep_at function
+ */
+void test_timeline_timestep_at(void) {
+  diag("Testing timeline_timestep_at");
+
+  // Setup
+  int durations[] = {10, 30, 60, 5};
+  const struct Timeline* timeline = timeline_create(4, durations);
+
+  // Checks
+  cmp_ok(timeline_timestep_at(timeline, -1), "==", -1,
+         "offset -1 is out of timeline");
+  cmp_ok(timeline_timestep_at(timeline, 0), "==", 0,
+         "offset 0 is in timestep 0");
+  cmp_ok(timeline_timestep_at(timeline, 9), "==", 0,
+         "offset 9 is in timestep 0");
+  cmp_ok(timeline_timestep_at(timeline, 10), "==", 1,
+         "offset 10 is in timestep 1");
+  cmp_ok(timeline_timestep_at(timeline, 99), "==", 2,
+         "offset 99 is in timestep 2");
+  cmp_ok(timeline_timestep_at(timeline, 104), "==", 3,
+         "offset 104 is in timestep 3");
+  cmp_ok(timeline_timestep_at(timeline, 105), "==", -1,
+         "offset 105 is out of timeline");
+
+  // Teardown
+  timeline_release(timeline);
 }
 
 /**
@@ -84,11 +131,10 @@ void test_timeline_to_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline;
-  timeline_initialize(&timeline, 3, durations);
+  const struct Timeline* timeline = timeline_create(3, durations);
 
   // Checks
-  json_t* j = timeline_to_json(&timeline);
+  json_t* j = timeline_to_json(timeline);
   ok(json_is_object(j), "json value is an object");
   cmp_ok(json_object_size(j), "==", 1, "json object has size 1");
   const json_t* j_durations = json_object_get(j, "future-durations");
@@ -107,7 +153,7 @@ void test_timeline_to_json(void) {
 
   // Teardown
   json_decref(j);
-  timeline_free(&timeline);
+  timeline_release(timeline);
 }
 
 /**
@@ -118,25 +164,25 @@ void test_timeline_from_json(void) {
 
   // Setup
   int durations[] = {10, 30, 60};
-  struct Timeline timeline, json_timeline;
-  timeline_initialize(&timeline, 3, durations);
-  json_t* j = timeline_to_json(&timeline);
-  timeline_from_json(&json_timeline, j);
+  const struct Timeline* timeline = timeline_create(3, durations);
+  json_t* j = timeline_to_json(timeline);
+  const struct Timeline* json_timeline = timeline_from_json(j);
 
   // Checks
-  ok(timeline_are_equal(&timeline, &json_timeline),
+  ok(timeline_are_equal(timeline, json_timeline),
      "manually built timeline and JSON timeline are equal");
 
   // Teardown
   json_decref(j);
-  timeline_free(&timeline);
-  timeline_free(&json_timeline);
+  timeline_release(timeline);
+  timeline_release(json_timeline);
 }
 
 int main(void) {
-  test_timeline_initialize();
+  test_timeline_create();
   test_timeline_are_equal();
-  test_timeline_copy();
+  test_timeline_sharing();
+  test_timeline_timestep_at();
   test_timeline_to_json();
   test_timeline_from_json();
   done_testing();
@@ -6,25 +6,74 @@
 
 #include "validation.h"
 
-// Creation
+// The number of buckets of the timeline registry
+#define TIMELINE_REGISTRY_BUCKETS 64
+
+// Registry
 // --------
 
-void timeline_initialize(struct Timeline* timeline,
-                         unsigned int num_future_timesteps,
-                         const int* future_durations) {
-  timeline->num_future_timesteps = num_future_timesteps;
-  timeline->future_durations = malloc(num_future_timesteps * sizeof(int));
-  memcpy(timeline->future_durations,
-         future_durations,
-         num_future_timesteps * sizeof(int));
+// The timelines in use, by hash bucket
+static struct Timeline* timeline_registry[TIMELINE_REGISTRY_BUCKETS];
+
+/**
+ * Computes the FNV-1a hash of timeline durations
+ *
+ * @param num_future_timesteps  The number of future timesteps
+ * @param future_durations      The duration of each future timesteps
+ * @return                      The hash
+ */
+unsigned int timeline_hash(unsigned int num_future_timesteps,
+                           const int* future_durations) {
+  unsigned int hash = 2166136261u ^ num_future_timesteps;
+  const unsigned char* bytes = (const unsigned char*)future_durations;
+  for (size_t i = 0; i < num_future_timesteps * sizeof(int); ++i) {
+    hash ^= bytes[i];
+    hash *= 16777619u;
+  }
+  return hash;
 }
 
-void timeline_copy(struct Timeline* dest, const struct Timeline* src) {
-  timeline_initialize(dest, src->num_future_timesteps, src->future_durations);
+// Creation
+// --------
+
+const struct Timeline* timeline_create(unsigned int num_future_timesteps,
+                                       const int* future_durations) {
+  unsigned int hash = timeline_hash(num_future_timesteps, future_durations);
+  struct Timeline** bucket =
+    timeline_registry + hash % TIMELINE_REGISTRY_BUCKETS;
+  for (struct Timeline* timeline = *bucket;
+       timeline != NULL;
+       timeline = timeline->next)
+    if (timeline->hash == hash &&
+        timeline->num_future_timesteps == num_future_timesteps &&
+        (num_future_timesteps == 0 ||
+         memcmp(timeline->future_durations,
+                future_durations,
+                num_future_timesteps * sizeof(int)) == 0))
+      return timeline_retain(timeline);
+  // The durations and offsets are allocated along with the timeline
+  struct Timeline* timeline =
+    malloc(sizeof(struct Timeline) +
+           (num_future_timesteps + 1) * sizeof(long) +
+           num_future_timesteps * sizeof(int));
+  long* start_offsets = (long*)(timeline + 1);
+  int* durations = (int*)(start_offsets + num_future_timesteps + 1);
+  start_offsets[0] = 0;
+  for (unsigned int t = 0; t < num_future_timesteps; ++t) {
+    durations[t] = future_durations[t];
+    start_offsets[t + 1] = start_offsets[t] + future_durations[t];
+  }
+  timeline->num_future_timesteps = num_future_timesteps;
+  timeline->future_durations = durations;
+  timeline->start_offsets = start_offsets;
+  timeline->hash = hash;
+  timeline->num_references = 1;
+  timeline->next = *bucket;
+  *bucket = timeline;
+  return timeline;
 }
 
-void timeline_from_json(struct Timeline* timeline,
-                        json_t* j) {
+const struct Timeline* timeline_from_json(json_t* j) {
   ensure_json_is_object(j);
   ensure_json_object_has_size(j, 1);
   ensure_json_object_contains_key(j, JSON_TIMELINE_FUTURE_DURATIONS);
@@ -32,18 +81,34 @@ void timeline_from_json(struct Timeline* timeline,
     json_object_get(j, JSON_TIMELINE_FUTURE_DURATIONS);
   ensure_json_is_array_of_integers(j_future_durations);
   unsigned int num_future_timesteps = json_array_size(j_future_durations);
-  int future_durations[num_future_timesteps];
+  int* future_durations = malloc(num_future_timesteps * sizeof(int));
   for (int t = 0; t < num_future_timesteps; ++t)
     future_durations[t] =
       json_integer_value(json_array_get(j_future_durations, t));
-  timeline_initialize(timeline, num_future_timesteps, future_durations);
+  const struct Timeline* timeline =
+    timeline_create(num_future_timesteps, future_durations);
+  free(future_durations);
+  return timeline;
+}
+
+const struct Timeline* timeline_retain(const struct Timeline* timeline) {
+  ++((struct Timeline*)timeline)->num_references;
+  return timeline;
 }
 
 // Destruction
 // -----------
 
-void timeline_free(struct Timeline* timeline) {
-  free(timeline->future_durations);
+void timeline_release(const struct Timeline* timeline) {
+  struct Timeline* released = (struct Timeline*)timeline;
+  if (--released->num_references > 0)
+    return;
+  struct Timeline** link =
+    timeline_registry + released->hash % TIMELINE_REGISTRY_BUCKETS;
+  while (*link != released)
+    link = &(*link)->next;
+  *link = released->next;
+  free(released);
 }
 
 // Accessors
@@ -51,12 +116,26 @@ void timeline_free(struct Timeline* timeline) {
 
 bool timeline_are_equal(const struct Timeline* timeline1,
                         const struct Timeline* timeline2) {
-  if (timeline1->num_future_timesteps != timeline2->num_future_timesteps)
-    return false;
-  for (int t = 0; t < timeline1->num_future_timesteps; ++t)
-    if (timeline1->future_durations[t] != timeline2->future_durations[t])
-      return false;
-  return true;
+  return timeline1 == timeline2;
+}
+
+long timeline_total_duration(const struct Timeline* timeline) {
+  return timeline->start_offsets[timeline->num_future_timesteps];
+}
+
+int timeline_timestep_at(const struct Timeline* timeline, long offset) {
+  if (offset < 0 || offset >= timeline_total_duration(timeline))
+    return -1;
+  // Find the last timestep starting at or before the offset
+  unsigned int low = 0, high = timeline->num_future_timesteps;
+  while (high - low > 1) {
+    unsigned int middle = low + (high - low) / 2;
+    if (timeline->start_offsets[middle] <= offset)
+      low = middle;
+    else
+      high = middle;
+  }
+  return low;
 }
 
 void timeline_print(const struct Timeline* timeline) {
@@ -13,53 +13,73 @@
 // Type
 // ----
 
+// An immutable timeline
+//
+// Timelines are shared: creating a timeline with the same durations as an
+// existing one returns the existing one, with one more reference. Therefore,
+// two timelines are equal if and only if they are the same object.
+//
+// The start offset of each future timestep, in minutes from the start of the
+// first one, is precomputed, so that the timestep containing a given offset
+// is found by binary search.
 struct Timeline {
   // The number of future timesteps
   unsigned int num_future_timesteps;
   // The future timesteps durations in minutes
-  int* future_durations;
+  const int* future_durations;
+  // The start offsets of the future timesteps in minutes, followed by the
+  // total duration of the timeline
+  const long* start_offsets;
+  // The hash of the durations
+  unsigned int hash;
+  // The number of references to the timeline
+  unsigned int num_references;
+  // The next timeline with the same hash bucket in the registry
+  struct Timeline* next;
 };
 
-// Initialization
-// --------------
+// Creation
+// --------
 
 /**
- * Initializes a timeline
+ * Returns a timeline with given durations
+ *
+ * The timeline must be released with timeline_release.
  *
- * @param timeline              The timeline to initialize
  * @param num_future_timesteps  The number of future timesteps
  * @param future_durations      The duration of each future timesteps
+ * @return                      The timeline
  */
-void timeline_initialize(struct Timeline* timeline,
-                         unsigned int num_future_timesteps,
-                         const int* future_durations);
+const struct Timeline* timeline_create(unsigned int num_future_timesteps,
+                                       const int* future_durations);
 
 /**
- * Initializes a timeline from another one
+ * Returns a timeline read from a JSON value
+ *
+ * The timeline must be released with timeline_release.
  *
- * @param dest  The destination timeline
- * @param src   The source timeline
+ * @param j  The JSON value
+ * @return   The timeline
  */
-void timeline_copy(struct Timeline* dest, const struct Timeline* src);
+const struct Timeline* timeline_from_json(json_t* j);
 
 /**
- * Initializes a timeline from a JSON value
+ * Adds a reference to a timeline
  *
- * @param timeline  The timeline to initialize
- * @param j         The JSON value
+ * @param timeline  The timeline
+ * @return          The timeline
  */
-void timeline_from_json(struct Timeline* timeline,
-                        json_t* j);
+const struct Timeline* timeline_retain(const struct Timeline* timeline);
 
 // Destruction
 // -----------
 
 /**
- * Frees a timeline
+ * Removes a reference to a timeline, freeing it if it was the last one
  *
- * @param timeline  The timeline to delete
+ * @param timeline  The timeline to release
  */
-void timeline_free(struct Timeline* timeline);
+void timeline_release(const struct Timeline* timeline);
 
 // Accessors
 // ---------
@@ -74,6 +94,24 @@ void timeline_free(struct Timeline* timeline);
 bool timeline_are_equal(const struct Timeline* timeline1,
                         const struct Timeline* timeline2);
 
+/**
+ * Returns the total duration of a timeline in minutes
+ *
+ * @param timeline  The timeline
+ * @return          The sum of the future durations
+ */
+long timeline_total_duration(const struct Timeline* timeline);
+
+/**
+ * Returns the future timestep containing a given offset
+ *
+ * @param timeline  The timeline
+ * @param offset    The offset in minutes from the start of the timeline
+ * @return          The timestep containing the offset, or -1 if the offset is
+ *                  out of the timeline
+ */
+int timeline_timestep_at(const struct Timeline* timeline, long offset);
+
 /**
  * Prints a timeline to stdout
  *
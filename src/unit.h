@@ -1,7 +1,69 @@
 #ifndef UNIT_H
 #define UNIT_H
 
+#include <stdint.h>
+
 // A megawatt
 typedef double mw;
 
+// Storage of time series
+// ----------------------
+
+// The storage modes of the values of time series in megawatts
+#define MW_STORAGE_DOUBLE 0
+#define MW_STORAGE_FLOAT 1
+#define MW_STORAGE_FIXED 2
+
+// The storage mode of time series, chosen at compile time
+#ifndef MW_STORAGE
+#define MW_STORAGE MW_STORAGE_DOUBLE
+#endif
+
+// The number of fixed-point units in a megawatt, i.e. a resolution of 0.1 MW
+#define MW_FIXED_POINT_SCALE 10
+
+// A megawatt as stored in a time series
+//
+// Time series dominate the memory of long horizons. They can be stored in
+// single precision or as integers in tenths of megawatts, halving their size,
+// while computations are still done on `mw` values.
+#if MW_STORAGE == MW_STORAGE_FLOAT
+typedef float stored_mw;
+#elif MW_STORAGE == MW_STORAGE_FIXED
+typedef int32_t stored_mw;
+#else
+typedef double stored_mw;
+#endif
+
+/**
+ * Converts a megawatt value to its stored representation
+ *
+ * In fixed-point mode, the value is rounded to the nearest unit.
+ *
+ * @param value  The value
+ * @return       The stored value
+ */
+static inline stored_mw mw_store(mw value) {
+#if MW_STORAGE == MW_STORAGE_FIXED
+  mw scaled = value * MW_FIXED_POINT_SCALE;
+  return (stored_mw)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+#else
+  return (stored_mw)value;
+#endif
+}
+
+/**
+ * Converts a stored megawatt value back to a megawatt value
+ *
+ * @param value  The stored value
+ * @return       The value
+ */
+static inline mw mw_load(stored_mw value) {
+#if MW_STORAGE == MW_STORAGE_FIXED
+  return (mw)value / MW_FIXED_POINT_SCALE;
+#else
+  return (mw)value;
+#endif
+}
+
 #endif
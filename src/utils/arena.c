@@ -0,0 +1,112 @@
+#include "arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Help functions
+// --------------
+
+/**
+ * Rounds a size up to a multiple of an alignment
+ *
+ * @param size       The size
+ * @param alignment  The alignment, a power of 2
+ * @return           The smallest multiple of the alignment not below the size
+ */
+size_t arena_align(size_t size, size_t alignment) {
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * Allocates a block with a given capacity
+ *
+ * The header of the block and its data share the same allocation, the data
+ * starting on an ARENA_MAX_ALIGNMENT boundary.
+ *
+ * @param capacity  The number of bytes of the block
+ * @return          The block
+ */
+struct ArenaBlock* arena_new_block(size_t capacity) {
+  size_t header_size = arena_align(sizeof(struct ArenaBlock),
+                                   ARENA_MAX_ALIGNMENT);
+  size_t size = arena_align(header_size + capacity, ARENA_MAX_ALIGNMENT);
+  struct ArenaBlock* block = aligned_alloc(ARENA_MAX_ALIGNMENT, size);
+  block->capacity = capacity;
+  block->used = 0;
+  block->data = (char*)block + header_size;
+  return block;
+}
+
+// Initialization
+// --------------
+
+void arena_initialize(struct Arena* arena, size_t block_size) {
+  arena->blocks = NULL;
+  arena->block_size = block_size;
+  arena->last = NULL;
+}
+
+// Destruction
+// -----------
+
+void arena_delete(struct Arena* arena) {
+  while (arena->blocks != NULL) {
+    struct ArenaBlock* block = arena->blocks;
+    arena->blocks = block->next;
+    free(block);
+  }
+}
+
+// Allocation
+// ----------
+
+void* arena_allocate(struct Arena* arena, size_t size, size_t alignment) {
+  struct ArenaBlock* block = arena->blocks;
+  if (block != NULL) {
+    size_t offset = arena_align(block->used, alignment);
+    if (offset + size <= block->capacity) {
+      block->used = offset + size;
+      arena->last = block->data + offset;
+      return arena->last;
+    }
+  }
+  if (size > arena->block_size / 4) {
+    // A large allocation gets its own block, kept behind the current one
+    struct ArenaBlock* large = arena_new_block(size);
+    large->used = size;
+    if (block == NULL) {
+      large->next = NULL;
+      arena->blocks = large;
+      arena->last = NULL;
+    } else {
+      large->next = block->next;
+      block->next = large;
+    }
+    return large->data;
+  }
+  block = arena_new_block(arena->block_size);
+  block->next = arena->blocks;
+  block->used = size;
+  arena->blocks = block;
+  arena->last = block->data;
+  return block->data;
+}
+
+void* arena_reallocate(struct Arena* arena,
+                       void* memory,
+                       size_t old_size,
+                       size_t new_size,
+                       size_t alignment) {
+  struct ArenaBlock* block = arena->blocks;
+  if (memory != NULL && memory == arena->last) {
+    size_t offset = (char*)memory - block->data;
+    if (offset + new_size <= block->capacity) {
+      block->used = offset + new_size;
+      return memory;
+    }
+  }
+  void* new_memory = arena_allocate(arena, new_size, alignment);
+  if (old_size > 0)
+    memcpy(new_memory, memory, old_size < new_size ? old_size : new_size);
+  return new_memory;
+}
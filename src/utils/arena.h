@@ -0,0 +1,88 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// The largest alignment supported by an arena
+#define ARENA_MAX_ALIGNMENT 64
+
+// Types
+// -----
+
+// A block of memory of an arena
+struct ArenaBlock {
+  struct ArenaBlock* next;  // The previously allocated block
+  size_t capacity;          // The number of bytes of the block
+  size_t used;              // The number of used bytes of the block
+  char* data;               // The bytes of the block
+};
+
+// A region allocator
+//
+// Memory is carved from large blocks by bumping an offset, and is only
+// released when the whole arena is deleted. Allocations larger than a
+// fraction of the block size get a block of their own.
+struct Arena {
+  struct ArenaBlock* blocks;  // The current block, NULL if none
+  size_t block_size;          // The size of regular blocks
+  void* last;                 // The last allocation of the current block
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes an empty arena
+ *
+ * No memory is allocated until the first allocation.
+ *
+ * @param arena       The arena to initialize
+ * @param block_size  The size in bytes of regular blocks
+ */
+void arena_initialize(struct Arena* arena, size_t block_size);
+
+// Destruction
+// -----------
+
+/**
+ * Deletes an arena, releasing all memory allocated from it
+ *
+ * @param arena  The arena to delete
+ */
+void arena_delete(struct Arena* arena);
+
+// Allocation
+// ----------
+
+/**
+ * Allocates memory from an arena
+ *
+ * @param arena      The arena
+ * @param size       The number of bytes to allocate
+ * @param alignment  The alignment of the memory, a power of 2 of at most
+ *                   ARENA_MAX_ALIGNMENT
+ * @return           The allocated memory
+ */
+void* arena_allocate(struct Arena* arena, size_t size, size_t alignment);
+
+/**
+ * Resizes memory allocated from an arena
+ *
+ * The memory is grown in place if it is the last allocation of the current
+ * block and the block has room for it. Otherwise, new memory is allocated and
+ * the content is copied.
+ *
+ * @param arena      The arena
+ * @param memory     The memory to resize, or NULL
+ * @param old_size   The current size of the memory
+ * @param new_size   The new size of the memory
+ * @param alignment  The alignment of the memory
+ * @return           The (possibly moved) memory
+ */
+void* arena_reallocate(struct Arena* arena,
+                       void* memory,
+                       size_t old_size,
+                       size_t new_size,
+                       size_t alignment);
+
+#endif
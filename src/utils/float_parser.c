@@ -0,0 +1,115 @@
+#include "float_parser.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The largest integer such that all the smaller integers are doubles
+#define FLOAT_PARSER_MAX_EXACT_INTEGER (UINT64_C(1) << 53)
+// The largest power of ten that is a double
+#define FLOAT_PARSER_MAX_EXACT_POWER 22
+// The number of significant digits that fit in 64 bits
+#define FLOAT_PARSER_MAX_DIGITS 19
+// The length of numbers given to strtod without allocation
+#define FLOAT_PARSER_BUFFER_SIZE 64
+
+// The powers of ten that are doubles
+static const double FLOAT_PARSER_POWERS[] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+  1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Help functions
+// --------------
+
+/**
+ * Indicates if a character is a decimal digit
+ *
+ * @param c  The character
+ * @return   true if and only if c is a digit
+ */
+bool float_parser_is_digit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+/**
+ * Parses a number with strtod
+ *
+ * @param start  The start of the number
+ * @param end    The end of the number
+ * @return       The number
+ */
+double float_parser_fallback(const char* start, const char* end) {
+  size_t length = end - start;
+  char buffer[FLOAT_PARSER_BUFFER_SIZE];
+  char* text = length < sizeof(buffer) ? buffer : malloc(length + 1);
+  memcpy(text, start, length);
+  text[length] = '\0';
+  double value = strtod(text, NULL);
+  if (text != buffer)
+    free(text);
+  return value;
+}
+
+// Parsing
+// -------
+
+const char* float_parse(const char* start, const char* end, double* value) {
+  const char* c = start;
+  bool negative = c < end && *c == '-';
+  if (c < end && (*c == '-' || *c == '+'))
+    ++c;
+  // The significant digits, and the exponent of the last one
+  uint64_t mantissa = 0;
+  int num_digits = 0;
+  long exponent = 0;
+  bool truncated = false;
+  bool has_digits = false;
+  for (bool after_dot = false; c < end; ++c) {
+    if (*c == '.' && !after_dot) {
+      after_dot = true;
+      continue;
+    } else if (!float_parser_is_digit(*c)) {
+      break;
+    }
+    has_digits = true;
+    if (num_digits < FLOAT_PARSER_MAX_DIGITS) {
+      mantissa = 10 * mantissa + (*c - '0');
+      num_digits += mantissa > 0;
+      exponent -= after_dot;
+    } else {
+      truncated |= *c != '0';
+      exponent += !after_dot;
+    }
+  }
+  if (!has_digits)
+    return NULL;
+  if (c < end && (*c == 'e' || *c == 'E')) {
+    const char* e = c + 1;
+    bool negative_exponent = e < end && *e == '-';
+    if (e < end && (*e == '-' || *e == '+'))
+      ++e;
+    if (e == end || !float_parser_is_digit(*e))
+      return NULL;
+    long explicit_exponent = 0;
+    for (; e < end && float_parser_is_digit(*e); ++e)
+      if (explicit_exponent < 100000)
+        explicit_exponent = 10 * explicit_exponent + (*e - '0');
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    c = e;
+  }
+  if (!truncated && mantissa <= FLOAT_PARSER_MAX_EXACT_INTEGER &&
+      exponent >= -FLOAT_PARSER_MAX_EXACT_POWER &&
+      exponent <= FLOAT_PARSER_MAX_EXACT_POWER) {
+    double result = (double)mantissa;
+    if (exponent < 0)
+      result /= FLOAT_PARSER_POWERS[-exponent];
+    else
+      result *= FLOAT_PARSER_POWERS[exponent];
+    *value = negative ? -result : result;
+  } else {
+    *value = float_parser_fallback(start, c);
+  }
+  return c;
+}
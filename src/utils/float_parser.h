@@ -0,0 +1,27 @@
+#ifndef FLOAT_PARSER_H
+#define FLOAT_PARSER_H
+
+// Parsing decimal numbers
+// -----------------------
+//
+// Most numbers in data files have at most 15 significant digits and a small
+// exponent (e.g. 1234.5 or 0.001). Such a number is an integer of at most 53
+// bits scaled by a power of ten that is exact in double precision, so it is
+// obtained exactly with a single multiplication or division (Clinger's fast
+// path). The other numbers are given to strtod, which rounds correctly too.
+
+/**
+ * Parses a decimal number at the start of a text
+ *
+ * The number has the syntax of JSON numbers, except that a leading "+", a
+ * leading "." and leading zeros are accepted: [+-]digits[.digits][e[+-]digits]
+ *
+ * @param start  The start of the text
+ * @param end    The end of the text
+ * @param value  The parsed number
+ * @return       The end of the number in the text, or NULL if the text does
+ *               not start with a number
+ */
+const char* float_parse(const char* start, const char* end, double* value);
+
+#endif
@@ -0,0 +1,341 @@
+#include "grisu.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// The exponents bounding the scaled boundaries, so that their integral part
+// fits in 32 bits
+#define GRISU_ALPHA -60
+#define GRISU_GAMMA -32
+// The decimal exponent of the first cached power of ten
+#define GRISU_CACHED_POWERS_MIN_EXPONENT -300
+// The decimal exponent step between consecutive cached powers of ten
+#define GRISU_CACHED_POWERS_STEP 8
+
+// Types
+// -----
+
+// A floating point number f * 2^e, with a 64-bit significand
+struct DiyFp {
+  uint64_t f;  // The significand
+  int e;       // The binary exponent
+};
+
+// A normalized power of ten f * 2^e ~ 10^k
+struct CachedPower {
+  uint64_t f;  // The significand
+  int e;       // The binary exponent
+  int k;       // The decimal exponent
+};
+
+// The powers of ten 10^-300, 10^-292, ..., 10^324, rounded to 64 bits
+static const struct CachedPower GRISU_CACHED_POWERS[] = {
+  {UINT64_C(0xAB70FE17C79AC6CA), -1060, -300},
+  {UINT64_C(0xFF77B1FCBEBCDC4F), -1034, -292},
+  {UINT64_C(0xBE5691EF416BD60C), -1007, -284},
+  {UINT64_C(0x8DD01FAD907FFC3C), -980, -276},
+  {UINT64_C(0xD3515C2831559A83), -954, -268},
+  {UINT64_C(0x9D71AC8FADA6C9B5), -927, -260},
+  {UINT64_C(0xEA9C227723EE8BCB), -901, -252},
+  {UINT64_C(0xAECC49914078536D), -874, -244},
+  {UINT64_C(0x823C12795DB6CE57), -847, -236},
+  {UINT64_C(0xC21094364DFB5637), -821, -228},
+  {UINT64_C(0x9096EA6F3848984F), -794, -220},
+  {UINT64_C(0xD77485CB25823AC7), -768, -212},
+  {UINT64_C(0xA086CFCD97BF97F4), -741, -204},
+  {UINT64_C(0xEF340A98172AACE5), -715, -196},
+  {UINT64_C(0xB23867FB2A35B28E), -688, -188},
+  {UINT64_C(0x84C8D4DFD2C63F3B), -661, -180},
+  {UINT64_C(0xC5DD44271AD3CDBA), -635, -172},
+  {UINT64_C(0x936B9FCEBB25C996), -608, -164},
+  {UINT64_C(0xDBAC6C247D62A584), -582, -156},
+  {UINT64_C(0xA3AB66580D5FDAF6), -555, -148},
+  {UINT64_C(0xF3E2F893DEC3F126), -529, -140},
+  {UINT64_C(0xB5B5ADA8AAFF80B8), -502, -132},
+  {UINT64_C(0x87625F056C7C4A8B), -475, -124},
+  {UINT64_C(0xC9BCFF6034C13053), -449, -116},
+  {UINT64_C(0x964E858C91BA2655), -422, -108},
+  {UINT64_C(0xDFF9772470297EBD), -396, -100},
+  {UINT64_C(0xA6DFBD9FB8E5B88F), -369, -92},
+  {UINT64_C(0xF8A95FCF88747D94), -343, -84},
+  {UINT64_C(0xB94470938FA89BCF), -316, -76},
+  {UINT64_C(0x8A08F0F8BF0F156B), -289, -68},
+  {UINT64_C(0xCDB02555653131B6), -263, -60},
+  {UINT64_C(0x993FE2C6D07B7FAC), -236, -52},
+  {UINT64_C(0xE45C10C42A2B3B06), -210, -44},
+  {UINT64_C(0xAA242499697392D3), -183, -36},
+  {UINT64_C(0xFD87B5F28300CA0E), -157, -28},
+  {UINT64_C(0xBCE5086492111AEB), -130, -20},
+  {UINT64_C(0x8CBCCC096F5088CC), -103, -12},
+  {UINT64_C(0xD1B71758E219652C), -77, -4},
+  {UINT64_C(0x9C40000000000000), -50, 4},
+  {UINT64_C(0xE8D4A51000000000), -24, 12},
+  {UINT64_C(0xAD78EBC5AC620000), 3, 20},
+  {UINT64_C(0x813F3978F8940984), 30, 28},
+  {UINT64_C(0xC097CE7BC90715B3), 56, 36},
+  {UINT64_C(0x8F7E32CE7BEA5C70), 83, 44},
+  {UINT64_C(0xD5D238A4ABE98068), 109, 52},
+  {UINT64_C(0x9F4F2726179A2245), 136, 60},
+  {UINT64_C(0xED63A231D4C4FB27), 162, 68},
+  {UINT64_C(0xB0DE65388CC8ADA8), 189, 76},
+  {UINT64_C(0x83C7088E1AAB65DB), 216, 84},
+  {UINT64_C(0xC45D1DF942711D9A), 242, 92},
+  {UINT64_C(0x924D692CA61BE758), 269, 100},
+  {UINT64_C(0xDA01EE641A708DEA), 295, 108},
+  {UINT64_C(0xA26DA3999AEF774A), 322, 116},
+  {UINT64_C(0xF209787BB47D6B85), 348, 124},
+  {UINT64_C(0xB454E4A179DD1877), 375, 132},
+  {UINT64_C(0x865B86925B9BC5C2), 402, 140},
+  {UINT64_C(0xC83553C5C8965D3D), 428, 148},
+  {UINT64_C(0x952AB45CFA97A0B3), 455, 156},
+  {UINT64_C(0xDE469FBD99A05FE3), 481, 164},
+  {UINT64_C(0xA59BC234DB398C25), 508, 172},
+  {UINT64_C(0xF6C69A72A3989F5C), 534, 180},
+  {UINT64_C(0xB7DCBF5354E9BECE), 561, 188},
+  {UINT64_C(0x88FCF317F22241E2), 588, 196},
+  {UINT64_C(0xCC20CE9BD35C78A5), 614, 204},
+  {UINT64_C(0x98165AF37B2153DF), 641, 212},
+  {UINT64_C(0xE2A0B5DC971F303A), 667, 220},
+  {UINT64_C(0xA8D9D1535CE3B396), 694, 228},
+  {UINT64_C(0xFB9B7CD9A4A7443C), 720, 236},
+  {UINT64_C(0xBB764C4CA7A44410), 747, 244},
+  {UINT64_C(0x8BAB8EEFB6409C1A), 774, 252},
+  {UINT64_C(0xD01FEF10A657842C), 800, 260},
+  {UINT64_C(0x9B10A4E5E9913129), 827, 268},
+  {UINT64_C(0xE7109BFBA19C0C9D), 853, 276},
+  {UINT64_C(0xAC2820D9623BF429), 880, 284},
+  {UINT64_C(0x80444B5E7AA7CF85), 907, 292},
+  {UINT64_C(0xBF21E44003ACDD2D), 933, 300},
+  {UINT64_C(0x8E679C2F5E44FF8F), 960, 308},
+  {UINT64_C(0xD433179D9C8CB841), 986, 316},
+  {UINT64_C(0x9E19DB92B4E31BA9), 1013, 324},
+};
+
+// Help functions
+// --------------
+
+/**
+ * Returns the difference of two numbers with the same exponent
+ *
+ * @param x  The first number
+ * @param y  The second number, not greater than x
+ * @return   x - y
+ */
+struct DiyFp grisu_subtract(struct DiyFp x, struct DiyFp y) {
+  struct DiyFp result = {x.f - y.f, x.e};
+  return result;
+}
+
+/**
+ * Returns the product of two numbers, rounded to 64 bits
+ *
+ * @param x  The first number
+ * @param y  The second number
+ * @return   x * y
+ */
+struct DiyFp grisu_multiply(struct DiyFp x, struct DiyFp y) {
+  uint64_t x_lo = x.f & 0xFFFFFFFFu, x_hi = x.f >> 32;
+  uint64_t y_lo = y.f & 0xFFFFFFFFu, y_hi = y.f >> 32;
+  uint64_t p0 = x_lo * y_lo, p1 = x_lo * y_hi,
+           p2 = x_hi * y_lo, p3 = x_hi * y_hi;
+  uint64_t middle = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+  middle += UINT64_C(1) << 31;
+  struct DiyFp result = {p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32),
+                         x.e + y.e + 64};
+  return result;
+}
+
+/**
+ * Shifts a number so that the highest bit of its significand is set
+ *
+ * @param x  The number, not 0
+ * @return   The normalized number
+ */
+struct DiyFp grisu_normalize(struct DiyFp x) {
+  while ((x.f >> 63) == 0) {
+    x.f <<= 1;
+    --x.e;
+  }
+  return x;
+}
+
+/**
+ * Shifts a number to a given lower binary exponent
+ *
+ * @param x         The number
+ * @param exponent  The binary exponent, at most the one of x
+ * @return          The shifted number
+ */
+struct DiyFp grisu_normalize_to(struct DiyFp x, int exponent) {
+  x.f <<= x.e - exponent;
+  x.e = exponent;
+  return x;
+}
+
+/**
+ * Computes a double and the boundaries of the doubles rounding to it
+ *
+ * @param value  The double, finite and strictly positive
+ * @param v      The normalized double
+ * @param minus  The lower boundary, with the exponent of plus
+ * @param plus   The normalized upper boundary
+ */
+void grisu_boundaries(double value,
+                      struct DiyFp* v,
+                      struct DiyFp* minus,
+                      struct DiyFp* plus) {
+  const uint64_t hidden_bit = UINT64_C(1) << 52;
+  const int bias = 1023 + 52;
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  uint64_t biased_exponent = bits >> 52;
+  uint64_t fraction = bits & (hidden_bit - 1);
+  struct DiyFp x = {fraction, 1 - bias};
+  if (biased_exponent != 0) {
+    x.f = fraction + hidden_bit;
+    x.e = (int)biased_exponent - bias;
+  }
+  // The lower boundary is closer for powers of two, whose predecessor has a
+  // smaller exponent
+  bool lower_is_closer = fraction == 0 && biased_exponent > 1;
+  struct DiyFp upper = {2 * x.f + 1, x.e - 1};
+  struct DiyFp lower = {2 * x.f - 1, x.e - 1};
+  if (lower_is_closer) {
+    lower.f = 4 * x.f - 1;
+    lower.e = x.e - 2;
+  }
+  *plus = grisu_normalize(upper);
+  *minus = grisu_normalize_to(lower, plus->e);
+  *v = grisu_normalize(x);
+}
+
+/**
+ * Returns the cached power of ten scaling a binary exponent into
+ * [GRISU_ALPHA, GRISU_GAMMA]
+ *
+ * @param e  The binary exponent
+ * @return   The cached power of ten
+ */
+struct CachedPower grisu_cached_power(int e) {
+  // k = ceil((GRISU_ALPHA - e - 1) * log10(2)), 78913 / 2^18 ~ log10(2)
+  int f = GRISU_ALPHA - e - 1;
+  int k = (f * 78913) / (1 << 18) + (f > 0);
+  int index = (-GRISU_CACHED_POWERS_MIN_EXPONENT + k +
+               (GRISU_CACHED_POWERS_STEP - 1)) / GRISU_CACHED_POWERS_STEP;
+  return GRISU_CACHED_POWERS[index];
+}
+
+/**
+ * Returns the number of decimal digits of an integer and its largest power
+ * of ten
+ *
+ * @param n      The integer, not 0
+ * @param power  The largest power of ten not greater than n
+ * @return       The number of decimal digits of n
+ */
+int grisu_num_digits(uint32_t n, uint32_t* power) {
+  int num_digits = 1;
+  *power = 1;
+  while (num_digits < 10 && n / *power >= 10) {
+    *power *= 10;
+    ++num_digits;
+  }
+  return num_digits;
+}
+
+/**
+ * Moves the last digit towards the double while it stays within the
+ * boundaries
+ *
+ * @param digits      The digits
+ * @param num_digits  The number of digits
+ * @param distance    The distance from the upper boundary to the double
+ * @param delta       The distance between the boundaries
+ * @param rest        The distance from the upper boundary to the digits
+ * @param ten_k       The value of one unit of the last digit
+ */
+void grisu_round(char* digits,
+                 int num_digits,
+                 uint64_t distance,
+                 uint64_t delta,
+                 uint64_t rest,
+                 uint64_t ten_k) {
+  while (rest < distance && delta - rest >= ten_k &&
+         (rest + ten_k < distance ||
+          distance - rest > rest + ten_k - distance)) {
+    --digits[num_digits - 1];
+    rest += ten_k;
+  }
+}
+
+/**
+ * Generates the shortest digits between two scaled boundaries
+ *
+ * @param digits    The buffer receiving the digits
+ * @param exponent  The decimal exponent of the scaling, updated to the one of
+ *                  the last digit
+ * @param minus     The scaled lower boundary
+ * @param w         The scaled double
+ * @param plus      The scaled upper boundary
+ * @return          The number of digits
+ */
+int grisu_generate(char* digits,
+                   int* exponent,
+                   struct DiyFp minus,
+                   struct DiyFp w,
+                   struct DiyFp plus) {
+  uint64_t delta = grisu_subtract(plus, minus).f;
+  uint64_t distance = grisu_subtract(plus, w).f;
+  struct DiyFp one = {UINT64_C(1) << -plus.e, plus.e};
+  uint32_t integral = (uint32_t)(plus.f >> -one.e);
+  uint64_t fractional = plus.f & (one.f - 1);
+  uint32_t power;
+  int n = grisu_num_digits(integral, &power);
+  int num_digits = 0;
+  // Digits of the integral part
+  while (n > 0) {
+    digits[num_digits++] = (char)('0' + integral / power);
+    integral %= power;
+    --n;
+    uint64_t rest = ((uint64_t)integral << -one.e) + fractional;
+    if (rest <= delta) {
+      *exponent += n;
+      grisu_round(digits, num_digits, distance, delta, rest,
+                  (uint64_t)power << -one.e);
+      return num_digits;
+    }
+    power /= 10;
+  }
+  // Digits of the fractional part
+  int m = 0;
+  do {
+    fractional *= 10;
+    digits[num_digits++] = (char)('0' + (fractional >> -one.e));
+    fractional &= one.f - 1;
+    ++m;
+    delta *= 10;
+    distance *= 10;
+  } while (fractional > delta);
+  *exponent -= m;
+  grisu_round(digits, num_digits, distance, delta, fractional, one.f);
+  return num_digits;
+}
+
+// Digits
+// ------
+
+int grisu_digits(double value, char* digits, int* exponent) {
+  struct DiyFp v, minus, plus;
+  grisu_boundaries(value, &v, &minus, &plus);
+  struct CachedPower cached = grisu_cached_power(plus.e);
+  struct DiyFp c = {cached.f, cached.e};
+  struct DiyFp w = grisu_multiply(v, c);
+  struct DiyFp w_minus = grisu_multiply(minus, c);
+  struct DiyFp w_plus = grisu_multiply(plus, c);
+  // The products are only known up to one unit: keep safely inside
+  w_minus.f += 1;
+  w_plus.f -= 1;
+  *exponent = -cached.k;
+  return grisu_generate(digits, exponent, w_minus, w, w_plus);
+}
@@ -0,0 +1,30 @@
+#ifndef GRISU_H
+#define GRISU_H
+
+// The number of significant digits of a double, at most
+#define GRISU_MAX_DIGITS 17
+
+// Shortest decimal digits
+// -----------------------
+//
+// The Grisu2 algorithm of Florian Loitsch ("Printing floating-point numbers
+// quickly and accurately with integers", PLDI 2010) finds, with 64-bit integer
+// arithmetic only, decimal digits that read back to the exact same double.
+// The digits are the shortest such digits for about 99.9% of the doubles, and
+// a few digits longer for the others (e.g. 9999999999999999e7 for 1e23).
+
+/**
+ * Computes the shortest decimal digits of a double
+ *
+ * The double equals digits * 10^exponent once read back, where digits are
+ * read as a decimal integer.
+ *
+ * @param value     The double, finite and strictly positive
+ * @param digits    The buffer receiving the digits, of at least
+ *                  GRISU_MAX_DIGITS characters, not terminated by '\0'
+ * @param exponent  The decimal exponent of the last digit
+ * @return          The number of digits
+ */
+int grisu_digits(double value, char* digits, int* exponent);
+
+#endif
@@ -0,0 +1,200 @@
+#include "hashmap.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// The number of buckets of a non empty hashmap, at least
+#define HASHMAP_INITIAL_CAPACITY 16
+
+// Help functions
+// --------------
+
+/**
+ * Computes the FNV-1a hash of a key
+ *
+ * @param key  The key
+ * @return     The hash of the key
+ */
+unsigned int hashmap_hash(const char* key) {
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < ID_MAX_LENGTH && key[i] != '\0'; ++i) {
+    hash ^= (unsigned char)key[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * Returns the bucket containing a key in a hashmap
+ *
+ * @param hm    The hashmap
+ * @param key   The key
+ * @param hash  The hash of the key
+ * @return      The index of the bucket, or -1 if the key does not exist
+ */
+int hashmap_find_bucket(const struct Hashmap* hm,
+                        const char* key,
+                        unsigned int hash) {
+  if (hm->capacity == 0)
+    return -1;
+  unsigned int mask = hm->capacity - 1;
+  unsigned int b = hash & mask;
+  // Entries are sorted by distance along a probe sequence, so that the search
+  // stops at the first entry closer to its home bucket than the key would be
+  for (unsigned int distance = 1;
+       hm->entries[b].distance >= distance;
+       ++distance, b = (b + 1) & mask) {
+    const struct HashmapEntry* entry = hm->entries + b;
+    if (entry->hash == hash && strncmp(entry->key, key, ID_MAX_LENGTH) == 0)
+      return b;
+  }
+  return -1;
+}
+
+/**
+ * Inserts an entry whose key does not exist in a hashmap with a free bucket
+ *
+ * @param hm     The hashmap
+ * @param entry  The entry to insert, whose distance is ignored
+ */
+void hashmap_insert_entry(struct Hashmap* hm, struct HashmapEntry entry) {
+  unsigned int mask = hm->capacity - 1;
+  unsigned int b = entry.hash & mask;
+  entry.distance = 1;
+  while (hm->entries[b].distance != 0) {
+    if (hm->entries[b].distance < entry.distance) {
+      struct HashmapEntry displaced = hm->entries[b];
+      hm->entries[b] = entry;
+      entry = displaced;
+    }
+    b = (b + 1) & mask;
+    ++entry.distance;
+  }
+  hm->entries[b] = entry;
+}
+
+/**
+ * Returns the value associated with a key, inserting the key if needed
+ *
+ * @param hm   The hashmap
+ * @param key  The key
+ * @return     The value associated with the key
+ */
+union HashmapValue* hashmap_upsert(struct Hashmap* hm, const char* key) {
+  unsigned int hash = hashmap_hash(key);
+  int b = hashmap_find_bucket(hm, key, hash);
+  if (b < 0) {
+    hashmap_reserve(hm, hm->num_entries + 1);
+    struct HashmapEntry entry;
+    strncpy(entry.key, key, ID_MAX_LENGTH);
+    entry.key[ID_MAX_LENGTH] = '\0';
+    entry.hash = hash;
+    entry.value.real = 0.0;
+    hashmap_insert_entry(hm, entry);
+    ++hm->num_entries;
+    b = hashmap_find_bucket(hm, key, hash);
+  }
+  return &hm->entries[b].value;
+}
+
+// Initialization
+// --------------
+
+void hashmap_initialize(struct Hashmap* hm) {
+  hm->num_entries = 0;
+  hm->capacity = 0;
+  hm->entries = NULL;
+}
+
+// Destruction
+// -----------
+
+void hashmap_delete(struct Hashmap* hm) {
+  free(hm->entries);
+}
+
+// Modifiers
+// ---------
+
+void hashmap_reserve(struct Hashmap* hm, unsigned int num_entries) {
+  // The load factor is kept at most 3/4
+  if (4 * num_entries <= 3 * hm->capacity)
+    return;
+  unsigned int capacity = hm->capacity == 0 ?
+                          HASHMAP_INITIAL_CAPACITY :
+                          hm->capacity;
+  while (4 * num_entries > 3 * capacity)
+    capacity *= 2;
+  struct HashmapEntry* entries = hm->entries;
+  unsigned int old_capacity = hm->capacity;
+  hm->capacity = capacity;
+  hm->entries = calloc(capacity, sizeof(struct HashmapEntry));
+  for (unsigned int b = 0; b < old_capacity; ++b)
+    if (entries[b].distance != 0)
+      hashmap_insert_entry(hm, entries[b]);
+  free(entries);
+}
+
+void hashmap_set(struct Hashmap* hm, const char* key, double value) {
+  hashmap_upsert(hm, key)->real = value;
+}
+
+void hashmap_set_int(struct Hashmap* hm, const char* key, int value) {
+  hashmap_upsert(hm, key)->integer = value;
+}
+
+bool hashmap_remove(struct Hashmap* hm, const char* key) {
+  int b = hashmap_find_bucket(hm, key, hashmap_hash(key));
+  if (b < 0)
+    return false;
+  // Shift the following entries of the probe sequence back by one bucket
+  unsigned int mask = hm->capacity - 1;
+  unsigned int next = (b + 1) & mask;
+  while (hm->entries[next].distance > 1) {
+    hm->entries[b] = hm->entries[next];
+    --hm->entries[b].distance;
+    b = next;
+    next = (next + 1) & mask;
+  }
+  hm->entries[b].distance = 0;
+  --hm->num_entries;
+  return true;
+}
+
+// Accessors
+// ---------
+
+const union HashmapValue* hashmap_find(const struct Hashmap* hm,
+                                       const char* key) {
+  int b = hashmap_find_bucket(hm, key, hashmap_hash(key));
+  return b < 0 ? NULL : &hm->entries[b].value;
+}
+
+double hashmap_get(const struct Hashmap* hm, const char* key) {
+  const union HashmapValue* value = hashmap_find(hm, key);
+  return value == NULL ? 0.0 : value->real;
+}
+
+int hashmap_get_int(const struct Hashmap* hm, const char* key) {
+  const union HashmapValue* value = hashmap_find(hm, key);
+  return value == NULL ? 0 : value->integer;
+}
+
+bool hashmap_has_key(const struct Hashmap* hm, const char* key) {
+  return hashmap_find(hm, key) != NULL;
+}
+
+void hashmap_iterator_initialize(struct HashmapIterator* it,
+                                 const struct Hashmap* hm) {
+  it->hm = hm;
+  it->bucket = 0;
+}
+
+const struct HashmapEntry* hashmap_iterator_next(struct HashmapIterator* it) {
+  while (it->bucket < it->hm->capacity) {
+    const struct HashmapEntry* entry = it->hm->entries + it->bucket++;
+    if (entry->distance != 0)
+      return entry;
+  }
+  return NULL;
+}
@@ -0,0 +1,172 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <stdbool.h>
+
+#include "constants.h"
+
+// Types
+// -----
+
+// A value of a hashmap, either a double or an int
+union HashmapValue {
+  double real;  // The value as a double
+  int integer;  // The value as an int
+};
+
+// An entry of a hashmap
+//
+// Keys are stored inline and are truncated to ID_MAX_LENGTH characters.
+struct HashmapEntry {
+  char key[ID_MAX_LENGTH + 1];  // The key
+  unsigned int distance;        // 1 + the distance to the home bucket of the
+                                // key, or 0 if the entry is empty
+  unsigned int hash;            // The hash of the key
+  union HashmapValue value;     // The value
+};
+
+// A hashmap associating strings with doubles or ints
+//
+// The hashmap is a flat array of entries using open addressing with Robin Hood
+// hashing: an inserted key takes the place of any key closer to its home
+// bucket, which keeps probe sequences short even at high load. Contrary to a
+// treemap, the keys are not ordered.
+struct Hashmap {
+  unsigned int num_entries;     // The number of entries
+  unsigned int capacity;        // The number of buckets, a power of 2 or 0
+  struct HashmapEntry* entries; // The buckets
+};
+
+// An iterator over the entries of a hashmap, in no particular order
+//
+// The iterator is invalidated by any modification of the hashmap.
+struct HashmapIterator {
+  const struct Hashmap* hm; // The hashmap
+  unsigned int bucket;      // The next bucket to visit
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes an empty hashmap
+ *
+ * @param hm  The hashmap to initialize
+ */
+void hashmap_initialize(struct Hashmap* hm);
+
+// Destruction
+// -----------
+
+/**
+ * Deletes a hashmap
+ *
+ * @param hm  The hashmap to delete
+ */
+void hashmap_delete(struct Hashmap* hm);
+
+// Modifiers
+// ---------
+
+/**
+ * Ensures that a hashmap can hold a given number of entries without growing
+ *
+ * @param hm           The hashmap
+ * @param num_entries  The number of entries to hold
+ */
+void hashmap_reserve(struct Hashmap* hm, unsigned int num_entries);
+
+/**
+ * Sets the double value for the given key in a hashmap
+ *
+ * Only the first ID_MAX_LENGTH characters of the key are considered.
+ *
+ * @param hm     The hashmap
+ * @param key    The key
+ * @param value  The value
+ */
+void hashmap_set(struct Hashmap* hm, const char* key, double value);
+
+/**
+ * Sets the int value for the given key in a hashmap
+ *
+ * Only the first ID_MAX_LENGTH characters of the key are considered.
+ *
+ * @param hm     The hashmap
+ * @param key    The key
+ * @param value  The value
+ */
+void hashmap_set_int(struct Hashmap* hm, const char* key, int value);
+
+/**
+ * Removes the given key from a hashmap
+ *
+ * @param hm   The hashmap
+ * @param key  The key to remove
+ * @return     true if and only if the key existed in the hashmap
+ */
+bool hashmap_remove(struct Hashmap* hm, const char* key);
+
+// Accessors
+// ---------
+
+/**
+ * Returns the value associated with the given key in a hashmap
+ *
+ * @param hm   The hashmap
+ * @param key  The key to search
+ * @return     The value associated with the key, or NULL if the key does not
+ *             exist
+ */
+const union HashmapValue* hashmap_find(const struct Hashmap* hm,
+                                       const char* key);
+
+/**
+ * Returns the double value associated with the given key in a hashmap
+ *
+ * Note: if the key does not exist, returns 0.0.
+ *
+ * @param hm   The hashmap
+ * @param key  The key to search
+ * @return     The value associated with the key
+ */
+double hashmap_get(const struct Hashmap* hm, const char* key);
+
+/**
+ * Returns the int value associated with the given key in a hashmap
+ *
+ * Note: if the key does not exist, returns 0.
+ *
+ * @param hm   The hashmap
+ * @param key  The key to search
+ * @return     The value associated with the key
+ */
+int hashmap_get_int(const struct Hashmap* hm, const char* key);
+
+/**
+ * Indicates if a key exists in a hashmap
+ *
+ * @param hm   The hashmap
+ * @param key  The key
+ * @return     true if and only if the key exists in the hashmap
+ */
+bool hashmap_has_key(const struct Hashmap* hm, const char* key);
+
+/**
+ * Initializes an iterator on the entries of a hashmap
+ *
+ * @param it  The iterator to initialize
+ * @param hm  The hashmap
+ */
+void hashmap_iterator_initialize(struct HashmapIterator* it,
+                                 const struct Hashmap* hm);
+
+/**
+ * Returns the next entry of a hashmap
+ *
+ * @param it  The iterator
+ * @return    The next entry, or NULL if all entries were visited
+ */
+const struct HashmapEntry* hashmap_iterator_next(struct HashmapIterator* it);
+
+#endif
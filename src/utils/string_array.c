@@ -3,30 +3,86 @@
 #include <stdlib.h>
 #include <string.h>
 
+// The initial number of strings of a non empty array
+#define STRING_ARRAY_INITIAL_CAPACITY 8
+
+// The initial number of characters of a non empty arena
+#define STRING_ARRAY_INITIAL_CHARS 64
+
 // Initialization
 // --------------
 
 void string_array_initialize(struct StringArray* sa) {
-  sa->strings = malloc(sizeof(char*));
   sa->size = 0;
-  sa->capacity = 1;
+  sa->capacity = 0;
+  sa->borrowed = false;
+  sa->offsets = NULL;
+  sa->views = NULL;
+  sa->chars = NULL;
+  sa->num_chars = 0;
+  sa->chars_capacity = 0;
+}
+
+void string_array_initialize_borrowed(struct StringArray* sa) {
+  string_array_initialize(sa);
+  sa->borrowed = true;
 }
 
 // Destruction
 // -----------
 
 void string_array_delete(struct StringArray* sa) {
-  free(sa->strings);
+  free(sa->offsets);
+  free(sa->views);
+  free(sa->chars);
 }
 
 // Modifiers
 // ---------
 
+void string_array_reserve(struct StringArray* sa,
+                          unsigned int num_strings,
+                          size_t num_chars) {
+  if (num_strings > sa->capacity) {
+    unsigned int capacity = sa->capacity == 0 ?
+                            STRING_ARRAY_INITIAL_CAPACITY :
+                            2 * sa->capacity;
+    if (capacity < num_strings)
+      capacity = num_strings;
+    if (sa->borrowed)
+      sa->views = realloc(sa->views, capacity * sizeof(const char*));
+    else
+      sa->offsets = realloc(sa->offsets, capacity * sizeof(size_t));
+    sa->capacity = capacity;
+  }
+  if (!sa->borrowed && num_chars > sa->chars_capacity) {
+    size_t chars_capacity = sa->chars_capacity == 0 ?
+                            STRING_ARRAY_INITIAL_CHARS :
+                            2 * sa->chars_capacity;
+    if (chars_capacity < num_chars)
+      chars_capacity = num_chars;
+    sa->chars = realloc(sa->chars, chars_capacity);
+    sa->chars_capacity = chars_capacity;
+  }
+}
+
 void string_array_append(struct StringArray* sa, const char* s) {
-  if (sa->capacity == sa->size) {
-    sa->capacity *= 2;
-    sa->strings = realloc(sa->strings, sa->capacity * sizeof(sizeof(char*)));
+  if (sa->borrowed) {
+    string_array_reserve(sa, sa->size + 1, 0);
+    sa->views[sa->size] = s;
+  } else {
+    size_t length = strlen(s) + 1;
+    string_array_reserve(sa, sa->size + 1, sa->num_chars + length);
+    memcpy(sa->chars + sa->num_chars, s, length);
+    sa->offsets[sa->size] = sa->num_chars;
+    sa->num_chars += length;
   }
-  sa->strings[sa->size] = strdup(s);
   ++sa->size;
 }
+
+// Accessors
+// ---------
+
+const char* string_array_get(const struct StringArray* sa, unsigned int i) {
+  return sa->borrowed ? sa->views[i] : sa->chars + sa->offsets[i];
+}
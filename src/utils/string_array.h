@@ -2,33 +2,54 @@
 #define STRING_ARRAY_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // Types
 // -----
 
 // An array of strings
+//
+// An array either owns its strings or borrows them. An owning array copies
+// the characters of its strings into a single growable arena, and locates
+// each string by its offset in the arena. A borrowing array only stores
+// pointers to strings that the caller keeps alive for the lifetime of the
+// array.
 struct StringArray {
-  char** strings;        // The strings contained in the array
-  unsigned int size;     // The size of the array
-  unsigned int capacity; // The capacity of the array
+  unsigned int size;      // The size of the array
+  unsigned int capacity;  // The capacity of the offset or view table
+  bool borrowed;          // true if the strings are borrowed
+  size_t* offsets;        // The offsets of owned strings in the arena
+  const char** views;     // The borrowed strings
+  char* chars;            // The arena holding the characters of owned strings
+  size_t num_chars;       // The number of used characters in the arena
+  size_t chars_capacity;  // The capacity of the arena
 };
 
 // Initialization
 // --------------
 
 /**
- * Initializes an array of strings
+ * Initializes an array of strings owning its strings
  *
  * @param sa  The string array to initialize
  */
 void string_array_initialize(struct StringArray* sa);
 
+/**
+ * Initializes an array of strings borrowing its strings
+ *
+ * @param sa  The string array to initialize
+ */
+void string_array_initialize_borrowed(struct StringArray* sa);
+
 // Destruction
 // -----------
 
 /**
  * Deletes a string array
  *
+ * Owned strings are released with the array, borrowed strings are not.
+ *
  * @param sa  The string array to delete
  */
 void string_array_delete(struct StringArray* sa);
@@ -37,11 +58,37 @@ void string_array_delete(struct StringArray* sa);
 // ---------
 
 /**
- * Set the value for the given key in a tree map
+ * Ensures that a string array can hold given numbers of strings and chars
+ *
+ * @param sa           The string array
+ * @param num_strings  The number of strings to hold
+ * @param num_chars    The total length of owned strings to hold, including
+ *                     their null terminators (ignored for borrowed strings)
+ */
+void string_array_reserve(struct StringArray* sa,
+                          unsigned int num_strings,
+                          size_t num_chars);
+
+/**
+ * Appends a string to a string array
  *
  * @param sa  The string array to which we append
  * @param s   The string to append
  */
 void string_array_append(struct StringArray* sa, const char* s);
 
+// Accessors
+// ---------
+
+/**
+ * Returns a string of a string array
+ *
+ * The string of an owning array remains valid until a string is appended.
+ *
+ * @param sa  The string array
+ * @param i   The index of the string
+ * @return    The string
+ */
+const char* string_array_get(const struct StringArray* sa, unsigned int i);
+
 #endif
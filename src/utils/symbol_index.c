@@ -0,0 +1,124 @@
+#include "symbol_index.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// The number of buckets of a non empty index, at least
+#define SYMBOL_INDEX_INITIAL_BUCKETS 16
+
+// Help functions
+// --------------
+
+/**
+ * Returns the bucket in which a symbol is or would be stored
+ *
+ * Symbols are dense indices of the symbol table, so a symbol is its own hash:
+ * symbols closer than the number of buckets fall in distinct buckets, without
+ * any scattering before probing.
+ *
+ * @param index   The symbol index, with at least one bucket
+ * @param symbol  The symbol
+ * @return        The index of the bucket
+ */
+unsigned int symbol_index_bucket(const struct SymbolIndex* index,
+                                 unsigned int symbol) {
+  unsigned int mask = index->num_buckets - 1;
+  unsigned int b = symbol & mask;
+  while (index->values[b] != 0 && index->symbols[b] != symbol)
+    b = (b + 1) & mask;
+  return b;
+}
+
+/**
+ * Moves the entries of a symbol index to a given number of buckets
+ *
+ * @param index        The symbol index
+ * @param num_buckets  The new number of buckets, a power of 2
+ */
+void symbol_index_rehash(struct SymbolIndex* index, unsigned int num_buckets) {
+  unsigned int old_num_buckets = index->num_buckets;
+  unsigned int* old_symbols = index->symbols;
+  unsigned int* old_values = index->values;
+  index->num_buckets = num_buckets;
+  if (index->arena == NULL) {
+    index->symbols = malloc(num_buckets * sizeof(unsigned int));
+    index->values = calloc(num_buckets, sizeof(unsigned int));
+  } else {
+    index->symbols = arena_allocate(index->arena,
+                                    num_buckets * sizeof(unsigned int),
+                                    sizeof(unsigned int));
+    index->values = arena_allocate(index->arena,
+                                   num_buckets * sizeof(unsigned int),
+                                   sizeof(unsigned int));
+    memset(index->values, 0, num_buckets * sizeof(unsigned int));
+  }
+  for (unsigned int b = 0; b < old_num_buckets; ++b) {
+    if (old_values[b] == 0)
+      continue;
+    unsigned int new_b = symbol_index_bucket(index, old_symbols[b]);
+    index->symbols[new_b] = old_symbols[b];
+    index->values[new_b] = old_values[b];
+  }
+  if (index->arena == NULL) {
+    free(old_symbols);
+    free(old_values);
+  }
+}
+
+// Initialization
+// --------------
+
+void symbol_index_initialize(struct SymbolIndex* index, struct Arena* arena) {
+  index->num_entries = 0;
+  index->num_buckets = 0;
+  index->symbols = NULL;
+  index->values = NULL;
+  index->arena = arena;
+}
+
+// Destruction
+// -----------
+
+void symbol_index_delete(struct SymbolIndex* index) {
+  if (index->arena != NULL)
+    return;
+  free(index->symbols);
+  free(index->values);
+}
+
+// Modifiers
+// ---------
+
+void symbol_index_reserve(struct SymbolIndex* index,
+                          unsigned int num_entries) {
+  if (2 * num_entries < index->num_buckets)
+    return;
+  unsigned int num_buckets = index->num_buckets == 0 ?
+                             SYMBOL_INDEX_INITIAL_BUCKETS :
+                             index->num_buckets;
+  while (2 * num_entries >= num_buckets)
+    num_buckets *= 2;
+  symbol_index_rehash(index, num_buckets);
+}
+
+unsigned int symbol_index_insert(struct SymbolIndex* index,
+                                 unsigned int symbol,
+                                 unsigned int value) {
+  symbol_index_reserve(index, index->num_entries + 1);
+  unsigned int b = symbol_index_bucket(index, symbol);
+  if (index->values[b] != 0)
+    return index->values[b] - 1;
+  index->symbols[b] = symbol;
+  index->values[b] = value + 1;
+  ++index->num_entries;
+  return value;
+}
+
+// Accessors
+// ---------
+
+int symbol_index_find(const struct SymbolIndex* index, unsigned int symbol) {
+  if (index->num_buckets == 0)
+    return -1;
+  return (int)index->values[symbol_index_bucket(index, symbol)] - 1;
+}
@@ -0,0 +1,83 @@
+#ifndef SYMBOL_INDEX_H
+#define SYMBOL_INDEX_H
+
+#include "arena.h"
+
+// Types
+// -----
+
+// A hash index mapping symbols of a symbol table to dense indices
+//
+// The index uses open addressing with linear probing and keeps its load factor
+// below 1/2, so that insertions and lookups take expected constant time. The
+// buckets are allocated on the heap, or from an arena owned by the caller.
+struct SymbolIndex {
+  unsigned int num_entries;   // The number of entries
+  unsigned int num_buckets;   // The number of buckets, a power of 2
+  unsigned int* symbols;      // The symbol of each bucket
+  unsigned int* values;       // The value of each bucket, + 1 (0 if empty)
+  struct Arena* arena;        // The arena of the buckets, NULL for the heap
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes an empty symbol index
+ *
+ * @param index  The symbol index to initialize
+ * @param arena  The arena from which the buckets are allocated, or NULL to
+ *               allocate them on the heap
+ */
+void symbol_index_initialize(struct SymbolIndex* index, struct Arena* arena);
+
+// Destruction
+// -----------
+
+/**
+ * Deletes a symbol index
+ *
+ * Buckets allocated from an arena are released with the arena.
+ *
+ * @param index  The symbol index to delete
+ */
+void symbol_index_delete(struct SymbolIndex* index);
+
+// Modifiers
+// ---------
+
+/**
+ * Ensures that a symbol index can hold a given number of entries
+ *
+ * @param index        The symbol index
+ * @param num_entries  The number of entries to hold without rehashing
+ */
+void symbol_index_reserve(struct SymbolIndex* index, unsigned int num_entries);
+
+/**
+ * Maps a symbol to a value in a symbol index
+ *
+ * If the symbol is already mapped, its value is left unchanged.
+ *
+ * @param index   The symbol index
+ * @param symbol  The symbol
+ * @param value   The value
+ * @return        The value the symbol is mapped to
+ */
+unsigned int symbol_index_insert(struct SymbolIndex* index,
+                                 unsigned int symbol,
+                                 unsigned int value);
+
+// Accessors
+// ---------
+
+/**
+ * Returns the value of a symbol in a symbol index
+ *
+ * @param index   The symbol index
+ * @param symbol  The symbol
+ * @return        The value of the symbol or -1
+ */
+int symbol_index_find(const struct SymbolIndex* index, unsigned int symbol);
+
+#endif
@@ -0,0 +1,75 @@
+#include "symbol_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// The number of names stored in a page
+#define SYMBOL_TABLE_PAGE_SIZE 256
+
+// Initialization
+// --------------
+
+void symbol_table_initialize(struct SymbolTable* st) {
+  st->num_symbols = 0;
+  st->num_pages = 0;
+  st->pages = NULL;
+  hashmap_initialize(&st->symbols);
+}
+
+// Destruction
+// -----------
+
+void symbol_table_delete(struct SymbolTable* st) {
+  for (unsigned int p = 0; p < st->num_pages; ++p)
+    free(st->pages[p]);
+  free(st->pages);
+  hashmap_delete(&st->symbols);
+}
+
+// Modifiers
+// ---------
+
+unsigned int symbol_table_intern(struct SymbolTable* st, const char* name) {
+  const union HashmapValue* symbol = hashmap_find(&st->symbols, name);
+  if (symbol != NULL)
+    return symbol->integer;
+  unsigned int s = st->num_symbols;
+  if (s % SYMBOL_TABLE_PAGE_SIZE == 0) {
+    ++st->num_pages;
+    st->pages = realloc(st->pages, st->num_pages * sizeof(*st->pages));
+    st->pages[st->num_pages - 1] =
+      malloc(SYMBOL_TABLE_PAGE_SIZE * sizeof(**st->pages));
+  }
+  char* dest =
+    st->pages[s / SYMBOL_TABLE_PAGE_SIZE][s % SYMBOL_TABLE_PAGE_SIZE];
+  strncpy(dest, name, ID_MAX_LENGTH);
+  dest[ID_MAX_LENGTH] = '\0';
+  hashmap_set_int(&st->symbols, dest, s);
+  ++st->num_symbols;
+  return s;
+}
+
+// Accessors
+// ---------
+
+int symbol_table_find(const struct SymbolTable* st, const char* name) {
+  const union HashmapValue* symbol = hashmap_find(&st->symbols, name);
+  return symbol == NULL ? -1 : symbol->integer;
+}
+
+const char* symbol_table_name(const struct SymbolTable* st, unsigned int s) {
+  return st->pages[s / SYMBOL_TABLE_PAGE_SIZE][s % SYMBOL_TABLE_PAGE_SIZE];
+}
+
+// Shared table
+// ------------
+
+struct SymbolTable* symbol_table_shared(void) {
+  static struct SymbolTable shared;
+  static bool initialized = false;
+  if (!initialized) {
+    symbol_table_initialize(&shared);
+    initialized = true;
+  }
+  return &shared;
+}
@@ -0,0 +1,93 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <stdbool.h>
+
+#include "constants.h"
+#include "hashmap.h"
+
+// Types
+// -----
+
+// A table interning identifiers of at most ID_MAX_LENGTH characters
+//
+// Each distinct identifier is given a dense integer handle, starting at 0, so
+// that identifiers can be compared and used as array indices without strcmp.
+// Names are stored in pages that never move, so that the name of a symbol
+// remains valid for the lifetime of the table.
+struct SymbolTable {
+  unsigned int num_symbols;               // The number of interned symbols
+  unsigned int num_pages;                 // The number of pages of names
+  char (**pages)[ID_MAX_LENGTH + 1];      // The pages of names
+  struct Hashmap symbols;                 // The symbol of each name
+};
+
+// Initialization
+// --------------
+
+/**
+ * Initializes an empty symbol table
+ *
+ * @param st  The symbol table to initialize
+ */
+void symbol_table_initialize(struct SymbolTable* st);
+
+// Destruction
+// -----------
+
+/**
+ * Deletes a symbol table
+ *
+ * @param st  The symbol table to delete
+ */
+void symbol_table_delete(struct SymbolTable* st);
+
+// Modifiers
+// ---------
+
+/**
+ * Interns an identifier in a symbol table
+ *
+ * Only the first ID_MAX_LENGTH characters of the identifier are considered.
+ *
+ * @param st    The symbol table
+ * @param name  The identifier to intern
+ * @return      The symbol of the identifier
+ */
+unsigned int symbol_table_intern(struct SymbolTable* st, const char* name);
+
+// Accessors
+// ---------
+
+/**
+ * Returns the symbol of an identifier, if it was interned
+ *
+ * @param st    The symbol table
+ * @param name  The identifier
+ * @return      The symbol of the identifier or -1
+ */
+int symbol_table_find(const struct SymbolTable* st, const char* name);
+
+/**
+ * Returns the identifier of a symbol
+ *
+ * @param st  The symbol table
+ * @param s   The symbol
+ * @return    The identifier
+ */
+const char* symbol_table_name(const struct SymbolTable* st, unsigned int s);
+
+// Shared table
+// ------------
+
+/**
+ * Returns the symbol table shared by scenarios, plans and simulations
+ *
+ * Interning all identifiers in the same table makes their symbols comparable
+ * across any two components, scenarios or plans.
+ *
+ * @return  The shared symbol table
+ */
+struct SymbolTable* symbol_table_shared(void);
+
+#endif
@@ -0,0 +1,68 @@
+#include "arena.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <tap.h>
+
+/**
+ * Tests allocating memory from an arena
+ */
+void test_arena_allocate(void) {
+  diag("Testing arena_allocate");
+  struct Arena arena;
+  arena_initialize(&arena, 1024);
+  ok(arena.blocks == NULL, "an empty arena has no block");
+
+  char* a = arena_allocate(&arena, 10, 1);
+  double* b = arena_allocate(&arena, 4 * sizeof(double), sizeof(double));
+  char* c = arena_allocate(&arena, 100, 64);
+  ok(arena.blocks != NULL && arena.blocks->next == NULL,
+     "small allocations share a single block");
+  ok((uintptr_t)b % sizeof(double) == 0 && (uintptr_t)c % 64 == 0,
+     "allocations are aligned as requested");
+  ok((char*)b >= a + 10 && c >= (char*)(b + 4),
+     "allocations do not overlap");
+  memset(a, 1, 10);
+  memset(c, 2, 100);
+
+  struct ArenaBlock* block = arena.blocks;
+  char* large = arena_allocate(&arena, 4096, 64);
+  memset(large, 3, 4096);
+  ok(arena.blocks == block && block->next != NULL,
+     "a large allocation gets its own block behind the current one");
+  char* d = arena_allocate(&arena, 10, 1);
+  ok(d > c && d < block->data + block->capacity,
+     "the current block is still used after a large allocation");
+
+  arena_delete(&arena);
+}
+
+/**
+ * Tests resizing memory allocated from an arena
+ */
+void test_arena_reallocate(void) {
+  diag("Testing arena_reallocate");
+  struct Arena arena;
+  arena_initialize(&arena, 1024);
+
+  int* a = arena_reallocate(&arena, NULL, 0, 4 * sizeof(int), sizeof(int));
+  for (int i = 0; i < 4; ++i)
+    a[i] = i;
+  int* b = arena_reallocate(&arena, a, 4 * sizeof(int), 8 * sizeof(int),
+                            sizeof(int));
+  ok(a == b, "the last allocation grows in place");
+  arena_allocate(&arena, 1, 1);
+  int* c = arena_reallocate(&arena, b, 8 * sizeof(int), 16 * sizeof(int),
+                            sizeof(int));
+  ok(c != b, "an allocation followed by another one moves");
+  ok(c[0] == 0 && c[3] == 3, "the content of a moved allocation is kept");
+
+  arena_delete(&arena);
+}
+
+int main(void) {
+  test_arena_allocate();
+  test_arena_reallocate();
+  done_testing();
+}
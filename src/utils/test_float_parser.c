@@ -0,0 +1,70 @@
+#include "float_parser.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tap.h>
+
+// Help functions
+// --------------
+
+/**
+ * Parses a whole text with float_parse
+ *
+ * @param text   The text
+ * @param value  The parsed number
+ * @return       true if and only if the whole text is a number
+ */
+bool parse_text(const char* text, double* value) {
+  const char* end = text + strlen(text);
+  return float_parse(text, end, value) == end;
+}
+
+// Tests
+// -----
+
+/**
+ * Tests the float_parse function on valid numbers
+ */
+void test_float_parse(void) {
+  diag("Testing float_parse");
+  const char* texts[] = {"0", "-0", "1.5", "+2", "-.25", "007.50", "1e5",
+                         "1E-3", "0.1", "123456789012345678901234",
+                         "12345678901234567890.5", "9007199254740993",
+                         "1.7976931348623157e308", "4.9e-324",
+                         "2.2250738585072014e-308", "1e400"};
+  for (unsigned int i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i) {
+    double value = -1.0;
+    double expected = strtod(texts[i], NULL);
+    ok(parse_text(texts[i], &value) &&
+       memcmp(&value, &expected, sizeof(double)) == 0,
+       "%s is parsed as strtod does", texts[i]);
+  }
+}
+
+/**
+ * Tests the float_parse function on the end of numbers
+ */
+void test_float_parse_end(void) {
+  diag("Testing float_parse on the end of numbers");
+  const char* text = "2.5,3";
+  double value;
+  const char* end = float_parse(text, text + strlen(text), &value);
+  ok(end == text + 3, "number ends before the comma");
+  cmp_ok(value, "==", 2.5, "number before the comma is 2.5");
+  end = float_parse(text, text + 2, &value);
+  ok(end == text + 2, "number ends at the end of the text");
+  cmp_ok(value, "==", 2.0, "number of 2 characters is 2.0");
+  const char* invalid[] = {"", "-", ".", "e5", "1e", "1e+", "abc"};
+  for (unsigned int i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+    ok(float_parse(invalid[i], invalid[i] + strlen(invalid[i]), &value) ==
+       NULL,
+       "\"%s\" is not a number", invalid[i]);
+}
+
+int main(void) {
+  test_float_parse();
+  test_float_parse_end();
+  done_testing();
+}
@@ -0,0 +1,76 @@
+#include "grisu.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tap.h>
+
+// Help functions
+// --------------
+
+/**
+ * Returns the text of the shortest digits of a double
+ *
+ * @param value  The double
+ * @param text   The buffer receiving the text, as "<digits>e<exponent>"
+ */
+void shortest_text(double value, char* text) {
+  char digits[GRISU_MAX_DIGITS];
+  int exponent;
+  int num_digits = grisu_digits(value, digits, &exponent);
+  sprintf(text, "%.*se%d", num_digits, digits, exponent);
+}
+
+// Tests
+// -----
+
+/**
+ * Tests the grisu_digits function on known doubles
+ */
+void test_grisu_digits(void) {
+  diag("Testing grisu_digits");
+  double values[] = {1.0, 0.1, 1.0 / 3.0, 123.456, 1e21, 5e-324,
+                     2.2250738585072014e-308, 1.7976931348623157e308,
+                     9007199254740993.0};
+  const char* texts[] = {"1e0", "1e-1", "3333333333333333e-16", "123456e-3",
+                         "1e21", "5e-324", "22250738585072014e-324",
+                         "17976931348623157e292", "9007199254740992e0"};
+  for (unsigned int i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+    char text[32];
+    shortest_text(values[i], text);
+    is(text, texts[i], "digits of %.17g are %s", values[i], texts[i]);
+  }
+}
+
+/**
+ * Tests that the digits of grisu_digits read back to the same doubles
+ */
+void test_grisu_round_trip(void) {
+  diag("Testing grisu_digits round trips");
+  unsigned int num_failures = 0;
+  uint64_t state = 88172645463325252u;
+  for (int i = 0; i < 100000; ++i) {
+    // xorshift64 over all the bit patterns of positive finite doubles
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    uint64_t bits = state & ~(UINT64_C(1) << 63);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (value == 0.0 || value - value != 0.0)
+      continue;
+    char text[32];
+    shortest_text(value, text);
+    if (strtod(text, NULL) != value)
+      ++num_failures;
+  }
+  cmp_ok(num_failures, "==", 0, "random doubles are read back from digits");
+}
+
+int main(void) {
+  test_grisu_digits();
+  test_grisu_round_trip();
+  done_testing();
+}
@@ -0,0 +1,86 @@
+#include "hashmap.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <tap.h>
+
+/**
+ * Tests setting and getting a few keys
+ */
+void test_hashmap_set(void) {
+  diag("Testing hashmap_set");
+  struct Hashmap hm;
+  hashmap_initialize(&hm);
+  ok(!hashmap_has_key(&hm, "alpha"), "an empty hashmap has no key");
+  hashmap_set(&hm, "alpha", 1.0);
+  hashmap_set(&hm, "gamma", 3.0);
+  hashmap_set_int(&hm, "beta", 2);
+  cmp_ok(hashmap_get(&hm, "alpha"), "==", 1.0, "hashmap_get(alpha) == 1.0");
+  cmp_ok(hashmap_get_int(&hm, "beta"), "==", 2, "hashmap_get_int(beta) == 2");
+  cmp_ok(hashmap_get(&hm, "gamma"), "==", 3.0, "hashmap_get(gamma) == 3.0");
+  ok(hashmap_find(&hm, "delta") == NULL, "hashmap_find(delta) is NULL");
+  hashmap_set(&hm, "alpha", 4.0);
+  cmp_ok(hashmap_get(&hm, "alpha"), "==", 4.0, "hashmap_get(alpha) == 4.0");
+  cmp_ok(hm.num_entries, "==", 3, "hashmap contains 3 entries");
+  hashmap_set(&hm, "a_key_much_longer_than_the_limit", 5.0);
+  ok(hashmap_has_key(&hm, "a_key_much_longer_th"),
+     "key is truncated to its first ID_MAX_LENGTH characters");
+  hashmap_delete(&hm);
+}
+
+/**
+ * Tests inserting and removing many keys
+ */
+void test_hashmap_many_keys(void) {
+  diag("Testing hashmap_set and hashmap_remove with many keys");
+  struct Hashmap hm;
+  hashmap_initialize(&hm);
+  char key[ID_MAX_LENGTH + 1];
+  for (int i = 0; i < 10000; ++i) {
+    snprintf(key, sizeof(key), "P%d", i);
+    hashmap_set_int(&hm, key, i);
+  }
+  cmp_ok(hm.num_entries, "==", 10000, "hashmap contains 10000 entries");
+  ok(4 * hm.num_entries <= 3 * hm.capacity, "load factor is at most 3/4");
+  bool all_found = true;
+  for (int i = 0; i < 10000; ++i) {
+    snprintf(key, sizeof(key), "P%d", i);
+    all_found = all_found && hashmap_get_int(&hm, key) == i;
+  }
+  ok(all_found, "each key is associated with its value");
+
+  bool all_removed = true;
+  for (int i = 0; i < 10000; i += 2) {
+    snprintf(key, sizeof(key), "P%d", i);
+    all_removed = all_removed && hashmap_remove(&hm, key);
+  }
+  ok(all_removed, "each removed key existed");
+  cmp_ok(hm.num_entries, "==", 5000, "hashmap contains 5000 entries");
+  bool all_kept = true;
+  for (int i = 0; i < 10000; ++i) {
+    snprintf(key, sizeof(key), "P%d", i);
+    all_kept = all_kept && hashmap_has_key(&hm, key) == (i % 2 == 1);
+  }
+  ok(all_kept, "only removed keys are missing");
+  ok(!hashmap_remove(&hm, "P0"), "removing P0 again fails");
+
+  struct HashmapIterator it;
+  hashmap_iterator_initialize(&it, &hm);
+  const struct HashmapEntry* entry;
+  unsigned int num_visited = 0;
+  long sum = 0;
+  while ((entry = hashmap_iterator_next(&it)) != NULL) {
+    ++num_visited;
+    sum += entry->value.integer;
+  }
+  cmp_ok(num_visited, "==", 5000, "iterator visits 5000 entries");
+  ok(sum == 25000000, "iterator visits each entry once");
+  hashmap_delete(&hm);
+}
+
+int main(void) {
+  test_hashmap_set();
+  test_hashmap_many_keys();
+  done_testing();
+}
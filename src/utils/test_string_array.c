@@ -0,0 +1,52 @@
+#include "string_array.h"
+
+#include <stdio.h>
+
+#include <tap.h>
+
+/**
+ * Tests appending strings to an array owning its strings
+ */
+void test_string_array_owned(void) {
+  diag("Appending strings to an owning string array");
+  struct StringArray sa;
+  string_array_initialize(&sa);
+  char s[24];
+  for (int i = 0; i < 100; ++i) {
+    snprintf(s, sizeof(s), "string%d", i);
+    string_array_append(&sa, s);
+  }
+  snprintf(s, sizeof(s), "overwritten");
+
+  cmp_ok(sa.size, "==", 100, "array contains 100 strings");
+  is(string_array_get(&sa, 0), "string0", "first string is \"string0\"");
+  is(string_array_get(&sa, 99), "string99", "last string is \"string99\"");
+  ok(string_array_get(&sa, 1) == string_array_get(&sa, 0) + 8,
+     "strings are contiguous in the arena");
+  string_array_delete(&sa);
+}
+
+/**
+ * Tests appending strings to an array borrowing its strings
+ */
+void test_string_array_borrowed(void) {
+  diag("Appending strings to a borrowing string array");
+  const char* strings[] = {"alpha", "beta", "gamma"};
+  struct StringArray sa;
+  string_array_initialize_borrowed(&sa);
+  string_array_reserve(&sa, 3, 0);
+  for (int i = 0; i < 3; ++i)
+    string_array_append(&sa, strings[i]);
+
+  cmp_ok(sa.size, "==", 3, "array contains 3 strings");
+  ok(string_array_get(&sa, 1) == strings[1],
+     "second string is borrowed from the caller");
+  ok(sa.chars == NULL, "no arena is allocated");
+  string_array_delete(&sa);
+}
+
+int main(void) {
+  test_string_array_owned();
+  test_string_array_borrowed();
+  done_testing();
+}
@@ -0,0 +1,59 @@
+#include "symbol_index.h"
+
+#include <stdbool.h>
+
+#include <tap.h>
+
+/**
+ * Tests inserting and finding a few symbols
+ */
+void test_symbol_index_insert(void) {
+  diag("Testing symbol_index_insert");
+  struct SymbolIndex index;
+  symbol_index_initialize(&index, NULL);
+
+  cmp_ok(symbol_index_find(&index, 3), "==", -1,
+         "symbol_index_find(3) is -1 in an empty index");
+  cmp_ok(symbol_index_insert(&index, 3, 0), "==", 0,
+         "symbol 3 is mapped to 0");
+  cmp_ok(symbol_index_insert(&index, 7, 1), "==", 1,
+         "symbol 7 is mapped to 1");
+  cmp_ok(symbol_index_insert(&index, 3, 2), "==", 0,
+         "mapping symbol 3 again keeps its value");
+  cmp_ok(index.num_entries, "==", 2, "index contains 2 entries");
+  cmp_ok(symbol_index_find(&index, 7), "==", 1,
+         "symbol_index_find(7) is 1");
+  cmp_ok(symbol_index_find(&index, 5), "==", -1,
+         "symbol_index_find(5) is -1");
+
+  symbol_index_delete(&index);
+}
+
+/**
+ * Tests inserting enough symbols to rehash the index
+ */
+void test_symbol_index_growth(void) {
+  diag("Testing symbol_index_insert with many symbols");
+  struct SymbolIndex index;
+  symbol_index_initialize(&index, NULL);
+  for (unsigned int s = 0; s < 10000; ++s)
+    symbol_index_insert(&index, 3 * s, s);
+
+  cmp_ok(index.num_entries, "==", 10000, "index contains 10000 entries");
+  ok(2 * index.num_entries < index.num_buckets,
+     "load factor is below 1/2");
+  bool all_found = true;
+  for (unsigned int s = 0; s < 10000; ++s)
+    all_found = all_found && symbol_index_find(&index, 3 * s) == s;
+  ok(all_found, "each symbol is mapped to its value");
+  cmp_ok(symbol_index_find(&index, 3 * 10000 + 1), "==", -1,
+         "symbol_index_find of a missing symbol is -1");
+
+  symbol_index_delete(&index);
+}
+
+int main(void) {
+  test_symbol_index_insert();
+  test_symbol_index_growth();
+  done_testing();
+}
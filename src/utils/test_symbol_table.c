@@ -0,0 +1,63 @@
+#include "symbol_table.h"
+
+#include <stdio.h>
+
+#include <tap.h>
+
+/**
+ * Tests interning and finding a few identifiers
+ */
+void test_symbol_table_intern(void) {
+  diag("Testing symbol_table_intern");
+  struct SymbolTable st;
+  symbol_table_initialize(&st);
+  unsigned int alpha = symbol_table_intern(&st, "alpha");
+  unsigned int beta = symbol_table_intern(&st, "beta");
+
+  cmp_ok(alpha, "==", 0, "first symbol is 0");
+  cmp_ok(beta, "==", 1, "second symbol is 1");
+  cmp_ok(symbol_table_intern(&st, "alpha"), "==", alpha,
+         "interning \"alpha\" again returns the same symbol");
+  cmp_ok(st.num_symbols, "==", 2, "table contains 2 symbols");
+  cmp_ok(symbol_table_find(&st, "beta"), "==", beta,
+         "symbol_table_find(beta) is the symbol of \"beta\"");
+  cmp_ok(symbol_table_find(&st, "gamma"), "==", -1,
+         "symbol_table_find(gamma) is -1");
+  is(symbol_table_name(&st, alpha), "alpha",
+     "name of the first symbol is \"alpha\"");
+
+  symbol_table_delete(&st);
+}
+
+/**
+ * Tests interning enough identifiers to grow the table
+ */
+void test_symbol_table_growth(void) {
+  diag("Testing symbol_table_intern with many identifiers");
+  struct SymbolTable st;
+  symbol_table_initialize(&st);
+  const char* first_name = NULL;
+  char name[ID_MAX_LENGTH + 1];
+  for (int i = 0; i < 1000; ++i) {
+    snprintf(name, sizeof(name), "P%d", i);
+    symbol_table_intern(&st, name);
+    if (i == 0)
+      first_name = symbol_table_name(&st, 0);
+  }
+
+  cmp_ok(st.num_symbols, "==", 1000, "table contains 1000 symbols");
+  cmp_ok(symbol_table_find(&st, "P742"), "==", 742,
+         "symbol of \"P742\" is 742");
+  is(symbol_table_name(&st, 999), "P999",
+     "name of symbol 999 is \"P999\"");
+  ok(first_name == symbol_table_name(&st, 0),
+     "name of the first symbol did not move");
+
+  symbol_table_delete(&st);
+}
+
+int main(void) {
+  test_symbol_table_intern();
+  test_symbol_table_growth();
+  done_testing();
+}
@@ -1,10 +1,61 @@
 #include "treemap.h"
 
+#include <stdio.h>
+#include <string.h>
+
 #include <tap.h>
 
-// Main
-// ----
-int main() {
+// Help functions
+// --------------
+
+/**
+ * Returns the black height of a subtree, or -1 if it is not a red-black tree
+ *
+ * @param node  The root of the subtree
+ * @return      The black height of the subtree or -1
+ */
+int black_height(const struct TreeNode* node) {
+  if (node == NULL)
+    return 1;
+  if (node->left != NULL &&
+      (node->left->parent != node || strcmp(node->left->kv.key,
+                                            node->kv.key) >= 0))
+    return -1;
+  if (node->right != NULL &&
+      (node->right->parent != node || strcmp(node->right->kv.key,
+                                             node->kv.key) <= 0))
+    return -1;
+  if (node->red && ((node->left != NULL && node->left->red) ||
+                    (node->right != NULL && node->right->red)))
+    return -1;
+  int left_height = black_height(node->left);
+  int right_height = black_height(node->right);
+  if (left_height < 0 || left_height != right_height)
+    return -1;
+  return left_height + (node->red ? 0 : 1);
+}
+
+/**
+ * Returns the height of a subtree
+ *
+ * @param node  The root of the subtree
+ * @return      The height of the subtree
+ */
+int height(const struct TreeNode* node) {
+  if (node == NULL)
+    return 0;
+  int left_height = height(node->left);
+  int right_height = height(node->right);
+  return 1 + (left_height > right_height ? left_height : right_height);
+}
+
+// Tests
+// -----
+
+/**
+ * Tests setting and getting a few keys
+ */
+void test_treemap_set(void) {
   struct Treemap t;
   treemap_initialize(&t);
   diag("Initializing a treemap with three pairs of key-value:");
@@ -23,12 +74,211 @@ int main() {
   ok(treemap_are_equal(&t, &t), "a treemap is equal to itself");
   struct StringArray sa;
   treemap_compute_keys(&t, &sa);
-  diag("Retrieving the treemap's keys"); 
+  diag("Retrieving the treemap's keys");
   printf("# ");
   for (int i = 0; i < sa.size; ++i)
-    printf("%s ", sa.strings[i]);
+    printf("%s ", string_array_get(&sa, i));
   printf("\n");
   string_array_delete(&sa);
   treemap_delete(&t);
+}
+
+/**
+ * Tests inserting keys in sorted order, the worst case of a plain BST
+ */
+void test_treemap_sorted_input(void) {
+  diag("Inserting 10000 keys in sorted order");
+  struct Treemap t;
+  treemap_initialize(&t);
+  char key[16];
+  for (int i = 0; i < 10000; ++i) {
+    snprintf(key, sizeof(key), "P%05d", i);
+    treemap_set(&t, key, i);
+  }
+  cmp_ok(t.num_entries, "==", 10000, "treemap contains 10000 entries");
+  ok(black_height(t.root) > 0, "treemap is a valid red-black tree");
+  cmp_ok(height(t.root), "<=", 28, "height of treemap is at most 28");
+  bool all_found = true;
+  for (int i = 0; i < 10000; ++i) {
+    snprintf(key, sizeof(key), "P%05d", i);
+    all_found = all_found && treemap_get(&t, key) == i;
+  }
+  ok(all_found, "each key is associated with its value");
+
+  diag("Removing every other key");
+  bool all_removed = true;
+  for (int i = 0; i < 10000; i += 2) {
+    snprintf(key, sizeof(key), "P%05d", i);
+    all_removed = all_removed && treemap_remove(&t, key);
+  }
+  ok(all_removed, "each removed key existed");
+  cmp_ok(t.num_entries, "==", 5000, "treemap contains 5000 entries");
+  ok(black_height(t.root) > 0, "treemap is still a valid red-black tree");
+  ok(!treemap_has_key(&t, "P00042") && treemap_has_key(&t, "P00043"),
+     "P00042 was removed and P00043 was kept");
+  ok(!treemap_remove(&t, "P00042"), "removing P00042 again fails");
+  treemap_delete(&t);
+}
+
+/**
+ * Tests that removed nodes are reused and that keys are stored inline
+ */
+void test_treemap_pool(void) {
+  diag("Removing and inserting keys in a treemap");
+  struct Treemap t;
+  treemap_initialize(&t);
+  char key[16];
+  for (int i = 0; i < 100; ++i) {
+    snprintf(key, sizeof(key), "Z%03d", i);
+    treemap_set(&t, key, i);
+  }
+  const struct TreeSlab* slabs = t.slabs;
+  unsigned int num_slab_nodes = t.num_slab_nodes;
+  for (int i = 0; i < 100; i += 3) {
+    snprintf(key, sizeof(key), "Z%03d", i);
+    treemap_remove(&t, key);
+  }
+  for (int i = 0; i < 100; i += 3) {
+    snprintf(key, sizeof(key), "Y%03d", i);
+    treemap_set(&t, key, -i);
+  }
+  ok(t.slabs == slabs && t.num_slab_nodes == num_slab_nodes,
+     "removed nodes are reused by later insertions");
+  cmp_ok(t.num_entries, "==", 100, "treemap contains 100 entries");
+  cmp_ok(treemap_get(&t, "Y099"), "==", -99, "treemap_get(Y099) == -99");
+  ok(black_height(t.root) > 0, "treemap is a valid red-black tree");
+
+  diag("Setting a key longer than ID_MAX_LENGTH");
+  treemap_set(&t, "a_key_much_longer_than_the_limit", 1.0);
+  ok(treemap_has_key(&t, "a_key_much_longer_th"),
+     "key is truncated to its first ID_MAX_LENGTH characters");
+  treemap_delete(&t);
+}
+
+/**
+ * Tests enumerating a treemap with an iterator
+ */
+void test_treemap_iterator(void) {
+  diag("Iterating over a treemap");
+  struct Treemap t;
+  treemap_initialize(&t);
+  struct TreemapIterator it;
+  treemap_iterator_initialize(&it, &t);
+  ok(treemap_iterator_next(&it) == NULL, "an empty treemap has no entry");
+  treemap_set(&t, "gamma", 3.0);
+  treemap_set(&t, "alpha", 1.0);
+  treemap_set(&t, "delta", 4.0);
+  treemap_set(&t, "beta", 2.0);
+  const char* expected_keys[] = {"alpha", "beta", "delta", "gamma"};
+  const double expected_values[] = {1.0, 2.0, 4.0, 3.0};
+  treemap_iterator_initialize(&it, &t);
+  const struct KeyValue* kv;
+  int i = 0;
+  bool in_order = true;
+  while ((kv = treemap_iterator_next(&it)) != NULL) {
+    in_order = in_order && i < 4 &&
+               strcmp(kv->key, expected_keys[i]) == 0 &&
+               kv->value == expected_values[i];
+    ++i;
+  }
+  ok(in_order && i == 4, "entries are yielded in increasing key order");
+  treemap_delete(&t);
+}
+
+/**
+ * Tests building treemaps from sorted key-value pairs
+ */
+void test_treemap_build_from_sorted(void) {
+  diag("Building treemaps from sorted key-value pairs");
+  struct KeyValue kvs[1000];
+  for (int i = 0; i < 1000; ++i) {
+    snprintf(kvs[i].key, sizeof(kvs[i].key), "K%04d", i);
+    kvs[i].value = i;
+  }
+  bool all_valid = true;
+  for (unsigned int n = 0; n <= 1000; n += n < 20 ? 1 : 97) {
+    struct Treemap t;
+    treemap_build_from_sorted(&t, kvs, n);
+    int expected_height = 0;
+    while ((1u << expected_height) <= n)
+      ++expected_height;
+    all_valid = all_valid && t.num_entries == n &&
+                black_height(t.root) > 0 &&
+                height(t.root) == expected_height &&
+                (n == 0 || treemap_get(&t, kvs[n - 1].key) == n - 1);
+    treemap_delete(&t);
+  }
+  ok(all_valid, "built treemaps are valid and perfectly balanced");
+
+  struct Treemap t;
+  treemap_build_from_sorted(&t, kvs, 1000);
+  treemap_set(&t, "K0500", -1.0);
+  treemap_set(&t, "L", 1.0);
+  treemap_remove(&t, "K0000");
+  ok(black_height(t.root) > 0 && t.num_entries == 1000,
+     "a built treemap can be modified");
+  cmp_ok(treemap_get(&t, "K0500"), "==", -1.0, "treemap_get(K0500) == -1.0");
+  treemap_delete(&t);
+}
+
+/**
+ * Records the keys visited by treemap_diff
+ *
+ * @param kv1   The entry of the first treemap
+ * @param kv2   The entry of the second treemap
+ * @param data  The string in which the keys are appended
+ * @return      true
+ */
+bool record_difference(const struct KeyValue* kv1,
+                       const struct KeyValue* kv2,
+                       void* data) {
+  char* differences = data;
+  strcat(differences, kv1 == NULL ? "+" : kv2 == NULL ? "-" : "~");
+  strcat(differences, kv1 == NULL ? kv2->key : kv1->key);
+  strcat(differences, " ");
+  return true;
+}
+
+/**
+ * Tests comparing treemaps
+ */
+void test_treemap_diff(void) {
+  diag("Comparing treemaps");
+  struct Treemap t1, t2;
+  treemap_initialize(&t1);
+  treemap_initialize(&t2);
+  treemap_set(&t1, "alpha", 1.0);
+  treemap_set(&t1, "beta", 2.0);
+  treemap_set(&t1, "delta", 4.0);
+  treemap_set(&t2, "delta", 4.0);
+  treemap_set(&t2, "beta", 2.0);
+  treemap_set(&t2, "alpha", 1.0);
+  ok(treemap_are_equal(&t1, &t2),
+     "treemaps built in different orders are equal");
+  treemap_set(&t2, "beta", 3.0);
+  ok(!treemap_are_equal(&t1, &t2),
+     "treemaps with different values are not equal");
+  treemap_remove(&t2, "alpha");
+  treemap_set(&t2, "gamma", 3.0);
+  ok(!treemap_are_equal(&t1, &t2),
+     "treemaps with different keys are not equal");
+  char differences[64] = "";
+  cmp_ok(treemap_diff(&t1, &t2, record_difference, differences), "==", 3,
+         "treemaps differ on 3 keys");
+  is(differences, "-alpha ~beta +gamma ",
+     "alpha is removed, beta is changed and gamma is added");
+  treemap_delete(&t1);
+  treemap_delete(&t2);
+}
+
+// Main
+// ----
+int main() {
+  test_treemap_set();
+  test_treemap_sorted_input();
+  test_treemap_pool();
+  test_treemap_iterator();
+  test_treemap_build_from_sorted();
+  test_treemap_diff();
   done_testing();
 }
@@ -4,6 +4,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+// The number of nodes of the first slab of a treemap
+#define TREEMAP_INITIAL_SLAB_CAPACITY 16
+
 // Help functions
 // --------------
 
@@ -12,94 +15,376 @@
  *
  * Note: if the key does not exist in the tree map, return NULL.
  *
- * @param node  The current node
+ * @param node  The root of the tree
  * @param key   The key to search
  * @return      The node associated with the key
  */
 struct TreeNode* treemap_get_node(struct TreeNode* node,
                                   const char* key) {
-  if (node == NULL) {
-    return NULL;
-  } else {
-    int cmp = strcmp(key, node->kv.key);
+  while (node != NULL) {
+    int cmp = strncmp(key, node->kv.key, ID_MAX_LENGTH);
     if (cmp == 0)
-      return (struct TreeNode*)node;
-    else if (cmp < 0)
-      return treemap_get_node(node->left, key);
-    else
-      return treemap_get_node(node->right, key);
+      return node;
+    node = cmp < 0 ? node->left : node->right;
+  }
+  return NULL;
+}
+
+/**
+ * Return the node with the smallest key in a subtree
+ *
+ * @param node  The root of the subtree, not NULL
+ * @return      The leftmost node of the subtree
+ */
+struct TreeNode* treemap_minimum_node(struct TreeNode* node) {
+  while (node->left != NULL)
+    node = node->left;
+  return node;
+}
+
+/**
+ * Return the node following a given node in key order
+ *
+ * @param node  The node
+ * @return      The next node, or NULL if the node has the largest key
+ */
+struct TreeNode* treemap_next_node(struct TreeNode* node) {
+  if (node->right != NULL)
+    return treemap_minimum_node(node->right);
+  while (node->parent != NULL && node == node->parent->right)
+    node = node->parent;
+  return node->parent;
+}
+
+/**
+ * Indicate if a node is red
+ *
+ * @param node  The node, possibly NULL
+ * @return      True if and only if the node exists and is red
+ */
+bool treemap_is_red(const struct TreeNode* node) {
+  return node != NULL && node->red;
+}
+
+/**
+ * Replace a node by another one in the tree
+ *
+ * @param t     The tree map
+ * @param node  The node to replace
+ * @param by    The replacing node, possibly NULL
+ */
+void treemap_replace_node(struct Treemap* t,
+                          struct TreeNode* node,
+                          struct TreeNode* by) {
+  if (node->parent == NULL)
+    t->root = by;
+  else if (node == node->parent->left)
+    node->parent->left = by;
+  else
+    node->parent->right = by;
+  if (by != NULL)
+    by->parent = node->parent;
+}
+
+/**
+ * Rotate a subtree to the left
+ *
+ * @param t     The tree map
+ * @param node  The root of the subtree, whose right child becomes the root
+ */
+void treemap_rotate_left(struct Treemap* t, struct TreeNode* node) {
+  struct TreeNode* right = node->right;
+  node->right = right->left;
+  if (right->left != NULL)
+    right->left->parent = node;
+  treemap_replace_node(t, node, right);
+  right->left = node;
+  node->parent = right;
+}
+
+/**
+ * Rotate a subtree to the right
+ *
+ * @param t     The tree map
+ * @param node  The root of the subtree, whose left child becomes the root
+ */
+void treemap_rotate_right(struct Treemap* t, struct TreeNode* node) {
+  struct TreeNode* left = node->left;
+  node->left = left->right;
+  if (left->right != NULL)
+    left->right->parent = node;
+  treemap_replace_node(t, node, left);
+  left->right = node;
+  node->parent = left;
+}
+
+/**
+ * Restore the red-black properties after inserting a red node
+ *
+ * @param t     The tree map
+ * @param node  The inserted node
+ */
+void treemap_fix_insert(struct Treemap* t, struct TreeNode* node) {
+  while (treemap_is_red(node->parent)) {
+    struct TreeNode* parent = node->parent;
+    struct TreeNode* grandparent = parent->parent;
+    if (parent == grandparent->left) {
+      struct TreeNode* uncle = grandparent->right;
+      if (treemap_is_red(uncle)) {
+        parent->red = uncle->red = false;
+        grandparent->red = true;
+        node = grandparent;
+      } else {
+        if (node == parent->right) {
+          node = parent;
+          treemap_rotate_left(t, node);
+          parent = node->parent;
+        }
+        parent->red = false;
+        grandparent->red = true;
+        treemap_rotate_right(t, grandparent);
+      }
+    } else {
+      struct TreeNode* uncle = grandparent->left;
+      if (treemap_is_red(uncle)) {
+        parent->red = uncle->red = false;
+        grandparent->red = true;
+        node = grandparent;
+      } else {
+        if (node == parent->left) {
+          node = parent;
+          treemap_rotate_right(t, node);
+          parent = node->parent;
+        }
+        parent->red = false;
+        grandparent->red = true;
+        treemap_rotate_left(t, grandparent);
+      }
+    }
+  }
+  t->root->red = false;
+}
+
+/**
+ * Restore the red-black properties after removing a black node
+ *
+ * @param t       The tree map
+ * @param node    The node that replaced the removed one, possibly NULL
+ * @param parent  The parent of `node`
+ */
+void treemap_fix_remove(struct Treemap* t,
+                        struct TreeNode* node,
+                        struct TreeNode* parent) {
+  while (node != t->root && !treemap_is_red(node)) {
+    if (node == parent->left) {
+      struct TreeNode* sibling = parent->right;
+      if (sibling->red) {
+        sibling->red = false;
+        parent->red = true;
+        treemap_rotate_left(t, parent);
+        sibling = parent->right;
+      }
+      if (!treemap_is_red(sibling->left) && !treemap_is_red(sibling->right)) {
+        sibling->red = true;
+        node = parent;
+        parent = node->parent;
+      } else {
+        if (!treemap_is_red(sibling->right)) {
+          sibling->left->red = false;
+          sibling->red = true;
+          treemap_rotate_right(t, sibling);
+          sibling = parent->right;
+        }
+        sibling->red = parent->red;
+        parent->red = false;
+        sibling->right->red = false;
+        treemap_rotate_left(t, parent);
+        node = t->root;
+      }
+    } else {
+      struct TreeNode* sibling = parent->left;
+      if (sibling->red) {
+        sibling->red = false;
+        parent->red = true;
+        treemap_rotate_right(t, parent);
+        sibling = parent->left;
+      }
+      if (!treemap_is_red(sibling->left) && !treemap_is_red(sibling->right)) {
+        sibling->red = true;
+        node = parent;
+        parent = node->parent;
+      } else {
+        if (!treemap_is_red(sibling->left)) {
+          sibling->right->red = false;
+          sibling->red = true;
+          treemap_rotate_left(t, sibling);
+          sibling = parent->left;
+        }
+        sibling->red = parent->red;
+        parent->red = false;
+        sibling->left->red = false;
+        treemap_rotate_right(t, parent);
+        node = t->root;
+      }
+    }
   }
+  if (node != NULL)
+    node->red = false;
+}
+
+/**
+ * Take an unused node from the pool of a tree map
+ *
+ * Removed nodes are reused first. Otherwise, the node is carved from the
+ * current slab, and a new slab twice as large is allocated when it is full.
+ *
+ * @param t  The tree map
+ * @return   The node
+ */
+struct TreeNode* treemap_allocate_node(struct Treemap* t) {
+  if (t->free_nodes != NULL) {
+    struct TreeNode* node = t->free_nodes;
+    t->free_nodes = node->left;
+    return node;
+  }
+  if (t->slabs == NULL || t->num_slab_nodes == t->slabs->capacity) {
+    unsigned int capacity = t->slabs == NULL ?
+                            TREEMAP_INITIAL_SLAB_CAPACITY :
+                            2 * t->slabs->capacity;
+    struct TreeSlab* slab = malloc(sizeof(struct TreeSlab) +
+                                   capacity * sizeof(struct TreeNode));
+    slab->next = t->slabs;
+    slab->capacity = capacity;
+    t->slabs = slab;
+    t->num_slab_nodes = 0;
+  }
+  return t->slabs->nodes + t->num_slab_nodes++;
 }
 
 /**
  * Insert a key-value node in a tree map
  *
- * @param node   The current node
+ * The key must not already exist in the tree map.
+ *
+ * @param t      The tree map
  * @param key    The key to insert
  * @param value  The value to insert
  */
-void treemap_insert_node(struct TreeNode** node,
+void treemap_insert_node(struct Treemap* t,
                          const char* key,
                          double value) {
-  if (*node == NULL) {
-    *node = malloc(sizeof(struct TreeNode));
-    (*node)->kv.key = strdup(key);
-    (*node)->kv.value = value;
-    (*node)->left = NULL;
-    (*node)->right = NULL;
-  } else if (strcmp(key, (*node)->kv.key) < 0) {
-    treemap_insert_node(&(*node)->left, key, value);
-  } else {
-    treemap_insert_node(&(*node)->right, key, value);
+  struct TreeNode* parent = NULL;
+  struct TreeNode** link = &t->root;
+  while (*link != NULL) {
+    parent = *link;
+    link = strncmp(key, parent->kv.key, ID_MAX_LENGTH) < 0 ?
+           &parent->left :
+           &parent->right;
   }
+  struct TreeNode* node = treemap_allocate_node(t);
+  strncpy(node->kv.key, key, ID_MAX_LENGTH);
+  node->kv.key[ID_MAX_LENGTH] = '\0';
+  node->kv.value = value;
+  node->left = NULL;
+  node->right = NULL;
+  node->parent = parent;
+  node->red = true;
+  *link = node;
+  treemap_fix_insert(t, node);
 }
 
 /**
- * Print the tree map starting from the given node
+ * Unlink a node from a tree map and free it
  *
- * @param node  The current node
+ * @param t     The tree map
+ * @param node  The node to remove
  */
-void treemap_print_node(const struct TreeNode* node) {
-  if (node != NULL) {
-    treemap_print_node(node->left);
-    printf("  %s: %f\n", node->kv.key, node->kv.value);
-    treemap_print_node(node->right);
+void treemap_remove_node(struct Treemap* t, struct TreeNode* node) {
+  struct TreeNode* child;
+  struct TreeNode* parent;
+  bool removed_red = node->red;
+  if (node->left == NULL) {
+    child = node->right;
+    parent = node->parent;
+    treemap_replace_node(t, node, child);
+  } else if (node->right == NULL) {
+    child = node->left;
+    parent = node->parent;
+    treemap_replace_node(t, node, child);
+  } else {
+    struct TreeNode* next = treemap_minimum_node(node->right);
+    removed_red = next->red;
+    child = next->right;
+    if (next->parent == node) {
+      parent = next;
+    } else {
+      parent = next->parent;
+      treemap_replace_node(t, next, next->right);
+      next->right = node->right;
+      next->right->parent = next;
+    }
+    treemap_replace_node(t, node, next);
+    next->left = node->left;
+    next->left->parent = next;
+    next->red = node->red;
   }
+  if (!removed_red)
+    treemap_fix_remove(t, child, parent);
+  node->left = t->free_nodes;
+  t->free_nodes = node;
 }
 
 /**
- * Delete all nodes referenced by the given node
+ * Build a perfectly balanced subtree from sorted key-value pairs
  *
- * @param node  The current node
+ * The nodes at depth `red_depth` are red and all others are black, so that
+ * every path from the root to a leaf contains the same number of black nodes.
+ *
+ * @param t          The tree map
+ * @param kvs        The key-value pairs of the subtree, sorted by key
+ * @param num_kvs    The number of key-value pairs, at least 1
+ * @param parent     The parent of the subtree
+ * @param depth      The depth of the root of the subtree
+ * @param red_depth  The depth of the red nodes
+ * @return           The root of the subtree
  */
-void treemap_delete_node(struct TreeNode* node) {
-  if (node != NULL) {
-    treemap_delete_node(node->left);
-    treemap_delete_node(node->right);
-    free(node->kv.key);
-    free(node);
-  }
+struct TreeNode* treemap_build_node(struct Treemap* t,
+                                    const struct KeyValue* kvs,
+                                    unsigned int num_kvs,
+                                    struct TreeNode* parent,
+                                    unsigned int depth,
+                                    unsigned int red_depth) {
+  unsigned int middle = num_kvs / 2;
+  struct TreeNode* node = treemap_allocate_node(t);
+  node->kv = kvs[middle];
+  node->parent = parent;
+  node->red = depth == red_depth;
+  node->left = middle == 0 ?
+               NULL :
+               treemap_build_node(t, kvs, middle, node, depth + 1, red_depth);
+  node->right = middle + 1 == num_kvs ?
+                NULL :
+                treemap_build_node(t,
+                                   kvs + middle + 1,
+                                   num_kvs - middle - 1,
+                                   node,
+                                   depth + 1,
+                                   red_depth);
+  return node;
 }
 
 /**
- * Indicates if all nodes in a given subtree belong to another treemap
+ * Stops a treemap comparison at the first difference
  *
- * @param node  The root of the subtree
- * @param t     The treemap
- * @return      true if and only if all nodes in the given subtree occurs in
- *              the given treemap
+ * @param kv1   The entry of the first treemap
+ * @param kv2   The entry of the second treemap
+ * @param data  Unused
+ * @return      false
  */
-bool treemap_subtree_nodes_are_contained_in(const struct TreeNode* node,
-                                            const struct Treemap* t) {
-  if (node == NULL) {
-    return true;
-  } else {
-    if (!treemap_has_key(t, node->kv.key) ||
-        treemap_get(t, node->kv.key) != node->kv.value)
-      return false;
-    return treemap_subtree_nodes_are_contained_in(node->left, t) &&
-           treemap_subtree_nodes_are_contained_in(node->right, t);
-  }
+bool treemap_stop_at_difference(const struct KeyValue* kv1,
+                                const struct KeyValue* kv2,
+                                void* data) {
+  return false;
 }
 
 // Initialization
@@ -108,13 +393,35 @@ bool treemap_subtree_nodes_are_contained_in(const struct TreeNode* node,
 void treemap_initialize(struct Treemap* t) {
   t->root = NULL;
   t->num_entries = 0;
+  t->slabs = NULL;
+  t->num_slab_nodes = 0;
+  t->free_nodes = NULL;
+}
+
+void treemap_build_from_sorted(struct Treemap* t,
+                               const struct KeyValue* kvs,
+                               unsigned int num_entries) {
+  treemap_initialize(t);
+  if (num_entries == 0)
+    return;
+  // The deepest level, which may be incomplete, is the only red one
+  unsigned int max_depth = 0;
+  while ((2u << max_depth) <= num_entries)
+    ++max_depth;
+  unsigned int red_depth = max_depth == 0 ? 1 : max_depth;
+  t->root = treemap_build_node(t, kvs, num_entries, NULL, 0, red_depth);
+  t->num_entries = num_entries;
 }
 
 // Destruction
 // -----------
 
 void treemap_delete(struct Treemap *t) {
-    treemap_delete_node(t->root);
+  while (t->slabs != NULL) {
+    struct TreeSlab* slab = t->slabs;
+    t->slabs = slab->next;
+    free(slab);
+  }
 }
 
 // Modifiers
@@ -125,11 +432,20 @@ void treemap_set(struct Treemap* t, const char* key, double value) {
   if (node != NULL) {
     node->kv.value = value;
   } else {
-    treemap_insert_node(&(t->root), key, value);
+    treemap_insert_node(t, key, value);
     ++t->num_entries;
   }
 }
 
+bool treemap_remove(struct Treemap* t, const char* key) {
+  struct TreeNode* node = treemap_get_node(t->root, key);
+  if (node == NULL)
+    return false;
+  treemap_remove_node(t, node);
+  --t->num_entries;
+  return true;
+}
+
 // Accessors
 // ---------
 
@@ -142,27 +458,69 @@ bool treemap_has_key(const struct Treemap* t, const char* key) {
   return treemap_get_node(t->root, key) != NULL;
 }
 
-void treemap_add_keys(const struct TreeNode* node,
-                      struct StringArray* sa) {
-  if (node != NULL) {
-    treemap_add_keys(node->left, sa);
-    string_array_append(sa, node->kv.key);
-    treemap_add_keys(node->right, sa);
-  }
+void treemap_iterator_initialize(struct TreemapIterator* it,
+                                 const struct Treemap* t) {
+  it->node = t->root == NULL ? NULL : treemap_minimum_node(t->root);
+}
+
+const struct KeyValue* treemap_iterator_next(struct TreemapIterator* it) {
+  const struct TreeNode* node = it->node;
+  if (node == NULL)
+    return NULL;
+  it->node = treemap_next_node((struct TreeNode*)node);
+  return &node->kv;
 }
 
 void treemap_compute_keys(const struct Treemap* t, struct StringArray* sa) {
-  string_array_initialize(sa);
-  treemap_add_keys(t->root, sa);
+  string_array_initialize_borrowed(sa);
+  string_array_reserve(sa, t->num_entries, 0);
+  struct TreemapIterator it;
+  treemap_iterator_initialize(&it, t);
+  const struct KeyValue* kv;
+  while ((kv = treemap_iterator_next(&it)) != NULL)
+    string_array_append(sa, kv->key);
 }
 
 void treemap_print(const struct Treemap *t) {
   printf("Treemap {\n");
-  treemap_print_node(t->root);
+  struct TreemapIterator it;
+  treemap_iterator_initialize(&it, t);
+  const struct KeyValue* kv;
+  while ((kv = treemap_iterator_next(&it)) != NULL)
+    printf("  %s: %f\n", kv->key, kv->value);
   printf("}\n");
 }
 
 bool treemap_are_equal(const struct Treemap* t1, const struct Treemap* t2) {
   return t1->num_entries == t2->num_entries &&
-         treemap_subtree_nodes_are_contained_in(t1->root, t2);
+         treemap_diff(t1, t2, treemap_stop_at_difference, NULL) == 0;
+}
+
+unsigned int treemap_diff(const struct Treemap* t1,
+                          const struct Treemap* t2,
+                          TreemapDiffVisitor visitor,
+                          void* data) {
+  struct TreemapIterator it1, it2;
+  treemap_iterator_initialize(&it1, t1);
+  treemap_iterator_initialize(&it2, t2);
+  const struct KeyValue* kv1 = treemap_iterator_next(&it1);
+  const struct KeyValue* kv2 = treemap_iterator_next(&it2);
+  unsigned int num_differences = 0;
+  while (kv1 != NULL || kv2 != NULL) {
+    int cmp = kv1 == NULL ? 1 :
+              kv2 == NULL ? -1 :
+              strncmp(kv1->key, kv2->key, ID_MAX_LENGTH);
+    const struct KeyValue* entry1 = cmp <= 0 ? kv1 : NULL;
+    const struct KeyValue* entry2 = cmp >= 0 ? kv2 : NULL;
+    if (cmp != 0 || kv1->value != kv2->value) {
+      ++num_differences;
+      if (!visitor(entry1, entry2, data))
+        break;
+    }
+    if (cmp <= 0)
+      kv1 = treemap_iterator_next(&it1);
+    if (cmp >= 0)
+      kv2 = treemap_iterator_next(&it2);
+  }
+  return num_differences;
 }
@@ -3,30 +3,70 @@
 
 #include <stdbool.h>
 
+#include "constants.h"
 #include "string_array.h"
 
 // Types
 // -----
 
 // A key-value pair
+//
+// Keys are stored inline and are truncated to ID_MAX_LENGTH characters.
 struct KeyValue {
-  char* key;    // The key
-  double value; // The value
+  char key[ID_MAX_LENGTH + 1];  // The key
+  double value;                 // The value
 };
 
 // A node with string key and double value
 struct TreeNode {
-  struct KeyValue kv;     // The key-value pair stored in the node
-  struct TreeNode* left;  // Left subtree
-  struct TreeNode* right; // Right subtree
+  struct KeyValue kv;       // The key-value pair stored in the node
+  struct TreeNode* left;    // Left subtree
+  struct TreeNode* right;   // Right subtree
+  struct TreeNode* parent;  // Parent node, NULL for the root
+  bool red;                 // true if the node is red, false if it is black
+};
+
+// A slab of tree nodes
+struct TreeSlab {
+  struct TreeSlab* next;    // The previously allocated slab
+  unsigned int capacity;    // The number of nodes in the slab
+  struct TreeNode nodes[];  // The nodes
 };
 
 // A treemap associating strings with doubles
+//
+// The treemap is a red-black tree, so that its height remains logarithmic in
+// its number of entries whatever the order of insertion. All operations are
+// iterative.
+//
+// Nodes are carved from slabs owned by the treemap, each slab being twice as
+// large as the previous one. Removed nodes are kept in a free list and reused
+// by later insertions, and deleting the treemap only releases its slabs.
 struct Treemap {
-  struct TreeNode* root;    // Root of tree
-  unsigned int num_entries; // The number of entries
+  struct TreeNode* root;        // Root of tree
+  unsigned int num_entries;     // The number of entries
+  struct TreeSlab* slabs;       // The most recent slab, NULL if none
+  unsigned int num_slab_nodes;  // The number of used nodes in that slab
+  struct TreeNode* free_nodes;  // The removed nodes, linked by `left`
+};
+
+// An in-order cursor over the entries of a treemap
+//
+// The cursor yields the key-value pairs stored in the treemap without copying
+// them. It is invalidated by any modification of the treemap.
+struct TreemapIterator {
+  const struct TreeNode* node;  // The node to yield next, NULL at the end
 };
 
+// A function visiting a key whose entries differ between two treemaps
+//
+// `kv1` is NULL if the key only exists in the second treemap, and `kv2` is
+// NULL if the key only exists in the first one. The function returns false to
+// stop the comparison.
+typedef bool (*TreemapDiffVisitor)(const struct KeyValue* kv1,
+                                   const struct KeyValue* kv2,
+                                   void* data);
+
 // Initialization
 // --------------
 
@@ -37,12 +77,28 @@ struct Treemap {
  */
 void treemap_initialize(struct Treemap* t);
 
+/**
+ * Initialize a tree map from key-value pairs sorted by key
+ *
+ * The tree is built perfectly balanced in linear time. Keys must be strictly
+ * increasing.
+ *
+ * @param t            The tree map to initialize
+ * @param kvs          The key-value pairs, sorted by key
+ * @param num_entries  The number of key-value pairs
+ */
+void treemap_build_from_sorted(struct Treemap* t,
+                               const struct KeyValue* kvs,
+                               unsigned int num_entries);
+
 // Destruction
 // -----------
 
 /**
  * Delete a tree map
  *
+ * The nodes are released slab by slab, without visiting the tree.
+ *
  * @param t  The tree map to delete
  */
 void treemap_delete(struct Treemap* t);
@@ -53,12 +109,23 @@ void treemap_delete(struct Treemap* t);
 /**
  * Set the value for the given key in a tree map
  *
+ * Only the first ID_MAX_LENGTH characters of the key are considered.
+ *
  * @param t      The tree map
  * @param key    The key
  * @param value  The value
  */
 void treemap_set(struct Treemap* t, const char* key, double value);
 
+/**
+ * Remove the given key from a tree map
+ *
+ * @param t    The tree map
+ * @param key  The key to remove
+ * @return     True if and only if the key existed in the tree map
+ */
+bool treemap_remove(struct Treemap* t, const char* key);
+
 // Accessors
 // ---------
 
@@ -81,11 +148,30 @@ double treemap_get(const struct Treemap* t, const char* key);
  */
 bool treemap_has_key(const struct Treemap* t, const char* key);
 
+/**
+ * Initialize an iterator on the first entry of a tree map
+ *
+ * @param it  The iterator to initialize
+ * @param t   The tree map
+ */
+void treemap_iterator_initialize(struct TreemapIterator* it,
+                                 const struct Treemap* t);
+
+/**
+ * Return the next entry of a tree map, in increasing key order
+ *
+ * @param it  The iterator
+ * @return    The next key-value pair, or NULL if all entries were visited
+ */
+const struct KeyValue* treemap_iterator_next(struct TreemapIterator* it);
+
 /**
  * Computes the keys appearing in a tree map
  *
- * Note: The result is placed in an array `sa`, which must be freed with
- * stringarray_free when it is not needed anymore.
+ * Note: The result is placed in an array `sa` borrowing the keys from the
+ * tree map, so that the keys are only valid until the tree map is modified or
+ * deleted. The array must be freed with string_array_delete when it is not
+ * needed anymore.
  *
  * @param t   The treemap
  * @param sa  The string array in which the keys are stored
@@ -102,6 +188,9 @@ void treemap_print(const struct Treemap* t);
 /**
  * Indicates if two treemaps contains the same key and values
  *
+ * Both treemaps are walked in lock-step in linear time, stopping at the first
+ * difference.
+ *
  * @param t1  The first treemap
  * @param t2  The second treemap
  * @return    true if and only if both treemaps contains the same key-value
@@ -109,4 +198,22 @@ void treemap_print(const struct Treemap* t);
  */
 bool treemap_are_equal(const struct Treemap* t1, const struct Treemap* t2);
 
+/**
+ * Visits the keys whose entries differ between two treemaps
+ *
+ * Both treemaps are walked in lock-step in linear time, and the keys are
+ * visited in increasing order. A key differs if it exists in only one of the
+ * treemaps or if its values differ.
+ *
+ * @param t1       The first treemap
+ * @param t2       The second treemap
+ * @param visitor  The function called on each differing key
+ * @param data     The data passed to the visitor
+ * @return         The number of visited keys
+ */
+unsigned int treemap_diff(const struct Treemap* t1,
+                          const struct Treemap* t2,
+                          TreemapDiffVisitor visitor,
+                          void* data);
+
 #endif
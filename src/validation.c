@@ -1,5 +1,7 @@
 #include "validation.h"
 
+#include <errno.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Validating relations
@@ -12,6 +14,35 @@ void ensure_zone_identifiers_are_the_same(const char* id1, const char* id2) {
   }
 }
 
+void ensure_zone_exists(int zone, const char* id) {
+  if (zone < 0) {
+    fprintf(stderr, "Unknown zone identifier: %s\n", id);
+    exit(1);
+  }
+}
+
+void ensure_series_breakpoint_is_valid(int index,
+                                       long from,
+                                       long previous_from,
+                                       unsigned int num_timesteps) {
+  if (index == 0 && from != 0) {
+    fprintf(stderr, "Time series does not start at timestep 0\n");
+    exit(1);
+  }
+  if (index > 0 && from <= previous_from) {
+    fprintf(stderr,
+            "Breakpoint at index %d of time series is not after the previous one\n",
+            index);
+    exit(1);
+  }
+  if (from >= num_timesteps) {
+    fprintf(stderr,
+            "Breakpoint at index %d of time series is out of the timeline\n",
+            index);
+    exit(1);
+  }
+}
+
 // Validating JSON
 // ===============
 
@@ -19,46 +50,41 @@ void ensure_zone_identifiers_are_the_same(const char* id1, const char* id2) {
 // ------------------
 
 void ensure_json_is_string(const json_t* j) {
-  if (!json_is_string(j)) {
-    fprintf(stderr, "JSON value is not a string\n");
-    exit(1);
-  }
+  ensure_json_value_has_type(json_is_string(j), "a string");
+}
+
+void ensure_json_is_integer(const json_t* j) {
+  ensure_json_value_has_type(json_is_integer(j), "an integer");
+}
+
+void ensure_json_is_number(const json_t* j) {
+  ensure_json_value_has_type(json_is_number(j), "a number");
 }
 
 void ensure_json_is_object(const json_t* j) {
-  if (!json_is_object(j)) {
-    fprintf(stderr, "JSON value is not an object\n");
-    exit(1);
-  }
+  ensure_json_value_has_type(json_is_object(j), "an object");
 }
 
 void ensure_json_is_array(const json_t* j) {
-  if (!json_is_array(j)) {
-    fprintf(stderr, "JSON value is not an array\n");
-    exit(1);
-  }
+  ensure_json_value_has_type(json_is_array(j), "an array");
 }
 
 void ensure_json_is_array_of_integers(const json_t* j) {
   ensure_json_is_array(j);
   int size = json_array_size(j);
   for (int i = 0; i < size; ++i)
-    if (!json_is_integer(json_array_get(j, i))) {
-      fprintf(stderr,
-              "The value at index %d of JSON array is not an integer\n",
-              i);
-      exit(1);
-    }
+    ensure_json_array_value_has_type(json_is_integer(json_array_get(j, i)),
+                                     i,
+                                     "an integer");
 }
 
 void ensure_json_is_array_of_numbers(const json_t* j) {
   ensure_json_is_array(j);
   int size = json_array_size(j);
   for (int i = 0; i < size; ++i)
-    if (!json_is_number(json_array_get(j, i))) {
-      fprintf(stderr, "The value at index %d of JSON array is not a number\n", i);
-      exit(1);
-    }
+    ensure_json_array_value_has_type(json_is_number(json_array_get(j, i)),
+                                     i,
+                                     "a number");
 }
 
 // JSON object content
@@ -66,18 +92,12 @@ void ensure_json_is_array_of_numbers(const json_t* j) {
 
 void ensure_json_object_has_size(const json_t* j, int size) {
   ensure_json_is_object(j);
-  if (json_object_size(j) != size) {
-    fprintf(stderr, "Size of JSON object is not %d\n", size);
-    exit(1);
-  }
+  ensure_json_container_has_size("object", json_object_size(j), size);
 }
 
 void ensure_json_object_contains_key(const json_t* j, const char* key) {
   ensure_json_is_object(j);
-  if (json_object_get(j, key) == NULL) {
-    fprintf(stderr, "JSON object does not contain the key \"%s\"\n", key);
-    exit(1);
-  }
+  ensure_json_key_was_found(json_object_get(j, key) != NULL, key);
 }
 
 // JSON array content
@@ -85,8 +105,98 @@ void ensure_json_object_contains_key(const json_t* j, const char* key) {
 
 void ensure_json_array_has_size(const json_t* j, int size) {
   ensure_json_is_array(j);
-  if (json_array_size(j) != size) {
-    fprintf(stderr, "Size of JSON array is not %d\n", size);
+  ensure_json_container_has_size("array", json_array_size(j), size);
+}
+
+// JSON properties
+// ---------------
+
+void ensure_json_value_has_type(bool has_type, const char* type) {
+  if (!has_type) {
+    fprintf(stderr, "JSON value is not %s\n", type);
+    exit(1);
+  }
+}
+
+void ensure_json_array_value_has_type(bool has_type,
+                                      int index,
+                                      const char* type) {
+  if (!has_type) {
+    fprintf(stderr,
+            "The value at index %d of JSON array is not %s\n",
+            index,
+            type);
+    exit(1);
+  }
+}
+
+void ensure_json_container_has_size(const char* container,
+                                    int actual_size,
+                                    int size) {
+  if (actual_size != size) {
+    fprintf(stderr, "Size of JSON %s is not %d\n", container, size);
+    exit(1);
+  }
+}
+
+void ensure_json_key_was_found(bool found, const char* key) {
+  if (!found) {
+    fprintf(stderr, "JSON object does not contain the key \"%s\"\n", key);
+    exit(1);
+  }
+}
+
+void ensure_json_was_loaded(const json_t* j, const json_error_t* error) {
+  if (j == NULL) {
+    fprintf(stderr, "Problem while loading JSON file: %s\n", error->text);
+    exit(1);
+  }
+}
+
+// Validating binary files
+// ========================
+
+void ensure_snapshot_is_valid(bool valid, const char* problem) {
+  if (!valid) {
+    fprintf(stderr, "Problem while loading snapshot file: %s\n", problem);
+    exit(1);
+  }
+}
+
+void ensure_binary_plan_is_valid(bool valid, const char* problem) {
+  if (!valid) {
+    fprintf(stderr, "Problem while loading binary plan file: %s\n", problem);
+    exit(1);
+  }
+}
+
+// Validating CSV files
+// ====================
+
+void ensure_file_was_opened(const FILE* file, const char* filename) {
+  if (file == NULL) {
+    fprintf(stderr, "Problem while loading file: unable to open %s: %s\n",
+            filename, strerror(errno));
+    exit(1);
+  }
+}
+
+void ensure_file_has_no_error(FILE* file, const char* filename) {
+  if (ferror(file)) {
+    fprintf(stderr, "Problem while accessing file: error on %s: %s\n",
+            filename, strerror(errno));
+    exit(1);
+  }
+}
+
+void ensure_csv_is_valid(bool valid,
+                         const char* filename,
+                         unsigned int line,
+                         const char* problem) {
+  if (!valid) {
+    fprintf(stderr,
+            "Problem while loading CSV file %s at line %u: %s\n",
+            filename, line, problem);
     exit(1);
   }
 }
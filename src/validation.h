@@ -1,3 +1,6 @@
+#include <stdbool.h>
+#include <stdio.h>
+
 #include <jansson.h>
 
 // Validating relations
@@ -13,6 +16,33 @@
  */
 void ensure_zone_identifiers_are_the_same(const char* id1, const char* id2);
 
+/**
+ * Ensures that a zone referenced by its identifier was found
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param zone  The index of the zone, or -1 if no zone has the identifier
+ * @param id    The identifier of the zone
+ */
+void ensure_zone_exists(int zone, const char* id);
+
+/**
+ * Ensures that a breakpoint of a piecewise constant time series is valid
+ *
+ * The first breakpoint must be at timestep 0, and each breakpoint must be
+ * after the previous one and within the timeline. If not, prints an error
+ * message and exits the program.
+ *
+ * @param index          The index of the breakpoint
+ * @param from           The timestep of the breakpoint
+ * @param previous_from  The timestep of the previous breakpoint, if any
+ * @param num_timesteps  The number of timesteps of the timeline
+ */
+void ensure_series_breakpoint_is_valid(int index,
+                                       long from,
+                                       long previous_from,
+                                       unsigned int num_timesteps);
+
 // Validating JSON
 // ===============
 
@@ -28,6 +58,24 @@ void ensure_zone_identifiers_are_the_same(const char* id1, const char* id2);
  */
 void ensure_json_is_string(const json_t* j);
 
+/**
+ * Ensures that the given JSON value contains an integer
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param j  The JSON value
+ */
+void ensure_json_is_integer(const json_t* j);
+
+/**
+ * Ensures that the given JSON value contains a number
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param j  The JSON value
+ */
+void ensure_json_is_number(const json_t* j);
+
 /**
  * Ensures that the given JSON value is an object
  *
@@ -99,3 +147,127 @@ void ensure_json_object_contains_key(const json_t* j, const char* key);
  * @param size  The expected size
  */
 void ensure_json_array_has_size(const json_t* j, int size);
+
+// JSON properties
+// ---------------
+//
+// These checks work on properties of JSON values rather than on the values
+// themselves, so that JSON read as a stream is validated with the same
+// messages as JSON values.
+
+/**
+ * Ensures that a JSON value has the expected type
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param has_type  Whether the value has the expected type
+ * @param type      The expected type, with its article (e.g. "an object")
+ */
+void ensure_json_value_has_type(bool has_type, const char* type);
+
+/**
+ * Ensures that a value of a JSON array has the expected type
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param has_type  Whether the value has the expected type
+ * @param index     The index of the value in the array
+ * @param type      The expected type, with its article (e.g. "a number")
+ */
+void ensure_json_array_value_has_type(bool has_type,
+                                      int index,
+                                      const char* type);
+
+/**
+ * Ensures that a JSON object or array has the expected size
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param container    The kind of container, "object" or "array"
+ * @param actual_size  The size of the container
+ * @param size         The expected size
+ */
+void ensure_json_container_has_size(const char* container,
+                                    int actual_size,
+                                    int size);
+
+/**
+ * Ensures that a key was found in a JSON object
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param found  Whether the key was found
+ * @param key    The key
+ */
+void ensure_json_key_was_found(bool found, const char* key);
+
+/**
+ * Ensures that a JSON file was loaded by Jansson
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param j      The loaded JSON value, or NULL
+ * @param error  The error found by Jansson, if any
+ */
+void ensure_json_was_loaded(const json_t* j, const json_error_t* error);
+
+// Validating binary files
+// ========================
+
+/**
+ * Ensures that a property of a binary snapshot file holds
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param valid    Whether the property holds
+ * @param problem  The description of the problem if it does not hold
+ */
+void ensure_snapshot_is_valid(bool valid, const char* problem);
+
+/**
+ * Ensures that a property of a binary plan file holds
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param valid    Whether the property holds
+ * @param problem  The description of the problem if it does not hold
+ */
+void ensure_binary_plan_is_valid(bool valid, const char* problem);
+
+// Validating CSV files
+// ====================
+
+/**
+ * Ensures that a file was opened
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param file      The opened file, or NULL
+ * @param filename  The path of the file
+ */
+void ensure_file_was_opened(const FILE* file, const char* filename);
+
+/**
+ * Ensures that no read or write error occurred on a file
+ *
+ * If one did, prints an error message and exits the program.
+ *
+ * @param file      The file
+ * @param filename  The path of the file
+ */
+void ensure_file_has_no_error(FILE* file, const char* filename);
+
+/**
+ * Ensures that a property of a CSV file holds
+ *
+ * If not, prints an error message and exits the program.
+ *
+ * @param valid     Whether the property holds
+ * @param filename  The path of the CSV file
+ * @param line      The line of the file, starting at 1
+ * @param problem   The description of the problem if it does not hold
+ */
+void ensure_csv_is_valid(bool valid,
+                         const char* filename,
+                         unsigned int line,
+                         const char* problem);
@@ -0,0 +1,61 @@
+setup() {
+    dir="$( cd "$( dirname "$BATS_TEST_FILENAME" )" >/dev/null 2>&1 && pwd )"
+    PATH="$dir/../src:$PATH"
+    load '../external/bats-support/load'
+    load '../external/bats-assert/load'
+}
+
+# Basic usage
+# -----------
+
+@test "simprod convert converts a plan to binary and back" {
+    ./simprod convert examples/plan.json $BATS_TMPDIR/plan.simplan
+    ./simprod convert $BATS_TMPDIR/plan.simplan $BATS_TMPDIR/plan.json
+    diff -s examples/plan.json $BATS_TMPDIR/plan.json
+}
+
+@test "simprod convert converts a piped plan to binary" {
+    cat examples/plan.json | ./simprod convert /dev/stdin \
+        $BATS_TMPDIR/plan.simplan
+    ./simprod convert $BATS_TMPDIR/plan.simplan $BATS_TMPDIR/plan.json
+    diff -s examples/plan.json $BATS_TMPDIR/plan.json
+}
+
+@test "simprod convert converts a scenario to binary and back" {
+    ./simprod convert examples/scenario.json $BATS_TMPDIR/scenario.simprod
+    ./simprod convert $BATS_TMPDIR/scenario.simprod $BATS_TMPDIR/scenario.json
+    diff -s examples/scenario.json $BATS_TMPDIR/scenario.json
+}
+
+@test "simprod plan reads a binary plan" {
+    ./simprod plan --format bin -o $BATS_TMPDIR/plan.simplan examples/plan.json
+    ./simprod plan $BATS_TMPDIR/plan.simplan > $BATS_TMPDIR/plan.json
+    diff -s examples/plan.json $BATS_TMPDIR/plan.json
+}
+
+@test "simprod plan --format bin to a full device fails" {
+    run ./simprod plan --format bin -o /dev/full examples/plan.json
+    assert_failure
+    assert_line --partial 'unable to write /dev/full'
+}
+
+# With wrong argument
+# -------------------
+
+@test "simprod convert with missing arguments fails" {
+    run ./simprod convert examples/plan.json
+    assert_failure
+    assert_line --partial 'Missing arguments'
+}
+
+@test "simprod convert with an option fails" {
+    run ./simprod convert examples/plan.json $BATS_TMPDIR/plan.simplan --compact
+    assert_failure
+    assert_line --partial 'Invalid option'
+}
+
+@test "simprod convert from JSON to JSON fails" {
+    run ./simprod convert examples/plan.json $BATS_TMPDIR/plan.json
+    assert_failure
+    assert_line --partial 'Unsupported conversion'
+}
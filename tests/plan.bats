@@ -29,6 +29,11 @@ function no_stderr {
     diff -s examples/plan.json $BATS_TMPDIR/plan.json
 }
 
+@test "simprod plan reads a plan from a pipe" {
+    cat examples/plan.json | ./simprod plan /dev/stdin > $BATS_TMPDIR/plan.json
+    diff -s examples/plan.json $BATS_TMPDIR/plan.json
+}
+
 # With wrong argument
 # -------------------
 
@@ -37,3 +42,64 @@ function no_stderr {
     assert_failure
     assert_line --partial 'Too many arguments'
 }
+
+@test "simprod plan to a full device fails" {
+    run ./simprod plan -o /dev/full examples/plan.json
+    assert_failure
+    assert_line --partial 'unable to write /dev/full'
+}
+
+# Output layout
+# -------------
+
+@test "simprod plan --compact prints the plan on a single line" {
+    run ./simprod plan --compact examples/plan.json
+    assert_success
+    assert_output --partial '{"productions":{"LG1":[3.0,3.5,4.0],'
+    [ "${#lines[@]}" -eq 1 ]
+}
+
+@test "simprod plan --precision 1 rounds the productions" {
+    run ./simprod plan --compact --precision 1 examples/plan.json
+    assert_success
+    assert_output --partial '"LG1":[3.0,4.0,4.0]'
+}
+
+@test "simprod plan with an invalid precision fails" {
+    run ./simprod plan --precision 18 examples/plan.json
+    assert_failure
+    assert_line --partial 'Invalid precision'
+}
+
+@test "simprod plan --compact with a binary format fails" {
+    run ./simprod plan --format bin --compact examples/plan.json
+    assert_failure
+    assert_line --partial "only applies to the 'json' format"
+}
+
+@test "simprod plan --precision with the arrow format fails" {
+    run ./simprod plan --precision 6 --format arrow examples/plan.json
+    assert_failure
+    assert_line --partial "only applies to the 'json' format"
+}
+
+# Arrow output
+# ------------
+
+@test "simprod plan --format arrow writes an Arrow stream" {
+    ./simprod plan --format arrow -o $BATS_TMPDIR/plan.arrow examples/plan.json
+    [ "$(head -c 4 $BATS_TMPDIR/plan.arrow | od -An -tx1 | tr -d ' ')" = "ffffffff" ]
+    [ "$(tail -c 8 $BATS_TMPDIR/plan.arrow | od -An -tx1 | tr -d ' ')" = "ffffffff00000000" ]
+}
+
+@test "simprod plan --format arrow to a full device fails" {
+    run ./simprod plan --format arrow -o /dev/full examples/plan.json
+    assert_failure
+    assert_line --partial 'unable to write /dev/full'
+}
+
+@test "simprod scenario --format arrow fails" {
+    run ./simprod scenario --format arrow examples/scenario.json
+    assert_failure
+    assert_line --partial 'Unsupported format'
+}
@@ -32,6 +32,12 @@ function no_stderr {
     diff -s examples/scenario.json $BATS_TMPDIR/scenario.json
 }
 
+@test "simprod scenario reads a scenario from a pipe" {
+    cat examples/scenario.json | ./simprod scenario /dev/stdin \
+        > $BATS_TMPDIR/scenario.json
+    diff -s examples/scenario.json $BATS_TMPDIR/scenario.json
+}
+
 # With wrong argument
 # -------------------
 
@@ -46,3 +52,62 @@ function no_stderr {
     assert_failure
     assert_line --partial 'No such file'
 }
+
+# Binary snapshots
+# ----------------
+
+@test "simprod scenario --format bin writes a snapshot that can be reloaded" {
+    ./simprod scenario --format bin -o $BATS_TMPDIR/scenario.simprod examples/scenario.json
+    ./simprod scenario $BATS_TMPDIR/scenario.simprod > $BATS_TMPDIR/scenario.json
+    diff -s examples/scenario.json $BATS_TMPDIR/scenario.json
+}
+
+@test "simprod scenario with a truncated snapshot fails" {
+    ./simprod scenario --format bin -o $BATS_TMPDIR/scenario.simprod examples/scenario.json
+    head -c 200 $BATS_TMPDIR/scenario.simprod > $BATS_TMPDIR/truncated.simprod
+    run ./simprod scenario $BATS_TMPDIR/truncated.simprod
+    assert_failure
+    assert_line --partial 'truncated'
+}
+
+@test "simprod scenario --format bin to a full device fails" {
+    run ./simprod scenario --format bin -o /dev/full examples/scenario.json
+    assert_failure
+    assert_line --partial 'unable to write /dev/full'
+}
+
+@test "simprod scenario to a full standard output fails" {
+    run bash -c "./simprod scenario examples/scenario.json > /dev/full"
+    assert_failure
+    assert_line --partial 'unable to write standard output'
+}
+
+@test "simprod scenario with an unknown format fails" {
+    run ./simprod scenario --format xml
+    assert_failure
+    assert_line --partial 'Unsupported format'
+}
+
+# Topology and CSV time series
+# ----------------------------
+
+@test "simprod scenario --topology loads the time series from CSV files" {
+    ./simprod scenario --topology examples/topology.json > $BATS_TMPDIR/scenario.json
+    diff -s examples/scenario.json $BATS_TMPDIR/scenario.json
+}
+
+@test "simprod scenario --topology with an invalid CSV number fails" {
+    mkdir -p $BATS_TMPDIR/topology/csv
+    cp examples/topology.json $BATS_TMPDIR/topology
+    cp examples/csv/*.csv $BATS_TMPDIR/topology/csv
+    sed -i 's/2.5/2.5x/' $BATS_TMPDIR/topology/csv/min-powers.csv
+    run ./simprod scenario --topology $BATS_TMPDIR/topology/topology.json
+    assert_failure
+    assert_line --partial 'min-powers.csv at line 3: invalid number'
+}
+
+@test "simprod plan --topology fails" {
+    run ./simprod plan --topology examples/topology.json
+    assert_failure
+    assert_line --partial 'Invalid option'
+}